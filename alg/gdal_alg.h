@@ -60,6 +60,9 @@ int CPL_DLL CPL_STDCALL GDALDitherRGB2PCT(
 int CPL_DLL CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff,
                                           int nYOff, int nXSize, int nYSize);
 
+char CPL_DLL *GDALHashImage(GDALRasterBandH hBand, int nXOff, int nYOff,
+                            int nXSize, int nYSize, CSLConstList papszOptions);
+
 CPLErr CPL_DLL CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
                                                 GDALRasterBandH hProximityBand,
                                                 char **papszOptions,
@@ -133,6 +133,13 @@ template <class DataType, class EqualityTest> class GDALRasterPolygonEnumeratorT
     void MergePolygon(int nSrcId, int nDstId);
     int NewPolygon(DataType nValue);
 
+    template <bool bTrackMerges> int NewPolygonId(DataType nValue);
+
+    template <bool bTrackMerges>
+    bool ProcessLineInternal(DataType *panLastLineVal, DataType *panThisLineVal,
+                             GInt32 *panLastLineId, GInt32 *panThisLineId,
+                             int nXSize);
+
     CPL_DISALLOW_COPY_ASSIGN(GDALRasterPolygonEnumeratorT)
 
   public:  // these are intended to be readonly.
@@ -151,6 +158,10 @@ template <class DataType, class EqualityTest> class GDALRasterPolygonEnumeratorT
     bool ProcessLine(DataType *panLastLineVal, DataType *panThisLineVal,
                      GInt32 *panLastLineId, GInt32 *panThisLineId, int nXSize);
 
+    bool ProcessLineIdsOnly(DataType *panLastLineVal, DataType *panThisLineVal,
+                            GInt32 *panLastLineId, GInt32 *panThisLineId,
+                            int nXSize);
+
     void CompleteMerges();
 
     void Clear();
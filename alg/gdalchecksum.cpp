@@ -33,12 +33,17 @@
 #include <cmath>
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_sha256.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                         GDALChecksumImage()                          */
@@ -272,3 +277,290 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
 
     return nChecksum;
 }
+
+/************************************************************************/
+/*                         GDALHashImageJob                             */
+/************************************************************************/
+
+namespace
+{
+struct GDALHashImageJob
+{
+    // Band used when the dataset cannot be reopened
+    GDALRasterBand *poBand = nullptr;
+    bool bReopen = false;
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    // Range of lines, relative to nYOff, processed by this job
+    int iYStart = 0;
+    int iYEnd = 0;
+    int nLinesPerRead = 1;
+    // Digest of each line of the window
+    GByte *pabyLineDigests = nullptr;
+    std::atomic<bool> *pbStop = nullptr;
+    bool bDone = false;
+    bool bError = false;
+};
+}  // namespace
+
+/************************************************************************/
+/*                         GDALHashImageLines()                         */
+/************************************************************************/
+
+static void GDALHashImageLines(void *pData)
+{
+    GDALHashImageJob *psJob = static_cast<GDALHashImageJob *>(pData);
+
+    GDALRasterBand *poBand = psJob->poBand;
+    GDALDatasetUniquePtr poDSReopened;
+    if (psJob->bReopen)
+    {
+        // Use a dedicated dataset handle, so that blocks can be read and
+        // decoded concurrently with the other jobs.
+        GDALDataset *poDS = poBand->GetDataset();
+        const char *const apszAllowedDrivers[] = {
+            poDS->GetDriver() ? poDS->GetDriver()->GetDescription() : nullptr,
+            nullptr};
+        {
+            CPLErrorStateBackuper oErrorStateBackuper;
+            CPLErrorHandlerPusher oErrorHandlerPusher(CPLQuietErrorHandler);
+            poDSReopened.reset(GDALDataset::Open(
+                poDS->GetDescription(), GDAL_OF_RASTER | GDAL_OF_INTERNAL,
+                apszAllowedDrivers[0] ? apszAllowedDrivers : nullptr,
+                poDS->GetOpenOptions(), nullptr));
+        }
+        const int nBand = poBand->GetBand();
+        if (!poDSReopened ||
+            poDSReopened->GetRasterXSize() != poDS->GetRasterXSize() ||
+            poDSReopened->GetRasterYSize() != poDS->GetRasterYSize() ||
+            poDSReopened->GetRasterCount() < nBand ||
+            poDSReopened->GetRasterBand(nBand)->GetRasterDataType() !=
+                poBand->GetRasterDataType())
+        {
+            // Let the caller process the lines with the original band
+            return;
+        }
+        poBand = poDSReopened->GetRasterBand(nBand);
+    }
+
+    const GDALDataType eDT = poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const size_t nLineSize = static_cast<size_t>(psJob->nXSize) * nDTSize;
+    std::vector<GByte> abyBuffer;
+    try
+    {
+        abyBuffer.resize(nLineSize * psJob->nLinesPerRead);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALHashImage()");
+        psJob->bDone = true;
+        psJob->bError = true;
+        return;
+    }
+
+    for (int iY = psJob->iYStart; iY < psJob->iYEnd;
+         iY += psJob->nLinesPerRead)
+    {
+        if (*(psJob->pbStop))
+            break;
+        const int nLines = std::min(psJob->nLinesPerRead, psJob->iYEnd - iY);
+        if (poBand->RasterIO(GF_Read, psJob->nXOff, psJob->nYOff + iY,
+                             psJob->nXSize, nLines, abyBuffer.data(),
+                             psJob->nXSize, nLines, eDT, 0, 0,
+                             nullptr) != CE_None)
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "Hash value could not be computed due to I/O "
+                     "read error.");
+            psJob->bError = true;
+            *(psJob->pbStop) = true;
+            break;
+        }
+#ifdef CPL_MSB
+        // Hash values in little-endian order
+        GDALSwapWordsEx(abyBuffer.data(),
+                        GDALDataTypeIsComplex(eDT) ? nDTSize / 2 : nDTSize,
+                        (GDALDataTypeIsComplex(eDT) ? 2 : 1) *
+                            static_cast<size_t>(psJob->nXSize) * nLines,
+                        GDALDataTypeIsComplex(eDT) ? nDTSize / 2 : nDTSize);
+#endif
+        for (int i = 0; i < nLines; ++i)
+        {
+            CPL_SHA256(abyBuffer.data() + i * nLineSize, nLineSize,
+                       psJob->pabyLineDigests +
+                           static_cast<size_t>(iY + i) * CPL_SHA256_HASH_SIZE);
+        }
+    }
+    psJob->bDone = true;
+}
+
+/************************************************************************/
+/*                           GDALHashImage()                            */
+/************************************************************************/
+
+/**
+ * Compute a SHA-256 hash of the content of an image region.
+ *
+ * Contrary to GDALChecksumImage(), the hash is computed on the exact values
+ * of the pixels, in the data type of the band, so it is suitable for data
+ * integrity verification. The hash does not depend on the block
+ * organization, compression or byte order of the dataset: each line of the
+ * region is hashed on its values in little-endian order, and the final
+ * hash is computed on the data type name, the region dimensions and the
+ * line hashes, in line order.
+ *
+ * When the dataset of the band is opened in read-only mode and can be
+ * reopened, lines are read and hashed by several threads, each one using
+ * its own dataset handle.
+ *
+ * Options:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS: number of worker threads.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option,
+ * or 1.</li>
+ * </ul>
+ *
+ * @param hBand the raster band to read from.
+ * @param nXOff pixel offset of window to read.
+ * @param nYOff line offset of window to read.
+ * @param nXSize pixel size of window to read.
+ * @param nYSize line size of window to read.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ *
+ * @return the hexadecimal representation of the hash, to be freed with
+ * CPLFree(), or NULL in case of error.
+ * @since GDAL 3.9
+ */
+
+char *GDALHashImage(GDALRasterBandH hBand, int nXOff, int nYOff, int nXSize,
+                    int nYSize, CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hBand, "GDALHashImage", nullptr);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    if (nXOff < 0 || nYOff < 0 || nXSize < 0 || nYSize < 0 ||
+        nXOff > poBand->GetXSize() - nXSize ||
+        nYOff > poBand->GetYSize() - nYSize)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GDALHashImage(): invalid window");
+        return nullptr;
+    }
+
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(128, nThreads));
+
+    // Read lines in chunks of the block height, so that each block is
+    // decoded once, unless that would require too much memory.
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const GDALDataType eDT = poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const GIntBig nMaxChunkSize =
+        std::max(static_cast<GIntBig>(10 * 1000 * 1000),
+                 GDALGetCacheMax64() / 10) /
+        nThreads;
+    const GIntBig nLineSize = static_cast<GIntBig>(nXSize) * nDTSize;
+    const int nLinesPerRead = static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>(std::max(1, nBlockYSize),
+                             nMaxChunkSize / std::max<GIntBig>(1, nLineSize))));
+
+    std::vector<GByte> abyLineDigests;
+    try
+    {
+        abyLineDigests.resize(static_cast<size_t>(nYSize) *
+                              CPL_SHA256_HASH_SIZE);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALHashImage()");
+        return nullptr;
+    }
+
+    // Only reopen datasets that cannot have pending modifications, and
+    // whose band can be retrieved by its number (which excludes overview
+    // and mask bands)
+    GDALDataset *poDS = poBand->GetDataset();
+    const bool bReopen =
+        nThreads > 1 && poDS != nullptr && poDS->GetAccess() == GA_ReadOnly &&
+        poDS->GetDescription()[0] != '\0' && poBand->GetBand() >= 1 &&
+        poDS->GetRasterBand(poBand->GetBand()) == poBand;
+
+    // Split the lines in ranges aligned on chunks of lines
+    const int nChunks = DIV_ROUND_UP(nYSize, nLinesPerRead);
+    const int nJobs = bReopen ? std::max(1, std::min(nThreads, nChunks)) : 1;
+    std::vector<GDALHashImageJob> asJobs(nJobs);
+    std::atomic<bool> bStop(false);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.poBand = poBand;
+        sJob.bReopen = nJobs > 1;
+        sJob.nXOff = nXOff;
+        sJob.nYOff = nYOff;
+        sJob.nXSize = nXSize;
+        sJob.iYStart = static_cast<int>(
+            std::min(static_cast<GIntBig>(nYSize),
+                     static_cast<GIntBig>(nChunks) * i / nJobs *
+                         nLinesPerRead));
+        sJob.iYEnd = static_cast<int>(
+            std::min(static_cast<GIntBig>(nYSize),
+                     static_cast<GIntBig>(nChunks) * (i + 1) / nJobs *
+                         nLinesPerRead));
+        sJob.nLinesPerRead = nLinesPerRead;
+        sJob.pabyLineDigests = abyLineDigests.data();
+        sJob.pbStop = &bStop;
+    }
+
+    if (nJobs > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nJobs);
+        auto poJobQueue =
+            poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+        for (auto &sJob : asJobs)
+        {
+            if (!poJobQueue ||
+                !poJobQueue->SubmitJob(GDALHashImageLines, &sJob))
+            {
+                sJob.bReopen = false;
+            }
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    }
+
+    // Process sequentially, with the original band, the jobs that could not
+    // be run in a thread, or whose dataset could not be reopened.
+    bool bError = false;
+    for (auto &sJob : asJobs)
+    {
+        if (!sJob.bDone && !bStop)
+        {
+            sJob.bReopen = false;
+            GDALHashImageLines(&sJob);
+        }
+        bError |= sJob.bError;
+    }
+    if (bError)
+        return nullptr;
+
+    CPL_SHA256Context sContext;
+    CPL_SHA256Init(&sContext);
+    const std::string osHeader(CPLSPrintf("%s,%d,%d", GDALGetDataTypeName(eDT),
+                                          nXSize, nYSize));
+    CPL_SHA256Update(&sContext, osHeader.c_str(), osHeader.size());
+    CPL_SHA256Update(&sContext, abyLineDigests.data(), abyLineDigests.size());
+    GByte abyDigest[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256Final(&sContext, abyDigest);
+
+    return CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyDigest);
+}
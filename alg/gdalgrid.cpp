@@ -689,8 +689,19 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
             for (int k = 0; k < nFeatureCount; k++)
             {
                 const int i = papsPoints[k]->i;
-                const double dfRX = padfX[i] - dfXPoint;
-                const double dfRY = padfY[i] - dfYPoint;
+                double dfRX = padfX[i] - dfXPoint;
+                double dfRY = padfY[i] - dfYPoint;
+
+                if (bRotated)
+                {
+                    const double dfRXRotated =
+                        dfRX * dfCoeff1 + dfRY * dfCoeff2;
+                    const double dfRYRotated =
+                        dfRY * dfCoeff1 - dfRX * dfCoeff2;
+
+                    dfRX = dfRXRotated;
+                    dfRY = dfRYRotated;
+                }
 
                 if (dfRadius2Square * dfRX * dfRX +
                         dfRadius1Square * dfRY * dfRY <=
@@ -877,6 +888,11 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
  * and returns it as a result. If there are no points found, the specified
  * NODATA value will be returned.
  *
+ * Without a search ellipse, when several points are at the same distance, the
+ * one with the highest index is returned. Starting with GDAL 3.9, in that
+ * case, a quadtree is used to find the nearest point instead of an exhaustive
+ * search.
+ *
  * @param poOptionsIn Algorithm parameters. This should point to
  * GDALGridNearestNeighborOptions object.
  * @param nPoints Number of elements in input arrays.
@@ -921,12 +937,13 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
     double dfNearestValue = poOptions->dfNoDataValue;
     GUInt32 i = 0;
 
+    const bool bHasSearchRadius =
+        poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0;
     double dfSearchRadius = psExtraParams->dfInitialSearchRadius;
-    if (hQuadTree != nullptr)
+    if (bHasSearchRadius)
+        dfSearchRadius = std::max(poOptions->dfRadius1, poOptions->dfRadius2);
+    if (hQuadTree != nullptr && dfSearchRadius > 0)
     {
-        if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
-            dfSearchRadius =
-                std::max(poOptions->dfRadius1, poOptions->dfRadius2);
         CPLRectObj sAoi;
         while (dfSearchRadius > 0)
         {
@@ -942,18 +959,50 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
                 // Nearest distance will be initialized with the distance to the
                 // first point in array.
                 double dfNearestRSquare = std::numeric_limits<double>::max();
-                for (int k = 0; k < nFeatureCount; k++)
+                int nNearestIdx = -1;
+                const auto FindNearest = [&]()
                 {
-                    const int idx = papsPoints[k]->i;
-                    const double dfRX = padfX[idx] - dfXPoint;
-                    const double dfRY = padfY[idx] - dfYPoint;
-
-                    const double dfR2 = dfRX * dfRX + dfRY * dfRY;
-                    if (dfR2 <= dfNearestRSquare)
+                    for (int k = 0; k < nFeatureCount; k++)
                     {
-                        dfNearestRSquare = dfR2;
-                        dfNearestValue = padfZ[idx];
+                        const int idx = papsPoints[k]->i;
+                        const double dfRX = padfX[idx] - dfXPoint;
+                        const double dfRY = padfY[idx] - dfYPoint;
+
+                        // Without a search radius, in case of ties, pick the
+                        // point of highest index, as the exhaustive search
+                        // does. Otherwise pick the last one returned by the
+                        // quadtree, as done historically.
+                        const double dfR2 = dfRX * dfRX + dfRY * dfRY;
+                        if (dfR2 < dfNearestRSquare ||
+                            (dfR2 == dfNearestRSquare &&
+                             (bHasSearchRadius || idx > nNearestIdx)))
+                        {
+                            dfNearestRSquare = dfR2;
+                            nNearestIdx = idx;
+                            dfNearestValue = padfZ[idx];
+                        }
                     }
+                };
+                FindNearest();
+
+                // Without a search radius, the nearest point found in the
+                // square window may not be the nearest one: a point outside
+                // of it, but within the circle passing through the nearest
+                // point found, could be closer. So search again within the
+                // bounding box of that circle.
+                if (!bHasSearchRadius &&
+                    dfNearestRSquare > dfSearchRadius * dfSearchRadius)
+                {
+                    CPLFree(papsPoints);
+                    dfSearchRadius = sqrt(dfNearestRSquare) * (1 + 1e-10);
+                    sAoi.minx = dfXPoint - dfSearchRadius;
+                    sAoi.miny = dfYPoint - dfSearchRadius;
+                    sAoi.maxx = dfXPoint + dfSearchRadius;
+                    sAoi.maxy = dfYPoint + dfSearchRadius;
+                    nFeatureCount = 0;
+                    papsPoints = reinterpret_cast<GDALGridPoint **>(
+                        CPLQuadTreeSearch(hQuadTree, &sAoi, &nFeatureCount));
+                    FindNearest();
                 }
 
                 CPLFree(papsPoints);
@@ -961,7 +1010,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
             }
 
             CPLFree(papsPoints);
-            if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
+            if (bHasSearchRadius)
                 break;
             dfSearchRadius *= 2;
 #if DEBUG_VERBOSE
@@ -2957,8 +3006,9 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
             else
             {
                 pfnGDALGridMethod = GDALGridMovingAverage;
+                // The quadtree is searched with the bounding box of the
+                // search ellipse, rotated or not.
                 bCreateQuadTree = (nPoints > nPointCountThreshold &&
-                                   poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
             }
@@ -2979,10 +3029,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                    sizeof(GDALGridNearestNeighborOptions));
 
             pfnGDALGridMethod = GDALGridNearestNeighbor;
+            // Without search ellipse, the quadtree is used for an expanding
+            // search of the nearest point, and the angle does not matter.
             bCreateQuadTree = (nPoints > nPointCountThreshold &&
-                               poOptionsOld->dfAngle == 0.0 &&
-                               (poOptionsOld->dfRadius1 > 0.0 ||
-                                poOptionsOld->dfRadius2 > 0.0));
+                               (poOptionsOld->dfAngle == 0.0 ||
+                                (poOptionsOld->dfRadius1 == 0.0 &&
+                                 poOptionsOld->dfRadius2 == 0.0)));
             break;
         }
         case GGA_MetricMinimum:
@@ -3170,6 +3222,10 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridLinearOptions));
 
             pfnGDALGridMethod = GDALGridLinear;
+            // Nodes outside of the triangulation get the value of the nearest
+            // point when there is no search radius, which uses the quadtree.
+            bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                               poOptionsOld->dfRadius < 0.0);
             break;
         }
         default:
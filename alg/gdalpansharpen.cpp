@@ -39,6 +39,7 @@
 #include <cstring>
 #include <limits>
 #include <new>
+#include <type_traits>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -631,7 +632,19 @@ void GDALPansharpenOperation::WeightedBrovey3(
         return;
     }
 
-    for (size_t j = 0; j < nValues; j++)
+    size_t j = 0;
+#if defined(__x86_64) || defined(_M_X64)
+    if constexpr (!bHasBitDepth &&
+                  !std::numeric_limits<WorkDataType>::is_integer &&
+                  !std::numeric_limits<OutDataType>::is_integer)
+    {
+        j = WeightedBroveyFloatingPointInternal(
+            pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+            nBandValues);
+    }
+#endif
+
+    for (; j < nValues; j++)
     {
         double dfFactor = 0.0;
         // if( pPanBuffer[j] == 0 )
@@ -741,8 +754,88 @@ size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
     return j;
 }
 
+/************************************************************************/
+/*                WeightedBroveyFloatingPointInternal()                 */
+/************************************************************************/
+
+// Process values 4 by 4 for floating-point working and output data types,
+// for any number of input and output bands. The operations are done in the
+// same order as the scalar code, and Float32 values out of range overflow to
+// infinity, as GDALCopyWord() does.
+// Returns the number of values processed.
+template <class WorkDataType, class OutDataType>
+size_t GDALPansharpenOperation::WeightedBroveyFloatingPointInternal(
+    const WorkDataType *pPanBuffer,
+    const WorkDataType *pUpsampledSpectralBuffer, OutDataType *pDataBuf,
+    size_t nValues, size_t nBandValues) const
+{
+    const int nInputSpectralBands = psOptions->nInputSpectralBands;
+    const int nOutPansharpenedBands = psOptions->nOutPansharpenedBands;
+    const XMMReg4Double zero = XMMReg4Double::Zero();
+
+    // Used for Float32 output, as _mm_cvtpd_ps() would round values slightly
+    // above FLT_MAX to FLT_MAX
+    const double dfMaxFloat = std::numeric_limits<float>::max();
+    const double dfMinFloat = -std::numeric_limits<float>::max();
+    const double dfInf = std::numeric_limits<double>::infinity();
+    const double dfMinusInf = -std::numeric_limits<double>::infinity();
+    [[maybe_unused]] const XMMReg4Double maxFloat =
+        XMMReg4Double::Load1ValHighAndLow(&dfMaxFloat);
+    [[maybe_unused]] const XMMReg4Double minFloat =
+        XMMReg4Double::Load1ValHighAndLow(&dfMinFloat);
+    [[maybe_unused]] const XMMReg4Double inf =
+        XMMReg4Double::Load1ValHighAndLow(&dfInf);
+    [[maybe_unused]] const XMMReg4Double minusInf =
+        XMMReg4Double::Load1ValHighAndLow(&dfMinusInf);
+
+    size_t j = 0;  // Used after for.
+    for (; j + 3 < nValues; j += 4)
+    {
+        XMMReg4Double pseudoPanchro = zero;
+        for (int i = 0; i < nInputSpectralBands; i++)
+        {
+            pseudoPanchro +=
+                XMMReg4Double::Load1ValHighAndLow(psOptions->padfWeights + i) *
+                XMMReg4Double::Load4Val(pUpsampledSpectralBuffer +
+                                        i * nBandValues + j);
+        }
+
+        // Factor is zero where the pseudo panchromatic value is zero,
+        // as done by ComputeFactor()
+        const XMMReg4Double factor = XMMReg4Double::Ternary(
+            XMMReg4Double::Equals(pseudoPanchro, zero), zero,
+            XMMReg4Double::Load4Val(pPanBuffer + j) / pseudoPanchro);
+
+        for (int i = 0; i < nOutPansharpenedBands; i++)
+        {
+            XMMReg4Double val =
+                XMMReg4Double::Load4Val(
+                    pUpsampledSpectralBuffer +
+                    psOptions->panOutPansharpenedBands[i] * nBandValues + j) *
+                factor;
+            if constexpr (std::is_same_v<OutDataType, float>)
+            {
+                val = XMMReg4Double::Ternary(
+                    XMMReg4Double::Greater(val, maxFloat), inf, val);
+                val = XMMReg4Double::Ternary(
+                    XMMReg4Double::Greater(minFloat, val), minusInf, val);
+            }
+            val.Store4Val(pDataBuf + i * nBandValues + j);
+        }
+    }
+    return j;
+}
+
 #else
 
+template <class WorkDataType, class OutDataType>
+size_t GDALPansharpenOperation::WeightedBroveyFloatingPointInternal(
+    const WorkDataType *, const WorkDataType *, OutDataType *, size_t,
+    size_t) const
+{
+    return 0;
+}
+
 template <class T, int NINPUT, int NOUTPUT>
 size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
     const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
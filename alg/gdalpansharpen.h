@@ -244,6 +244,12 @@ class GDALPansharpenOperation
         const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
         size_t nValues, size_t nBandValues, T nMaxValue) const;
 
+    template <class WorkDataType, class OutDataType>
+    size_t WeightedBroveyFloatingPointInternal(
+        const WorkDataType *pPanBuffer,
+        const WorkDataType *pUpsampledSpectralBuffer, OutDataType *pDataBuf,
+        size_t nValues, size_t nBandValues) const;
+
     // cppcheck-suppress unusedPrivateFunction
     template <class T>
     void WeightedBroveyGByteOrUInt16(const T *pPanBuffer,
@@ -221,6 +221,37 @@ void GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::CompleteMerges()
              nNextPolygonId, nFinalPolyCount);
 }
 
+/************************************************************************/
+/*                           NewPolygonId()                             */
+/*                                                                      */
+/*      Allocate a new polygon id. When merges are not tracked, only    */
+/*      the id counter is advanced and the polygon maps are left        */
+/*      untouched.                                                      */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+template <bool bTrackMerges>
+inline int GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::NewPolygonId(
+    DataType nValue)
+
+{
+    if constexpr (bTrackMerges)
+    {
+        return NewPolygon(nValue);
+    }
+    else
+    {
+        if (nNextPolygonId == std::numeric_limits<int>::max())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALRasterPolygonEnumeratorT::NewPolygon(): maximum "
+                     "number of polygons reached");
+            return -1;
+        }
+        return nNextPolygonId++;
+    }
+}
+
 /************************************************************************/
 /*                            ProcessLine()                             */
 /*                                                                      */
@@ -232,6 +263,42 @@ bool GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::ProcessLine(
     DataType *panLastLineVal, DataType *panThisLineVal, GInt32 *panLastLineId,
     GInt32 *panThisLineId, int nXSize)
 
+{
+    return ProcessLineInternal<true>(panLastLineVal, panThisLineVal,
+                                     panLastLineId, panThisLineId, nXSize);
+}
+
+/************************************************************************/
+/*                         ProcessLineIdsOnly()                         */
+/*                                                                      */
+/*      Assign the same polygon (fragment) ids as ProcessLine() would,  */
+/*      without recording polygon values and merges. This is meant      */
+/*      for additional passes over a raster already processed by        */
+/*      another enumerator, whose panPolyIdMap and panPolyValue can     */
+/*      then be used to resolve the final polygon of each id, without   */
+/*      allocating a second set of per-polygon arrays.                  */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+bool GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::ProcessLineIdsOnly(
+    DataType *panLastLineVal, DataType *panThisLineVal, GInt32 *panLastLineId,
+    GInt32 *panThisLineId, int nXSize)
+
+{
+    return ProcessLineInternal<false>(panLastLineVal, panThisLineVal,
+                                      panLastLineId, panThisLineId, nXSize);
+}
+
+/************************************************************************/
+/*                        ProcessLineInternal()                         */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+template <bool bTrackMerges>
+bool GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::ProcessLineInternal(
+    DataType *panLastLineVal, DataType *panThisLineVal, GInt32 *panLastLineId,
+    GInt32 *panThisLineId, int nXSize)
+
 {
     EqualityTest eq;
 
@@ -249,7 +316,8 @@ bool GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::ProcessLine(
             else if (i == 0 ||
                      !(eq.operator()(panThisLineVal[i], panThisLineVal[i - 1])))
             {
-                panThisLineId[i] = NewPolygon(panThisLineVal[i]);
+                panThisLineId[i] =
+                    NewPolygonId<bTrackMerges>(panThisLineVal[i]);
                 if (panThisLineId[i] < 0)
                     return false;
             }
@@ -277,27 +345,30 @@ bool GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::ProcessLine(
         {
             panThisLineId[i] = panThisLineId[i - 1];
 
-            if (eq.operator()(panLastLineVal[i], panThisLineVal[i]) &&
-                (panPolyIdMap[panLastLineId[i]] !=
-                 panPolyIdMap[panThisLineId[i]]))
-            {
-                MergePolygon(panLastLineId[i], panThisLineId[i]);
-            }
-
-            if (nConnectedness == 8 &&
-                eq.operator()(panLastLineVal[i - 1], panThisLineVal[i]) &&
-                (panPolyIdMap[panLastLineId[i - 1]] !=
-                 panPolyIdMap[panThisLineId[i]]))
-            {
-                MergePolygon(panLastLineId[i - 1], panThisLineId[i]);
-            }
-
-            if (nConnectedness == 8 && i < nXSize - 1 &&
-                eq.operator()(panLastLineVal[i + 1], panThisLineVal[i]) &&
-                (panPolyIdMap[panLastLineId[i + 1]] !=
-                 panPolyIdMap[panThisLineId[i]]))
+            if constexpr (bTrackMerges)
             {
-                MergePolygon(panLastLineId[i + 1], panThisLineId[i]);
+                if (eq.operator()(panLastLineVal[i], panThisLineVal[i]) &&
+                    (panPolyIdMap[panLastLineId[i]] !=
+                     panPolyIdMap[panThisLineId[i]]))
+                {
+                    MergePolygon(panLastLineId[i], panThisLineId[i]);
+                }
+
+                if (nConnectedness == 8 &&
+                    eq.operator()(panLastLineVal[i - 1], panThisLineVal[i]) &&
+                    (panPolyIdMap[panLastLineId[i - 1]] !=
+                     panPolyIdMap[panThisLineId[i]]))
+                {
+                    MergePolygon(panLastLineId[i - 1], panThisLineId[i]);
+                }
+
+                if (nConnectedness == 8 && i < nXSize - 1 &&
+                    eq.operator()(panLastLineVal[i + 1], panThisLineVal[i]) &&
+                    (panPolyIdMap[panLastLineId[i + 1]] !=
+                     panPolyIdMap[panThisLineId[i]]))
+                {
+                    MergePolygon(panLastLineId[i + 1], panThisLineId[i]);
+                }
             }
         }
         else if (eq.operator()(panLastLineVal[i], panThisLineVal[i]))
@@ -309,12 +380,15 @@ bool GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::ProcessLine(
         {
             panThisLineId[i] = panLastLineId[i - 1];
 
-            if (i < nXSize - 1 &&
-                eq.operator()(panLastLineVal[i + 1], panThisLineVal[i]) &&
-                (panPolyIdMap[panLastLineId[i + 1]] !=
-                 panPolyIdMap[panThisLineId[i]]))
+            if constexpr (bTrackMerges)
             {
-                MergePolygon(panLastLineId[i + 1], panThisLineId[i]);
+                if (i < nXSize - 1 &&
+                    eq.operator()(panLastLineVal[i + 1], panThisLineVal[i]) &&
+                    (panPolyIdMap[panLastLineId[i + 1]] !=
+                     panPolyIdMap[panThisLineId[i]]))
+                {
+                    MergePolygon(panLastLineId[i + 1], panThisLineId[i]);
+                }
             }
         }
         else if (i < nXSize - 1 && nConnectedness == 8 &&
@@ -324,7 +398,7 @@ bool GDALRasterPolygonEnumeratorT<DataType, EqualityTest>::ProcessLine(
         }
         else
         {
-            panThisLineId[i] = NewPolygon(panThisLineVal[i]);
+            panThisLineId[i] = NewPolygonId<bTrackMerges>(panThisLineVal[i]);
             if (panThisLineId[i] < 0)
                 return false;
         }
@@ -167,12 +167,17 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  *
  * The algorithm makes three passes over the input file to enumerate the
  * polygons and collect limited information about them.  Memory use is
- * proportional to the number of polygons (roughly 24 bytes per polygon), but
+ * proportional to the number of polygons (roughly 20 bytes per polygon), but
  * is not directly related to the size of the raster.  So very large raster
  * files can be processed effectively if there aren't too many polygons.  But
  * extremely noisy rasters with many one pixel polygons will end up being
  * expensive (in memory) to process.
  *
+ * Polygons are labelled on a single thread over the whole raster, as the
+ * choice of the largest neighbour of a polygon depends on the order in which
+ * all of its neighbours are scanned. There is consequently no tiled mode
+ * bounding the memory use by the size of a tile.
+ *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
  * value other than zero will be considered suitable for inclusion in polygons.
@@ -341,7 +346,10 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
 
     /* -------------------------------------------------------------------- */
     /*      We will use a new enumerator for the second pass primarily      */
-    /*      so we can preserve the first pass map.                          */
+    /*      so we can preserve the first pass map. It only replays the      */
+    /*      polygon id assignment of the first pass, whose maps are used    */
+    /*      to resolve final polygons, so it does not need its own          */
+    /*      per-polygon arrays.                                             */
     /* -------------------------------------------------------------------- */
     GDALRasterPolygonEnumerator oSecondEnum(nConnectedness);
 
@@ -379,13 +387,15 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
         /* --------------------------------------------------------------------
          */
         if (iY == 0)
-            eErr = oSecondEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                           panThisLineId, nXSize)
+            eErr = oSecondEnum.ProcessLineIdsOnly(nullptr, panThisLineVal,
+                                                  nullptr, panThisLineId,
+                                                  nXSize)
                        ? CE_None
                        : CE_Failure;
         else
-            eErr = oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                           panLastLineId, panThisLineId, nXSize)
+            eErr = oSecondEnum.ProcessLineIdsOnly(panLastLineVal,
+                                                  panThisLineVal, panLastLineId,
+                                                  panThisLineId, nXSize)
                        ? CE_None
                        : CE_Failure;
 
@@ -452,6 +462,9 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
         }
     }
 
+    CPLAssert(eErr != CE_None ||
+              oSecondEnum.nNextPolygonId == oFirstEnum.nNextPolygonId);
+
     /* -------------------------------------------------------------------- */
     /*      If our biggest neighbour is still smaller than the              */
     /*      threshold, then try tracking to that polygons biggest           */
@@ -569,11 +582,12 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
         /* --------------------------------------------------------------------
          */
         if (iY == 0)
-            oSecondEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                    panThisLineId, nXSize);
+            oSecondEnum.ProcessLineIdsOnly(nullptr, panThisLineVal, nullptr,
+                                           panThisLineId, nXSize);
         else
-            oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                    panLastLineId, panThisLineId, nXSize);
+            oSecondEnum.ProcessLineIdsOnly(panLastLineVal, panThisLineVal,
+                                           panLastLineId, panThisLineId,
+                                           nXSize);
 
         /* --------------------------------------------------------------------
          */
@@ -35,8 +35,10 @@
 #include <cstring>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -45,6 +47,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -360,6 +363,152 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                       GDALFillNodataLineJob                          */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataLineJob
+{
+    int iXStart = 0;
+    int iXEnd = 0;
+    int iY = 0;
+    int nXSize = 0;
+    int nMaxSearchDist = 0;
+    double dfMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bHasNoData = false;
+    float fNoData = 0;
+    const GUInt32 *panTopDownY = nullptr;
+    const float *pafTopDownValue = nullptr;
+    const GUInt32 *panLastY = nullptr;
+    const float *pafLastValue = nullptr;
+    GByte *pabyMask = nullptr;
+    float *pafScanline = nullptr;
+    GByte *pabyFiltMask = nullptr;
+};
+}  // namespace
+
+/************************************************************************/
+/*                       GDALFillNodataLineRange()                      */
+/*                                                                      */
+/*      Interpolate the nodata pixels of columns [iXStart, iXEnd[ of    */
+/*      the current line from the top-down and bottom-up "last known    */
+/*      value" buffers. Columns are independent of each other, so      */
+/*      distinct ranges of a line can be processed concurrently.        */
+/************************************************************************/
+
+static void GDALFillNodataLineRange(void *pData)
+{
+    const GDALFillNodataLineJob *psJob =
+        static_cast<const GDALFillNodataLineJob *>(pData);
+
+    const int nXSize = psJob->nXSize;
+    const int iY = psJob->iY;
+    const int nMaxSearchDist = psJob->nMaxSearchDist;
+    const double dfMaxSearchDist = psJob->dfMaxSearchDist;
+    const GUInt32 nNoDataVal = psJob->nNoDataVal;
+    const bool bHasNoData = psJob->bHasNoData;
+    const float fNoData = psJob->fNoData;
+    const GUInt32 *panTopDownY = psJob->panTopDownY;
+    const float *pafTopDownValue = psJob->pafTopDownValue;
+    const GUInt32 *panLastY = psJob->panLastY;
+    const float *pafLastValue = psJob->pafLastValue;
+    GByte *pabyMask = psJob->pabyMask;
+    float *pafScanline = psJob->pafScanline;
+    GByte *pabyFiltMask = psJob->pabyFiltMask;
+
+    for (int iX = psJob->iXStart; iX < psJob->iXEnd; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        pabyFiltMask[iX] = 0;
+
+        // If this was a valid target - no change.
+        if (pabyMask[iX])
+            continue;
+
+        // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
+        double adfQuadDist[4] = {};
+        float fQuadValue[4] = {};
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            fQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
+                       panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
+                       nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX,
+                       panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
+                       nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
+                       panTopDownY[iRightX], iX, iY, pafTopDownValue[iRightX],
+                       nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        double dfWeightSum = 0.0;
+        double dfValueSum = 0.0;
+        bool bHasSrcValues = false;
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+            {
+                bHasSrcValues = true;
+                if (!bHasNoData || fQuadValue[iQuad] != fNoData)
+                {
+                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                    dfWeightSum += dfWeight;
+                    dfValueSum += fQuadValue[iQuad] * dfWeight;
+                }
+            }
+        }
+
+        if (bHasSrcValues)
+        {
+            pabyFiltMask[iX] = 255;
+            if (dfWeightSum > 0.0)
+            {
+                pabyMask[iX] = 255;
+                pafScanline[iX] = static_cast<float>(dfValueSum / dfWeightSum);
+            }
+            else
+                pafScanline[iX] = fNoData;
+        }
+    }
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -393,10 +542,15 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * run (0 or more).
  * @param papszOptions additional name=value options in a string list.
  * <ul>
- * <li>TEMP_FILE_DRIVER=gdal_driver_name. For example MEM.</li>
+ * <li>TEMP_FILE_DRIVER=gdal_driver_name. For example MEM. Starting with
+ * GDAL 3.9, if not specified, MEM is used when the work files fit in the
+ * block cache (GDAL_CACHEMAX), and GTiff otherwise.</li>
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS (starting with GDAL 3.9).
+ * Number of worker threads used to interpolate each scanline. Defaults to
+ * the value of the GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -434,10 +588,29 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Determine format driver for temp work files.                    */
+    /*      Determine format driver for temp work files. When the work      */
+    /*      files (Y index, value, filter mask and possibly mask copy)      */
+    /*      fit in the block cache, keep them in memory rather than         */
+    /*      round-tripping through compressed temporary GTiff files.        */
     /* -------------------------------------------------------------------- */
-    CPLString osTmpFileDriver =
-        CSLFetchNameValueDef(papszOptions, "TEMP_FILE_DRIVER", "GTiff");
+    const char *pszTmpFileDriver =
+        CSLFetchNameValue(papszOptions, "TEMP_FILE_DRIVER");
+    if (pszTmpFileDriver == nullptr)
+    {
+        const GIntBig nWorkPixelSize =
+            GDALGetDataTypeSizeBytes(eType) +
+            GDALGetDataTypeSizeBytes(GDALGetRasterDataType(hTargetBand)) + 1 +
+            (hMaskBand != nullptr && nSmoothingIterations > 0 ? 1 : 0);
+        const GIntBig nWorkSize =
+            static_cast<GIntBig>(nXSize) * nYSize * nWorkPixelSize;
+        pszTmpFileDriver =
+            nWorkSize <= GDALGetCacheMax64() && GDALGetDriverByName("MEM")
+                ? "MEM"
+                : "GTiff";
+        CPLDebug("GDAL", "GDALFillNodata(): using %s work files",
+                 pszTmpFileDriver);
+    }
+    CPLString osTmpFileDriver(pszTmpFileDriver);
     GDALDriverH hDriver = GDALGetDriverByName(osTmpFileDriver.c_str());
 
     if (hDriver == nullptr)
@@ -588,6 +761,30 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     GDALRasterBandH hFiltMaskBand =
         GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
 
+    /* -------------------------------------------------------------------- */
+    /*      Determine the number of threads used for the interpolation      */
+    /*      of each line.                                                   */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszThreads == nullptr)
+        pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    // Do not split lines in chunks smaller than this number of pixels.
+    constexpr int MIN_PIXELS_PER_JOB = 256;
+    nThreads = std::max(
+        1, std::min(std::min(nThreads, 128),
+                    DIV_ROUND_UP(nXSize, MIN_PIXELS_PER_JOB)));
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+    std::vector<GDALFillNodataLineJob> asJobs;
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffers for last scanline and this scanline.           */
     /* -------------------------------------------------------------------- */
@@ -625,6 +822,31 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         panLastY[iX] = nNoDataVal;
     }
 
+    {
+        const int nJobs = poJobQueue ? nThreads : 1;
+        const int nXChunkSize = DIV_ROUND_UP(nXSize, nJobs);
+        for (int iJob = 0; iJob < nJobs; ++iJob)
+        {
+            GDALFillNodataLineJob sJob;
+            sJob.iXStart = iJob * nXChunkSize;
+            sJob.iXEnd = std::min(nXSize, sJob.iXStart + nXChunkSize);
+            if (sJob.iXStart >= sJob.iXEnd)
+                break;
+            sJob.nXSize = nXSize;
+            sJob.nMaxSearchDist = nMaxSearchDist;
+            sJob.dfMaxSearchDist = dfMaxSearchDist;
+            sJob.nNoDataVal = nNoDataVal;
+            sJob.bHasNoData = bHasNoData;
+            sJob.fNoData = fNoData;
+            sJob.panTopDownY = panTopDownY;
+            sJob.pafTopDownValue = pafTopDownValue;
+            sJob.pabyMask = pabyMask;
+            sJob.pafScanline = pafScanline;
+            sJob.pabyFiltMask = pabyFiltMask;
+            asJobs.push_back(sJob);
+        }
+    }
+
     /* ==================================================================== */
     /*      Make first pass from top to bottom collecting the "last         */
     /*      known value" for each column and writing it out to the work     */
@@ -782,93 +1004,21 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         /*      Attempt to interpolate any pixels that are nodata. */
         /* --------------------------------------------------------------------
          */
-        memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
+        for (auto &sJob : asJobs)
         {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
-            double adfQuadDist[4] = {};
-            float fQuadValue[4] = {};
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                fQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            double dfWeightSum = 0.0;
-            double dfValueSum = 0.0;
-            bool bHasSrcValues = false;
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
-            {
-                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
-                {
-                    bHasSrcValues = true;
-                    if (!bHasNoData || fQuadValue[iQuad] != fNoData)
-                    {
-                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                        dfWeightSum += dfWeight;
-                        dfValueSum += fQuadValue[iQuad] * dfWeight;
-                    }
-                }
-            }
-
-            if (bHasSrcValues)
-            {
-                pabyFiltMask[iX] = 255;
-                if (dfWeightSum > 0.0)
-                {
-                    pabyMask[iX] = 255;
-                    pafScanline[iX] =
-                        static_cast<float>(dfValueSum / dfWeightSum);
-                }
-                else
-                    pafScanline[iX] = fNoData;
-            }
+            sJob.iY = iY;
+            sJob.panLastY = panLastY;
+            sJob.pafLastValue = pafLastValue;
+        }
+        if (poJobQueue)
+        {
+            for (auto &sJob : asJobs)
+                poJobQueue->SubmitJob(GDALFillNodataLineRange, &sJob);
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            GDALFillNodataLineRange(&asJobs[0]);
         }
 
         /* --------------------------------------------------------------------
@@ -61,7 +61,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg)
         "{nearest|bilinear|cubic|cubicspline|lanczos|average|mode}]\n"
         "                    [-oo <NAME>=<VALUE>]...\n"
         "                    [-input_file_list <filename>] [-overwrite]\n"
-        "                    [-strict | -non_strict]\n"
+        "                    [-strict | -non_strict] [-num_threads <value>]\n"
         "                    <output_filename.vrt> <input_raster> "
         "[<input_raster>]...\n"
         "\n"
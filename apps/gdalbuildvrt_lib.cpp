@@ -41,7 +41,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -49,13 +51,16 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_vrt.h"
 #include "gdal_priv.h"
 #include "gdal_proxy.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_srs_api.h"
@@ -101,6 +106,8 @@ struct DatasetProperty
     int nMaskBlockXSize = 0;
     int nMaskBlockYSize = 0;
     std::vector<int> anOverviewFactors{};
+    // Whether the above band related members have already been filled
+    bool bPropertiesCollected = false;
 
     DatasetProperty()
     {
@@ -250,6 +257,7 @@ class VRTBuilder
     char *pszResampling = nullptr;
     char **papszOpenOptions = nullptr;
     bool bUseSrcMaskBand = true;
+    int nNumThreads = 1;
 
     /* Internal variables */
     char *pszProjectionRef = nullptr;
@@ -269,8 +277,30 @@ class VRTBuilder
     int bHasRunBuild = 0;
     int bHasDatasetMask = 0;
 
+    /* Input dataset opened, and its properties collected, by a worker */
+    /* thread ahead of its (sequential) analysis */
+    struct PrefetchedDataset
+    {
+        VRTBuilder *poBuilder = nullptr;
+        std::string osFilename{};
+        GDALDatasetH hDS = nullptr;
+        DatasetProperty sProperties{};
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+        bool bDone = false;
+    };
+
+    std::unique_ptr<CPLJobQueue> poPrefetchQueue{};
+    std::vector<std::unique_ptr<PrefetchedDataset>> apoPrefetched{};
+    std::mutex oPrefetchMutex{};
+    std::condition_variable oPrefetchCV{};
+
+    static void PrefetchFunc(void *pData);
+    GDALDatasetH GetPrefetchedDataset(int iDS);
+
     std::string AnalyseRaster(GDALDatasetH hDS,
                               DatasetProperty *psDatasetProperties);
+    void CollectDatasetProperties(GDALDataset *poDS,
+                                  DatasetProperty *psDatasetProperties) const;
 
     void CreateVRTSeparate(VRTDatasetH hVRTDS);
     void CreateVRTNonSeparate(VRTDatasetH hVRTDS);
@@ -286,7 +316,7 @@ class VRTBuilder
                int nSubdataset, const char *pszSrcNoData,
                const char *pszVRTNoData, bool bUseSrcMaskBand,
                const char *pszOutputSRS, const char *pszResampling,
-               const char *const *papszOpenOptionsIn);
+               const char *const *papszOpenOptionsIn, int nNumThreadsIn);
 
     ~VRTBuilder();
 
@@ -307,8 +337,9 @@ VRTBuilder::VRTBuilder(
     int bAddAlphaIn, int bHideNoDataIn, int nSubdatasetIn,
     const char *pszSrcNoDataIn, const char *pszVRTNoDataIn,
     bool bUseSrcMaskBandIn, const char *pszOutputSRSIn,
-    const char *pszResamplingIn, const char *const *papszOpenOptionsIn)
-    : bStrict(bStrictIn)
+    const char *pszResamplingIn, const char *const *papszOpenOptionsIn,
+    int nNumThreadsIn)
+    : bStrict(bStrictIn), nNumThreads(nNumThreadsIn)
 {
     pszOutputFilename = CPLStrdup(pszOutputFilenameIn);
     nInputFiles = nInputFilesIn;
@@ -374,6 +405,15 @@ VRTBuilder::VRTBuilder(
 
 VRTBuilder::~VRTBuilder()
 {
+    // Build() may have returned before consuming all prefetched datasets
+    if (poPrefetchQueue)
+        poPrefetchQueue->WaitCompletion();
+    for (auto &poPrefetched : apoPrefetched)
+    {
+        if (poPrefetched && poPrefetched->hDS)
+            GDALClose(poPrefetched->hDS);
+    }
+
     CPLFree(pszOutputFilename);
     CPLFree(pszSrcNoData);
     CPLFree(pszVRTNoData);
@@ -435,6 +475,114 @@ static CPLString GetProjectionName(const char *pszProjection)
     return pszRet ? pszRet : "(null)";
 }
 
+/************************************************************************/
+/*                      CollectDatasetProperties()                      */
+/************************************************************************/
+
+/* Fills the members of psDatasetProperties that only depend on the dataset */
+/* itself, and not on the datasets analysed before it, so that this can be */
+/* run by a worker thread. */
+void VRTBuilder::CollectDatasetProperties(
+    GDALDataset *poDS, DatasetProperty *psDatasetProperties) const
+{
+    const int nBands = poDS->GetRasterCount();
+    if (nBands == 0)
+        return;
+
+    GDALRasterBand *poFirstBand = poDS->GetRasterBand(1);
+    poFirstBand->GetBlockSize(&psDatasetProperties->nBlockXSize,
+                              &psDatasetProperties->nBlockYSize);
+
+    /* For the -separate case */
+    psDatasetProperties->aeBandType.resize(nBands);
+
+    psDatasetProperties->adfNoDataValues.resize(nBands);
+    psDatasetProperties->abHasNoData.resize(nBands);
+
+    psDatasetProperties->adfOffset.resize(nBands);
+    psDatasetProperties->abHasOffset.resize(nBands);
+
+    psDatasetProperties->adfScale.resize(nBands);
+    psDatasetProperties->abHasScale.resize(nBands);
+
+    psDatasetProperties->abHasMaskBand.resize(nBands);
+
+    psDatasetProperties->bHasDatasetMask =
+        poFirstBand->GetMaskFlags() == GMF_PER_DATASET;
+    poFirstBand->GetMaskBand()->GetBlockSize(
+        &psDatasetProperties->nMaskBlockXSize,
+        &psDatasetProperties->nMaskBlockYSize);
+
+    psDatasetProperties->bLastBandIsAlpha = false;
+    if (poDS->GetRasterBand(nBands)->GetColorInterpretation() == GCI_AlphaBand)
+        psDatasetProperties->bLastBandIsAlpha = true;
+
+    // Collect overview factors. We only handle power-of-two situations for now
+    const int nOverviews = poFirstBand->GetOverviewCount();
+    int nExpectedOvFactor = 2;
+    for (int j = 0; j < nOverviews; j++)
+    {
+        GDALRasterBand *poOverview = poFirstBand->GetOverview(j);
+        if (!poOverview)
+            continue;
+        if (poOverview->GetXSize() < 128 && poOverview->GetYSize() < 128)
+        {
+            break;
+        }
+
+        const int nOvFactor = GDALComputeOvFactor(
+            poOverview->GetXSize(), poFirstBand->GetXSize(),
+            poOverview->GetYSize(), poFirstBand->GetYSize());
+
+        if (nOvFactor != nExpectedOvFactor)
+            break;
+
+        psDatasetProperties->anOverviewFactors.push_back(nOvFactor);
+        nExpectedOvFactor *= 2;
+    }
+
+    for (int j = 0; j < nBands; j++)
+    {
+        GDALRasterBand *poBand = poDS->GetRasterBand(j + 1);
+
+        psDatasetProperties->aeBandType[j] = poBand->GetRasterDataType();
+
+        if (!bSeparate && nSrcNoDataCount > 0)
+        {
+            psDatasetProperties->abHasNoData[j] = true;
+            if (j < nSrcNoDataCount)
+                psDatasetProperties->adfNoDataValues[j] = padfSrcNoData[j];
+            else
+                psDatasetProperties->adfNoDataValues[j] =
+                    padfSrcNoData[nSrcNoDataCount - 1];
+        }
+        else
+        {
+            int bHasNoData = false;
+            psDatasetProperties->adfNoDataValues[j] =
+                poBand->GetNoDataValue(&bHasNoData);
+            psDatasetProperties->abHasNoData[j] = bHasNoData != 0;
+        }
+
+        int bHasOffset = false;
+        psDatasetProperties->adfOffset[j] = poBand->GetOffset(&bHasOffset);
+        psDatasetProperties->abHasOffset[j] =
+            bHasOffset != 0 && psDatasetProperties->adfOffset[j] != 0.0;
+
+        int bHasScale = false;
+        psDatasetProperties->adfScale[j] = poBand->GetScale(&bHasScale);
+        psDatasetProperties->abHasScale[j] =
+            bHasScale != 0 && psDatasetProperties->adfScale[j] != 1.0;
+
+        const int nMaskFlags = poBand->GetMaskFlags();
+        psDatasetProperties->abHasMaskBand[j] =
+            (nMaskFlags != GMF_ALL_VALID && nMaskFlags != GMF_NODATA) ||
+            poBand->GetColorInterpretation() == GCI_AlphaBand;
+    }
+
+    psDatasetProperties->bPropertiesCollected = true;
+}
+
 /************************************************************************/
 /*                           AnalyseRaster()                            */
 /************************************************************************/
@@ -570,98 +718,10 @@ std::string VRTBuilder::AnalyseRaster(GDALDatasetH hDS,
         return "Dataset has no bands";
     }
 
-    GDALRasterBand *poFirstBand = poDS->GetRasterBand(1);
-    poFirstBand->GetBlockSize(&psDatasetProperties->nBlockXSize,
-                              &psDatasetProperties->nBlockYSize);
-
-    /* For the -separate case */
-    psDatasetProperties->aeBandType.resize(_nBands);
-
-    psDatasetProperties->adfNoDataValues.resize(_nBands);
-    psDatasetProperties->abHasNoData.resize(_nBands);
-
-    psDatasetProperties->adfOffset.resize(_nBands);
-    psDatasetProperties->abHasOffset.resize(_nBands);
-
-    psDatasetProperties->adfScale.resize(_nBands);
-    psDatasetProperties->abHasScale.resize(_nBands);
-
-    psDatasetProperties->abHasMaskBand.resize(_nBands);
-
-    psDatasetProperties->bHasDatasetMask =
-        poFirstBand->GetMaskFlags() == GMF_PER_DATASET;
+    if (!psDatasetProperties->bPropertiesCollected)
+        CollectDatasetProperties(poDS, psDatasetProperties);
     if (psDatasetProperties->bHasDatasetMask)
         bHasDatasetMask = TRUE;
-    poFirstBand->GetMaskBand()->GetBlockSize(
-        &psDatasetProperties->nMaskBlockXSize,
-        &psDatasetProperties->nMaskBlockYSize);
-
-    psDatasetProperties->bLastBandIsAlpha = false;
-    if (poDS->GetRasterBand(_nBands)->GetColorInterpretation() == GCI_AlphaBand)
-        psDatasetProperties->bLastBandIsAlpha = true;
-
-    // Collect overview factors. We only handle power-of-two situations for now
-    const int nOverviews = poFirstBand->GetOverviewCount();
-    int nExpectedOvFactor = 2;
-    for (int j = 0; j < nOverviews; j++)
-    {
-        GDALRasterBand *poOverview = poFirstBand->GetOverview(j);
-        if (!poOverview)
-            continue;
-        if (poOverview->GetXSize() < 128 && poOverview->GetYSize() < 128)
-        {
-            break;
-        }
-
-        const int nOvFactor = GDALComputeOvFactor(
-            poOverview->GetXSize(), poFirstBand->GetXSize(),
-            poOverview->GetYSize(), poFirstBand->GetYSize());
-
-        if (nOvFactor != nExpectedOvFactor)
-            break;
-
-        psDatasetProperties->anOverviewFactors.push_back(nOvFactor);
-        nExpectedOvFactor *= 2;
-    }
-
-    for (int j = 0; j < _nBands; j++)
-    {
-        GDALRasterBand *poBand = poDS->GetRasterBand(j + 1);
-
-        psDatasetProperties->aeBandType[j] = poBand->GetRasterDataType();
-
-        if (!bSeparate && nSrcNoDataCount > 0)
-        {
-            psDatasetProperties->abHasNoData[j] = true;
-            if (j < nSrcNoDataCount)
-                psDatasetProperties->adfNoDataValues[j] = padfSrcNoData[j];
-            else
-                psDatasetProperties->adfNoDataValues[j] =
-                    padfSrcNoData[nSrcNoDataCount - 1];
-        }
-        else
-        {
-            int bHasNoData = false;
-            psDatasetProperties->adfNoDataValues[j] =
-                poBand->GetNoDataValue(&bHasNoData);
-            psDatasetProperties->abHasNoData[j] = bHasNoData != 0;
-        }
-
-        int bHasOffset = false;
-        psDatasetProperties->adfOffset[j] = poBand->GetOffset(&bHasOffset);
-        psDatasetProperties->abHasOffset[j] =
-            bHasOffset != 0 && psDatasetProperties->adfOffset[j] != 0.0;
-
-        int bHasScale = false;
-        psDatasetProperties->adfScale[j] = poBand->GetScale(&bHasScale);
-        psDatasetProperties->abHasScale[j] =
-            bHasScale != 0 && psDatasetProperties->adfScale[j] != 1.0;
-
-        const int nMaskFlags = poBand->GetMaskFlags();
-        psDatasetProperties->abHasMaskBand[j] =
-            (nMaskFlags != GMF_ALL_VALID && nMaskFlags != GMF_NODATA) ||
-            poBand->GetColorInterpretation() == GCI_AlphaBand;
-    }
 
     if (bSeparate)
     {
@@ -1414,6 +1474,79 @@ void VRTBuilder::CreateVRTNonSeparate(VRTDatasetH hVRTDS)
     }
 }
 
+/************************************************************************/
+/*                           PrefetchFunc()                             */
+/************************************************************************/
+
+void VRTBuilder::PrefetchFunc(void *pData)
+{
+    PrefetchedDataset *psPrefetched = static_cast<PrefetchedDataset *>(pData);
+    VRTBuilder *poBuilder = psPrefetched->poBuilder;
+
+    // Errors are re-emitted by the main thread, in dataset order
+    CPLInstallErrorHandlerAccumulator(psPrefetched->aoErrors);
+    GDALDatasetH hDS =
+        GDALOpenEx(psPrefetched->osFilename.c_str(), GDAL_OF_RASTER, nullptr,
+                   poBuilder->papszOpenOptions, nullptr);
+    if (hDS)
+    {
+        GDALDataset *poDS = GDALDataset::FromHandle(hDS);
+        // Also triggers the lazy loading of the georeferencing, which may
+        // involve I/O
+        double adfGeoTransform[6];
+        CPL_IGNORE_RET_VAL(poDS->GetGeoTransform(adfGeoTransform));
+        CPL_IGNORE_RET_VAL(poDS->GetProjectionRef());
+        poBuilder->CollectDatasetProperties(poDS, &psPrefetched->sProperties);
+    }
+    CPLUninstallErrorHandlerAccumulator();
+
+    std::lock_guard<std::mutex> oLock(poBuilder->oPrefetchMutex);
+    psPrefetched->hDS = hDS;
+    psPrefetched->bDone = true;
+    poBuilder->oPrefetchCV.notify_all();
+}
+
+/************************************************************************/
+/*                        GetPrefetchedDataset()                        */
+/************************************************************************/
+
+GDALDatasetH VRTBuilder::GetPrefetchedDataset(int iDS)
+{
+    // Keep a bounded number of datasets opened ahead of the one being
+    // analysed. nInputFiles may increase during the analysis, when
+    // subdatasets are expanded.
+    const int nMaxAhead = 2 * nNumThreads;
+    while (static_cast<int>(apoPrefetched.size()) < nInputFiles &&
+           static_cast<int>(apoPrefetched.size()) <= iDS + nMaxAhead)
+    {
+        auto poPrefetched = std::make_unique<PrefetchedDataset>();
+        poPrefetched->poBuilder = this;
+        poPrefetched->osFilename = ppszInputFilenames[apoPrefetched.size()];
+        if (!poPrefetchQueue->SubmitJob(PrefetchFunc, poPrefetched.get()))
+        {
+            // Run the job in the current thread
+            PrefetchFunc(poPrefetched.get());
+        }
+        apoPrefetched.push_back(std::move(poPrefetched));
+    }
+
+    auto &poPrefetched = apoPrefetched[iDS];
+    {
+        std::unique_lock<std::mutex> oLock(oPrefetchMutex);
+        oPrefetchCV.wait(oLock,
+                         [&poPrefetched] { return poPrefetched->bDone; });
+    }
+
+    for (const auto &oError : poPrefetched->aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+    asDatasetProperties[iDS] = std::move(poPrefetched->sProperties);
+    GDALDatasetH hDS = poPrefetched->hDS;
+    poPrefetched.reset();
+    return hDS;
+}
+
 /************************************************************************/
 /*                             Build()                                  */
 /************************************************************************/
@@ -1517,6 +1650,18 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
         }
     }
 
+    if (pahSrcDS == nullptr && nNumThreads > 1 && nInputFiles > 1)
+    {
+        // Opening datasets is mostly latency bound when they are on network
+        // storage, so open them, and collect their properties, in parallel.
+        // Their analysis remains sequential, so the result does not depend
+        // on the number of threads.
+        auto poThreadPool =
+            GDALGetGlobalThreadPool(std::min(nNumThreads, nInputFiles));
+        if (poThreadPool)
+            poPrefetchQueue = poThreadPool->CreateJobQueue();
+    }
+
     bool bFoundValid = false;
     for (int i = 0; ppszInputFilenames != nullptr && i < nInputFiles; i++)
     {
@@ -1527,8 +1672,9 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
             return nullptr;
         }
 
-        GDALDatasetH hDS = (pahSrcDS)
-                               ? pahSrcDS[i]
+        GDALDatasetH hDS = (pahSrcDS) ? pahSrcDS[i]
+                           : (poPrefetchQueue)
+                               ? GetPrefetchedDataset(i)
                                : GDALOpenEx(dsFileName, GDAL_OF_RASTER, nullptr,
                                             papszOpenOptions, nullptr);
         asDatasetProperties[i].isFileOK = FALSE;
@@ -1748,6 +1894,7 @@ struct GDALBuildVRTOptions
     char *pszResampling;
     char **papszOpenOptions;
     bool bUseSrcMaskBand;
+    int nNumThreads;
 
     /*! allow or suppress progress monitor and other non-error output */
     int bQuiet;
@@ -1927,7 +2074,8 @@ GDALDatasetH GDALBuildVRT(const char *pszDest, int nSrcCount,
         psOptions->bAddAlpha, psOptions->bHideNoData, psOptions->nSubdataset,
         psOptions->pszSrcNoData, psOptions->pszVRTNoData,
         psOptions->bUseSrcMaskBand, psOptions->pszOutputSRS,
-        psOptions->pszResampling, psOptions->papszOpenOptions);
+        psOptions->pszResampling, psOptions->papszOpenOptions,
+        psOptions->nNumThreads);
 
     GDALDatasetH hDstDS = static_cast<GDALDatasetH>(
         oBuilder.Build(psOptions->pfnProgress, psOptions->pProgressData));
@@ -1937,6 +2085,17 @@ GDALDatasetH GDALBuildVRT(const char *pszDest, int nSrcCount,
     return hDstDS;
 }
 
+/************************************************************************/
+/*                            GetNumThreads()                           */
+/************************************************************************/
+
+static int GetNumThreads(const char *pszValue)
+{
+    if (EQUAL(pszValue, "ALL_CPUS"))
+        return CPLGetNumCPUs();
+    return std::max(1, atoi(pszValue));
+}
+
 /************************************************************************/
 /*                             SanitizeSRS                              */
 /************************************************************************/
@@ -1998,6 +2157,8 @@ GDALBuildVRTOptionsNew(char **papszArgv,
     psOptions->pProgressData = nullptr;
     psOptions->bUseSrcMaskBand = true;
     psOptions->bStrict = false;
+    psOptions->nNumThreads =
+        GetNumThreads(CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
 
     /* -------------------------------------------------------------------- */
     /*      Parse arguments.                                                */
@@ -2183,6 +2344,10 @@ GDALBuildVRTOptionsNew(char **papszArgv,
         {
             psOptions->bUseSrcMaskBand = false;
         }
+        else if (EQUAL(papszArgv[iArg], "-num_threads") && iArg + 1 < argc)
+        {
+            psOptions->nNumThreads = GetNumThreads(papszArgv[++iArg]);
+        }
         else if (papszArgv[iArg][0] == '-')
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unknown option name '%s'",
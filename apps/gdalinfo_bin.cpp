@@ -46,7 +46,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
         "Usage: gdalinfo [--help] [--help-general]\n"
         "                [-json] [-mm] [-stats | -approx_stats] [-hist]\n"
         "                [-nogcp] [-nomd] [-norat] [-noct] [-nofl]\n"
-        "                [-checksum] [-listmdd] [-mdd <domain>|all]\n"
+        "                [-checksum] [-hash] [-listmdd] [-mdd <domain>|all]\n"
         "                [-proj4] [-wkt_format {WKT1|WKT2|<other_format>}]...\n"
         "                [-sd <subdataset>] [-oo <NAME>=<VALUE>]... [-if "
         "<format>]...\n"
@@ -104,6 +104,10 @@ struct GDALInfoOptions
     /*! force computation of the checksum for each band in the dataset */
     int bComputeChecksum;
 
+    /*! force computation of the SHA-256 hash of the content of each band in
+        the dataset */
+    bool bComputeHash;
+
     /*! allow or suppress ground control points list printing. It may be useful
         for datasets with huge amount of GCPs, such as L1B AVHRR or HDF4 MODIS
         which contain thousands of them. */
@@ -1184,6 +1188,27 @@ char *GDALInfo(GDALDatasetH hDataset, const GDALInfoOptions *psOptions)
             }
         }
 
+        if (psOptions->bComputeHash)
+        {
+            char *pszHash =
+                GDALHashImage(hBand, 0, 0, GDALGetRasterXSize(hDataset),
+                              GDALGetRasterYSize(hDataset), nullptr);
+            if (pszHash)
+            {
+                if (bJson)
+                {
+                    json_object_object_add(poBand, "hash",
+                                           json_object_new_string(pszHash));
+                }
+                else
+                {
+                    Concat(osStr, psOptions->bStdoutOutput, "  Hash=%s\n",
+                           pszHash);
+                }
+                CPLFree(pszHash);
+            }
+        }
+
         int bGotNodata = FALSE;
         if (eDT == GDT_Int64)
         {
@@ -2127,6 +2152,7 @@ GDALInfoOptionsNew(char **papszArgv,
     psOptions->bApproxStats = TRUE;
     psOptions->bSample = FALSE;
     psOptions->bComputeChecksum = FALSE;
+    psOptions->bComputeHash = false;
     psOptions->bShowGCPs = TRUE;
     psOptions->bShowMetadata = TRUE;
     psOptions->bShowRAT = TRUE;
@@ -2162,6 +2188,8 @@ GDALInfoOptionsNew(char **papszArgv,
             psOptions->bSample = TRUE;
         else if (EQUAL(papszArgv[i], "-checksum"))
             psOptions->bComputeChecksum = TRUE;
+        else if (EQUAL(papszArgv[i], "-hash"))
+            psOptions->bComputeHash = true;
         else if (EQUAL(papszArgv[i], "-nogcp"))
             psOptions->bShowGCPs = FALSE;
         else if (EQUAL(papszArgv[i], "-nomd"))
@@ -49,6 +49,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
             "                         [-subset <subset_spec>]...\n"
             "                         [-scaleaxes <scaleaxes_spec>]\n"
             "                         [-oo <NAME>=<VALUE>]...\n"
+            "                         [-num_threads <value>]\n"
             "                         <src_filename> <dst_filename>\n");
 
     if (pszErrorMsg != nullptr)
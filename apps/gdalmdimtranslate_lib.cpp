@@ -53,6 +53,7 @@ struct GDALMultiDimTranslateOptions
     bool bStrict = false;
     void *pProgressData = nullptr;
     bool bUpdate = false;
+    std::string osNumThreads{};
 };
 
 /************************************************************************/
@@ -1510,6 +1511,80 @@ static bool TranslateInternal(std::shared_ptr<GDALGroup> &poDstRootGroup,
     return true;
 }
 
+/************************************************************************/
+/*                       UsesHDF5OrNetCDFLibrary()                      */
+/************************************************************************/
+
+static bool UsesHDF5OrNetCDFLibrary(GDALDriver *poDriver)
+{
+    if (!poDriver)
+        return false;
+    static const char *const apszDrivers[] = {
+        "netCDF", "HDF5", "HDF5Image", "BAG", "KEA", "HDF4", "HDF4Image"};
+    for (const char *pszDriver : apszDrivers)
+    {
+        if (EQUAL(poDriver->GetDescription(), pszDriver))
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                     AddBlockSizeCreationOptions()                    */
+/************************************************************************/
+
+// Make the chunking of the destination arrays match the one of the source
+// arrays, so that chunks are read and written without being split.
+static void
+AddBlockSizeCreationOptions(const std::shared_ptr<GDALGroup> &poGroup,
+                            CPLStringList &aosCreateOptions)
+{
+    for (const auto &osArrayName : poGroup->GetMDArrayNames())
+    {
+        auto poArray = poGroup->OpenMDArray(osArrayName);
+        if (!poArray)
+            continue;
+        const auto anBlockSize = poArray->GetBlockSize();
+        const auto &apoDims = poArray->GetDimensions();
+        if (anBlockSize.empty() || poArray->GetTotalElementsCount() == 0 ||
+            std::find(anBlockSize.begin(), anBlockSize.end(), 0) !=
+                anBlockSize.end())
+        {
+            continue;
+        }
+        // Do not propagate tiny chunks, such as the ones of 1D variables
+        // indexed by an unlimited dimension in netCDF.
+        GUInt64 nBlockElts = 1;
+        std::string osBlockSize;
+        for (size_t i = 0; i < anBlockSize.size(); ++i)
+        {
+            const auto nBlockSize =
+                std::min(anBlockSize[i], apoDims[i]->GetSize());
+            nBlockElts *= nBlockSize;
+            if (!osBlockSize.empty())
+                osBlockSize += ',';
+            osBlockSize += std::to_string(nBlockSize);
+        }
+        constexpr GUInt64 MIN_BLOCK_ELTS = 4096;
+        if (nBlockElts <
+            std::min(poArray->GetTotalElementsCount(), MIN_BLOCK_ELTS))
+        {
+            continue;
+        }
+        aosCreateOptions.AddString(std::string("ARRAY:IF(NAME=")
+                                       .append(poArray->GetFullName())
+                                       .append("):BLOCKSIZE=")
+                                       .append(osBlockSize)
+                                       .c_str());
+    }
+    for (const auto &osGroupName : poGroup->GetGroupNames())
+    {
+        auto poSubGroup = poGroup->OpenGroup(osGroupName);
+        if (poSubGroup)
+            AddBlockSizeCreationOptions(poSubGroup, aosCreateOptions);
+    }
+}
+
 /************************************************************************/
 /*                      CopyToNonMultiDimensionalDriver()               */
 /************************************************************************/
@@ -1773,10 +1848,64 @@ GDALMultiDimTranslate(const char *pszDest, GDALDatasetH hDstDS, int nSrcCount,
     }
     else
     {
+        CPLStringList aosCreateOptions;
+        if (psOptions)
+            aosCreateOptions = psOptions->aosCreateOptions;
+
+        // Unless the user specified the chunking of the destination arrays,
+        // use the one of the source arrays.
+        const char *pszArrayCOList = poDriver->GetMetadataItem(
+            GDAL_DMD_MULTIDIM_ARRAY_CREATIONOPTIONLIST);
+        if (poRG && pszArrayCOList &&
+            (strstr(pszArrayCOList, "'BLOCKSIZE'") ||
+             strstr(pszArrayCOList, "\"BLOCKSIZE\"")))
+        {
+            bool bMatchSourceChunking = true;
+            for (const char *pszOption : aosCreateOptions)
+            {
+                if (STARTS_WITH_CI(pszOption, "ARRAY:") &&
+                    CPLString(pszOption).ifind("BLOCKSIZE=") !=
+                        std::string::npos)
+                {
+                    bMatchSourceChunking = false;
+                }
+            }
+            // netCDF-3 files have no chunking
+            const char *pszNCFormat =
+                EQUAL(poDriver->GetDescription(), "netCDF")
+                    ? aosCreateOptions.FetchNameValue("FORMAT")
+                    : nullptr;
+            if (pszNCFormat && !STARTS_WITH_CI(pszNCFormat, "NC4"))
+                bMatchSourceChunking = false;
+            if (bMatchSourceChunking)
+                AddBlockSizeCreationOptions(poRG, aosCreateOptions);
+        }
+
+        std::unique_ptr<CPLConfigOptionSetter> poNumThreadsSetter;
+        std::unique_ptr<CPLConfigOptionSetter> poPipelinedSetter;
+        if (psOptions && !psOptions->osNumThreads.empty())
+        {
+            poNumThreadsSetter = std::make_unique<CPLConfigOptionSetter>(
+                "GDAL_NUM_THREADS", psOptions->osNumThreads.c_str(), false);
+
+            // Reading from the source array while writing the destination one
+            // is not safe if both drivers use the same non thread-safe
+            // library, under their own distinct locks.
+            const bool bMultiThreaded =
+                EQUAL(psOptions->osNumThreads.c_str(), "ALL_CPUS")
+                    ? CPLGetNumCPUs() > 1
+                    : atoi(psOptions->osNumThreads.c_str()) > 1;
+            if (bMultiThreaded &&
+                !(UsesHDF5OrNetCDFLibrary(poSrcDS->GetDriver()) &&
+                  UsesHDF5OrNetCDFLibrary(poDriver)))
+            {
+                poPipelinedSetter = std::make_unique<CPLConfigOptionSetter>(
+                    "GDAL_MDARRAY_COPY_PIPELINED", "YES", false);
+            }
+        }
+
         hDstDS = GDALDataset::ToHandle(poDriver->CreateCopy(
-            pszDest, poTmpSrcDS, false,
-            psOptions ? const_cast<char **>(psOptions->aosCreateOptions.List())
-                      : nullptr,
+            pszDest, poTmpSrcDS, false, aosCreateOptions.List(),
             psOptions ? psOptions->pfnProgress : nullptr,
             psOptions ? psOptions->pProgressData : nullptr));
     }
@@ -1831,6 +1960,19 @@ GDALMultiDimTranslateOptions *GDALMultiDimTranslateOptionsNew(
             psOptions->bStrict = true;
         }
 
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-num_threads"))
+        {
+            ++i;
+            if (!EQUAL(papszArgv[i], "ALL_CPUS") && atoi(papszArgv[i]) <= 0)
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for -num_threads: %s", papszArgv[i]);
+                GDALMultiDimTranslateOptionsFree(psOptions);
+                return nullptr;
+            }
+            psOptions->osNumThreads = papszArgv[i];
+        }
+
         else if (i < argc - 1 && EQUAL(papszArgv[i], "-array"))
         {
             ++i;
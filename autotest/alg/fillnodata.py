@@ -256,3 +256,46 @@ def test_fillnodata_user_provided_mask_with_smoothing():
     )
     got = [x for x in struct.unpack("f" * (5 * 5), targetBand.ReadRaster())]
     assert got == pytest.approx(expected, 1e-5)
+
+
+###############################################################################
+# Check that multithreaded interpolation gives the same result as the
+# monothreaded one, and that disk based work files are still usable
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["NUM_THREADS=4"],
+        ["NUM_THREADS=ALL_CPUS"],
+        ["TEMP_FILE_DRIVER=GTiff"],
+        ["TEMP_FILE_DRIVER=GTiff", "NUM_THREADS=3"],
+    ],
+)
+def test_fillnodata_options_consistency(options):
+
+    width = 1000
+    height = 20
+    src_ar = []
+    for j in range(height):
+        for i in range(width):
+            if (i // 50 + j // 5) % 3 == 0:
+                src_ar.append(0)
+            else:
+                src_ar.append(1 + (i * 7 + j * 13) % 100)
+    src_data = struct.pack("f" * (width * height), *src_ar)
+
+    def fill(options):
+        ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, gdal.GDT_Float32)
+        ds.GetRasterBand(1).SetNoDataValue(0)
+        ds.GetRasterBand(1).WriteRaster(0, 0, width, height, src_data)
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maskBand=None,
+            maxSearchDist=30,
+            smoothingIterations=2,
+            options=options,
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    assert fill(options) == fill(["NUM_THREADS=1"])
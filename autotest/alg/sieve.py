@@ -328,3 +328,42 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test a noisy raster with many polygons, whose results must not change with
+# the memory optimizations of the later passes
+
+
+@pytest.mark.parametrize(
+    "connectedness,threshold,cs_expected",
+    [(4, 2, 44985), (4, 5, 44960), (8, 2, 44991), (8, 5, 44952)],
+)
+def test_sieve_noisy_raster(connectedness, threshold, cs_expected):
+
+    width = 200
+    height = 150
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+    src_ds.GetRasterBand(1).WriteRaster(
+        0,
+        0,
+        width,
+        height,
+        bytes(
+            ((x // 3) * 7 + (y // 2) * 13 + (x * y) % 5) % 4
+            for y in range(height)
+            for x in range(width)
+        ),
+    )
+    assert src_ds.GetRasterBand(1).Checksum() == 44998
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+    gdal.SieveFilter(
+        src_ds.GetRasterBand(1),
+        None,
+        dst_ds.GetRasterBand(1),
+        threshold,
+        connectedness,
+    )
+
+    assert dst_ds.GetRasterBand(1).Checksum() == cs_expected
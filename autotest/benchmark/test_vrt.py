@@ -0,0 +1,79 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Benchmarking of VRT pixel functions
+#
+###############################################################################
+# Copyright (c) 2024, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import pytest
+
+from osgeo import gdal
+
+# Must be set to run the test_XXX functions under the benchmark fixture
+pytestmark = pytest.mark.usefixtures("decorate_with_benchmark")
+
+
+@pytest.fixture()
+def source_ds_filename(tmp_vsimem):
+    filename = str(tmp_vsimem / "source.tif")
+    if "debug" in gdal.VersionInfo(""):
+        size = 512
+    else:
+        size = 2048
+    nbands = 10
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, size, size, nbands, gdal.GDT_UInt16, options=["TILED=YES"]
+    )
+    for i in range(nbands):
+        ds.GetRasterBand(i + 1).Fill(i + 1)
+    ds = None
+    return filename
+
+
+def _derived_vrt(source_ds_filename, pixel_function, nbands, data_type):
+    src_ds = gdal.Open(source_ds_filename)
+    sources = "".join(
+        f"""
+    <SimpleSource>
+      <SourceFilename>{source_ds_filename}</SourceFilename>
+      <SourceBand>{i + 1}</SourceBand>
+    </SimpleSource>"""
+        for i in range(nbands)
+    )
+    return f"""<VRTDataset rasterXSize="{src_ds.RasterXSize}" rasterYSize="{src_ds.RasterYSize}">
+  <VRTRasterBand dataType="{data_type}" band="1" subClass="VRTDerivedRasterBand">
+    <PixelFunctionType>{pixel_function}</PixelFunctionType>{sources}
+  </VRTRasterBand>
+</VRTDataset>"""
+
+
+@pytest.mark.parametrize(
+    "pixel_function,nbands,data_type",
+    [("sum", 10, "Float32"), ("norm_diff", 2, "Float32"), ("min", 10, "UInt16")],
+)
+def test_vrt_pixel_function(source_ds_filename, pixel_function, nbands, data_type):
+    ds = gdal.Open(_derived_vrt(source_ds_filename, pixel_function, nbands, data_type))
+    ds.GetRasterBand(1).ReadRaster()
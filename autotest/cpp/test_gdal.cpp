@@ -35,6 +35,7 @@
 #include "gdal.h"
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
+#include "gdalmultidim_chunkcache.h"
 
 #include <limits>
 #include <string>
@@ -3597,4 +3598,82 @@ TEST_F(test_gdal, drop_cache)
     }
 }
 
+// Test GDALMDArrayChunkCache
+TEST_F(test_gdal, GDALMDArrayChunkCache)
+{
+    auto &oCache = GDALMDArrayChunkCache::GetSingleton();
+    const size_t nOldMaxSize = oCache.GetMaxSize();
+    const uint64_t nOwner1 = GDALMDArrayChunkCache::GetNewOwnerId();
+    const uint64_t nOwner2 = GDALMDArrayChunkCache::GetNewOwnerId();
+    EXPECT_NE(nOwner1, nOwner2);
+
+    const auto MakeChunk = [](size_t nSize, GByte nVal)
+    {
+        return std::make_shared<const std::vector<GByte>>(nSize, nVal);
+    };
+
+    oCache.Clear();
+    oCache.SetMaxSize(10 * 1000);
+    oCache.ResetStatistics();
+
+    EXPECT_EQ(oCache.Get(nOwner1, {0, 0}), nullptr);
+    EXPECT_TRUE(oCache.Insert(nOwner1, {0, 0}, MakeChunk(1000, 1)));
+    EXPECT_TRUE(oCache.Insert(nOwner1, {0, 1}, MakeChunk(1000, 2)));
+    EXPECT_TRUE(oCache.Insert(nOwner2, {0, 0}, MakeChunk(1000, 3)));
+    // Too large
+    EXPECT_FALSE(oCache.Insert(nOwner1, {1, 0}, MakeChunk(10 * 1000, 4)));
+
+    auto poChunk = oCache.Get(nOwner1, {0, 1});
+    ASSERT_NE(poChunk, nullptr);
+    EXPECT_EQ(poChunk->size(), 1000U);
+    EXPECT_EQ((*poChunk)[0], 2);
+    poChunk = oCache.Get(nOwner2, {0, 0});
+    ASSERT_NE(poChunk, nullptr);
+    EXPECT_EQ((*poChunk)[0], 3);
+
+    auto oStats = oCache.GetStatistics();
+    EXPECT_EQ(oStats.nHits, 2U);
+    EXPECT_EQ(oStats.nMisses, 1U);
+    EXPECT_EQ(oStats.nInsertions, 3U);
+    EXPECT_EQ(oStats.nEvictions, 0U);
+    EXPECT_EQ(oStats.nEntryCount, 3U);
+    EXPECT_GE(oStats.nCurrentSize, 3000U);
+    EXPECT_EQ(oStats.nMaxSize, 10U * 1000);
+
+    // Invalidation
+    oCache.Remove(nOwner1, {0, 1});
+    EXPECT_EQ(oCache.Get(nOwner1, {0, 1}), nullptr);
+    EXPECT_NE(oCache.Get(nOwner1, {0, 0}), nullptr);
+
+    oCache.RemoveOwner(nOwner1);
+    EXPECT_EQ(oCache.Get(nOwner1, {0, 0}), nullptr);
+    EXPECT_NE(oCache.Get(nOwner2, {0, 0}), nullptr);
+    EXPECT_EQ(oCache.GetStatistics().nEntryCount, 1U);
+
+    // Least recently used entries are evicted first
+    oCache.Clear();
+    oCache.ResetStatistics();
+    for (GByte i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(oCache.Insert(nOwner1, {i}, MakeChunk(1000, i)));
+        // Keep the first chunk in use
+        EXPECT_NE(oCache.Get(nOwner1, {0}), nullptr);
+    }
+    oStats = oCache.GetStatistics();
+    EXPECT_GT(oStats.nEvictions, 0U);
+    EXPECT_EQ(oStats.nEntryCount + oStats.nEvictions, 20U);
+    EXPECT_LE(oStats.nCurrentSize, oStats.nMaxSize);
+    EXPECT_NE(oCache.Get(nOwner1, {0}), nullptr);
+    EXPECT_EQ(oCache.Get(nOwner1, {1}), nullptr);
+    EXPECT_NE(oCache.Get(nOwner1, {19}), nullptr);
+
+    // Shrinking the cache evicts entries
+    oCache.SetMaxSize(0);
+    EXPECT_EQ(oCache.GetStatistics().nEntryCount, 0U);
+    EXPECT_FALSE(oCache.Insert(nOwner1, {0}, MakeChunk(1, 0)));
+
+    oCache.SetMaxSize(nOldMaxSize);
+    oCache.ResetStatistics();
+}
+
 }  // namespace
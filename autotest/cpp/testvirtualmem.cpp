@@ -33,6 +33,9 @@
 #include "gdal_alg.h"
 #include "gdal.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "gtest_include.h"
 
 #include "test_data.h"
@@ -274,4 +277,115 @@ TEST(testvitualmem, test)
     GDALDestroyDriverManager();
 }
 
+TEST(testvitualmem, block_virtual_mem)
+{
+    if (!CPLIsVirtualMemFileMapAvailable())
+    {
+        GTEST_SKIP() << "File mapping not available";
+    }
+
+    GDALAllRegister();
+
+    for (const char *pszFormat : {"EHDR", "GTIFF"})
+    {
+        GDALDriverH hDrv = GDALGetDriverByName(pszFormat);
+        if (hDrv == nullptr)
+            continue;
+        const bool bGTiff = EQUAL(pszFormat, "GTIFF");
+        const CPLString osTmpFile = CPLResetExtension(
+            CPLGenerateTempFilename(pszFormat), bGTiff ? "tif" : "img");
+        CPLStringList aosOptions;
+        if (bGTiff)
+        {
+            aosOptions.SetNameValue("TILED", "YES");
+            aosOptions.SetNameValue("BLOCKXSIZE", "16");
+            aosOptions.SetNameValue("BLOCKYSIZE", "16");
+        }
+
+        const int nXSize = 40;
+        const int nYSize = 30;
+        GDALDatasetH hDS = GDALCreate(hDrv, osTmpFile.c_str(), nXSize, nYSize,
+                                      2, GDT_UInt16, aosOptions.List());
+        ASSERT_TRUE(hDS != nullptr);
+        std::vector<GUInt16> anValues(nXSize * nYSize);
+        for (int iBand = 1; iBand <= 2; ++iBand)
+        {
+            for (int i = 0; i < nXSize * nYSize; ++i)
+                anValues[i] = static_cast<GUInt16>(iBand * 1000 + i);
+            ASSERT_EQ(GDALRasterIO(GDALGetRasterBand(hDS, iBand), GF_Write, 0,
+                                   0, nXSize, nYSize, anValues.data(), nXSize,
+                                   nYSize, GDT_UInt16, 0, 0),
+                      CE_None);
+        }
+        GDALClose(hDS);
+
+        // Views are not available in update mode
+        hDS = GDALOpen(osTmpFile.c_str(), GA_Update);
+        ASSERT_TRUE(hDS != nullptr);
+        int nPixelSpace = 0;
+        GIntBig nLineSpace = 0;
+        EXPECT_EQ(GDALRasterBandGetBlockVirtualMem(GDALGetRasterBand(hDS, 1),
+                                                   0, 0, &nPixelSpace,
+                                                   &nLineSpace, nullptr),
+                  nullptr);
+        GDALClose(hDS);
+
+        hDS = GDALOpen(osTmpFile.c_str(), GA_ReadOnly);
+        ASSERT_TRUE(hDS != nullptr);
+        CPLVirtualMem *psLastView = nullptr;
+        for (int iBand = 1; iBand <= 2; ++iBand)
+        {
+            GDALRasterBandH hBand = GDALGetRasterBand(hDS, iBand);
+            int nBlockXSize = 0;
+            int nBlockYSize = 0;
+            GDALGetBlockSize(hBand, &nBlockXSize, &nBlockYSize);
+            for (int nYBlock = 0; nYBlock * nBlockYSize < nYSize; ++nYBlock)
+            {
+                for (int nXBlock = 0; nXBlock * nBlockXSize < nXSize;
+                     ++nXBlock)
+                {
+                    CPLVirtualMem *psView = GDALRasterBandGetBlockVirtualMem(
+                        hBand, nXBlock, nYBlock, &nPixelSpace, &nLineSpace,
+                        nullptr);
+                    ASSERT_TRUE(psView != nullptr);
+                    ASSERT_TRUE(CPLVirtualMemIsFileMapping(psView));
+                    const GByte *pabyView = static_cast<const GByte *>(
+                        CPLVirtualMemGetAddr(psView));
+                    const int nValidX =
+                        std::min(nBlockXSize, nXSize - nXBlock * nBlockXSize);
+                    const int nValidY =
+                        std::min(nBlockYSize, nYSize - nYBlock * nBlockYSize);
+                    for (int y = 0; y < nValidY; ++y)
+                    {
+                        for (int x = 0; x < nValidX; ++x)
+                        {
+                            GUInt16 nVal = 0;
+                            memcpy(&nVal,
+                                   pabyView + x * nPixelSpace + y * nLineSpace,
+                                   sizeof(nVal));
+                            const int i =
+                                (nYBlock * nBlockYSize + y) * nXSize +
+                                nXBlock * nBlockXSize + x;
+                            ASSERT_EQ(nVal, iBand * 1000 + i);
+                        }
+                    }
+                    if (psLastView)
+                        CPLVirtualMemFree(psLastView);
+                    psLastView = psView;
+                }
+            }
+        }
+        GDALClose(hDS);
+
+        // The last view remains valid after the dataset is closed
+        ASSERT_TRUE(psLastView != nullptr);
+        GUInt16 nVal = 0;
+        memcpy(&nVal, CPLVirtualMemGetAddr(psLastView), sizeof(nVal));
+        EXPECT_EQ(nVal, 2 * 1000 + (bGTiff ? 16 * nXSize + 32 : 29 * nXSize));
+        CPLVirtualMemFree(psLastView);
+
+        GDALDeleteDataset(nullptr, osTmpFile.c_str());
+    }
+}
+
 }  // namespace
@@ -29,6 +29,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import os
 import struct
 import sys
 
@@ -410,6 +411,49 @@ def test_cog_creation_of_overviews_with_mask():
     gdal.Unlink(directory)
 
 
+###############################################################################
+# Test that temporary files in memory or on disk give the same result
+
+
+@pytest.mark.parametrize("tiling_scheme", ["CUSTOM", "GoogleMapsCompatible"])
+def test_cog_tmp_in_memory_max_size(tmp_vsimem, tmp_path, tiling_scheme):
+
+    src_ds = gdal.Translate("", "data/byte.tif", options="-of MEM -outsize 2048 300")
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+        0, 0, 1024, 300, b"\xFF", buf_xsize=1, buf_ysize=1
+    )
+
+    checksums = []
+    for max_size in ["0", "100000000"]:
+        filename = str(tmp_vsimem / ("cog_" + max_size + ".tif"))
+        with gdaltest.config_options(
+            {"COG_TMP_IN_MEMORY_MAX_SIZE": max_size, "CPL_TMPDIR": str(tmp_path)}
+        ):
+            ds = gdal.GetDriverByName("COG").CreateCopy(
+                filename, src_ds, options=["TILING_SCHEME=" + tiling_scheme]
+            )
+        assert ds
+        checksums.append(
+            [ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)]
+            + [
+                ds.GetRasterBand(1).GetOverview(i).Checksum()
+                for i in range(ds.GetRasterBand(1).GetOverviewCount())
+            ]
+            + [
+                ds.GetRasterBand(1).GetMaskBand().GetOverview(i).Checksum()
+                for i in range(ds.GetRasterBand(1).GetMaskBand().GetOverviewCount())
+            ]
+        )
+        ds = None
+        _check_cog(filename)
+        # check that the temp files have gone away
+        assert not [x for x in gdal.ReadDir("/vsimem/") or [] if x.endswith(".tmp")]
+        assert not [x for x in os.listdir(tmp_path) if x.endswith(".tmp")]
+
+    assert checksums[0] == checksums[1]
+
+
 ###############################################################################
 # Test MAX_Z_ERROR_OVERVIEW creation option
 
@@ -1924,3 +1968,80 @@ def test_cog_stats(tmp_vsimem, nbands, co, src_has_stats, expected_val):
     if expected_val and ds.RasterCount == 2:
         assert ds.GetRasterBand(2).GetMetadataItem("STATISTICS_MINIMUM") == "255"
     ds = None
+
+
+###############################################################################
+# Test that compressed tiles are copied without re-encoding when the source
+# GTiff has the same compression, predictor and block size as the COG
+
+
+def _read_raw_tile(filename, band, x, y):
+
+    offset = int(band.GetMetadataItem(f"BLOCK_OFFSET_{x}_{y}", "TIFF"))
+    size = int(band.GetMetadataItem(f"BLOCK_SIZE_{x}_{y}", "TIFF"))
+    f = gdal.VSIFOpenL(filename, "rb")
+    try:
+        gdal.VSIFSeekL(f, offset, 0)
+        return gdal.VSIFReadL(1, size, f)
+    finally:
+        gdal.VSIFCloseL(f)
+
+
+@pytest.mark.parametrize("copy_raw_blocks", ["YES", "NO"])
+def test_cog_copy_raw_tiles(tmp_vsimem, copy_raw_blocks):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    with gdaltest.config_option("GDAL_TIFF_OVR_BLOCKSIZE", "256"):
+        src_ds = gdal.Translate(
+            src_filename,
+            "data/byte.tif",
+            width=1024,
+            height=1024,
+            resampleAlg="bilinear",
+            creationOptions=[
+                "TILED=YES",
+                "BLOCKXSIZE=256",
+                "BLOCKYSIZE=256",
+                "COMPRESS=DEFLATE",
+                "PREDICTOR=2",
+                "ZLEVEL=1",
+            ],
+        )
+        src_ds.BuildOverviews("NEAREST", [2])
+    src_ds = None
+
+    filename = str(tmp_vsimem / "out.tif")
+    src_ds = gdal.Open(src_filename)
+    with gdaltest.config_option("GTIFF_COPY_RAW_BLOCKS", copy_raw_blocks):
+        gdal.GetDriverByName("COG").CreateCopy(
+            filename,
+            src_ds,
+            options=[
+                "COMPRESS=DEFLATE",
+                "PREDICTOR=YES",
+                "OVERVIEW_PREDICTOR=YES",
+                "BLOCKSIZE=256",
+            ],
+        )
+    _check_cog(filename)
+
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+    assert ds.GetRasterBand(1).GetOverviewCount() == 1
+    assert (
+        ds.GetRasterBand(1).GetOverview(0).Checksum()
+        == src_ds.GetRasterBand(1).GetOverview(0).Checksum()
+    )
+    if copy_raw_blocks == "YES":
+        for y in range(4):
+            for x in range(4):
+                assert _read_raw_tile(
+                    filename, ds.GetRasterBand(1), x, y
+                ) == _read_raw_tile(src_filename, src_ds.GetRasterBand(1), x, y)
+        for y in range(2):
+            for x in range(2):
+                assert _read_raw_tile(
+                    filename, ds.GetRasterBand(1).GetOverview(0), x, y
+                ) == _read_raw_tile(
+                    src_filename, src_ds.GetRasterBand(1).GetOverview(0), x, y
+                )
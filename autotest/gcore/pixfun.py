@@ -1465,3 +1465,212 @@ def test_pixfun_max_no_nodata():
 
 
 ###############################################################################
+# Verify the expression pixel function
+
+
+def _expression_vrt(filename, expression, nbands, nodata=None, datatype="Float64"):
+
+    sources = "".join(
+        """
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">%s</SourceFilename>
+      <SourceBand>%d</SourceBand>
+    </SimpleSource>"""
+        % (filename, i + 1)
+        for i in range(nbands)
+    )
+    return """<VRTDataset rasterXSize="%d" rasterYSize="%d">
+  <VRTRasterBand dataType="%s" band="1" subClass="VRTDerivedRasterBand">
+    %s
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="%s"/>
+    <SourceTransferType>Float64</SourceTransferType>%s
+  </VRTRasterBand>
+</VRTDataset>""" % (
+        gdal.Open(filename).RasterXSize,
+        gdal.Open(filename).RasterYSize,
+        datatype,
+        "<NoDataValue>%s</NoDataValue>" % nodata if nodata is not None else "",
+        expression.replace("&", "&amp;").replace("<", "&lt;").replace(">", "&gt;"),
+        sources,
+    )
+
+
+def test_pixfun_expression():
+
+    filename = "data/rgbsmall.tif"
+    src = gdal.Open(filename).ReadAsArray().astype(numpy.float64)
+    r, g, b = src[0], src[1], src[2]
+
+    def read(expression, **kwargs):
+        ds = gdal.Open(_expression_vrt(filename, expression, 3, **kwargs))
+        return ds.GetRasterBand(1).ReadAsArray()
+
+    with numpy.errstate(invalid="ignore", divide="ignore"):
+        numpy.testing.assert_array_equal(
+            read("(B2 - B1) / (B2 + B1)"), (g - r) / (g + r)
+        )
+    numpy.testing.assert_array_equal(read("B1 + 2 * B2 - B3 / 4"), r + 2 * g - b / 4)
+    numpy.testing.assert_array_equal(read("-B1 ^ 2 + 2 ^ -1"), -(r**2) + 0.5)
+    numpy.testing.assert_array_equal(
+        read("B1 > B2 && B1 >= 10 ? B1 : (B3 == 0 || B3 != B2 ? -1 : B2)"),
+        numpy.where((r > g) & (r >= 10), r, numpy.where((b == 0) | (b != g), -1, g)),
+    )
+    numpy.testing.assert_array_equal(
+        read("if(!(B1 < 5), min(B1, B2, B3), max(B1, 3))"),
+        numpy.where(r >= 5, numpy.minimum(numpy.minimum(r, g), b), numpy.maximum(r, 3)),
+    )
+    numpy.testing.assert_allclose(
+        read("sqrt(B1) + abs(-B2) + floor(B3 / 3) + fmod(B1, 7) + B2 % 5"),
+        numpy.sqrt(r) + g + numpy.floor(b / 3) + numpy.fmod(r, 7) + numpy.fmod(g, 5),
+    )
+    numpy.testing.assert_allclose(
+        read("cos(pi * B1 / 255) + atan2(B2, B3 + 1) + log10(B1 + 1)"),
+        numpy.cos(math.pi * r / 255) + numpy.arctan2(g, b + 1) + numpy.log10(r + 1),
+    )
+
+    # Conversion to the band data type
+    numpy.testing.assert_array_equal(
+        read("B1 * 2", datatype="Byte"), numpy.minimum(r * 2, 255)
+    )
+
+
+def test_pixfun_expression_nodata():
+
+    filename = "data/rgbsmall.tif"
+    src = gdal.Open(filename).ReadAsArray().astype(numpy.float64)
+    r, g = src[0], src[1]
+
+    def read(expression, nodata):
+        ds = gdal.Open(_expression_vrt(filename, expression, 2, nodata=nodata))
+        return ds.GetRasterBand(1).ReadAsArray()
+
+    # Source pixels at nodata propagate to the output
+    nodata = r[20, 20]
+    numpy.testing.assert_array_equal(
+        read("B1 + B2", nodata),
+        numpy.where((r == nodata) | (g == nodata), nodata, r + g),
+    )
+
+    # A NaN result is written as nodata
+    numpy.testing.assert_array_equal(
+        read("B1 > 100 ? B1 : nan", -1), numpy.where(r > 100, r, -1)
+    )
+
+    # Nodata pixels can be tested for
+    numpy.testing.assert_array_equal(
+        read("isnodata(B1) ? 1000 : B1", nodata),
+        numpy.where(r == nodata, 1000, r),
+    )
+
+    # Without nodata, NaN is output as is
+    ds = gdal.Open(_expression_vrt(filename, "B1 > 100 ? B1 : nan", 1))
+    data = ds.GetRasterBand(1).ReadAsArray()
+    assert numpy.array_equal(data, numpy.where(r > 100, r, numpy.nan), equal_nan=True)
+
+
+@pytest.mark.parametrize(
+    "expression,error",
+    [
+        ("", "Unexpected end of expression"),
+        ("B1 +", "Unexpected end of expression"),
+        ("(B1", "')' expected"),
+        ("B1 ? 1", "':' expected"),
+        ("B1 2", "Unexpected character"),
+        ("B0", "Invalid source index"),
+        ("B3", "B3 is referenced, but there are only 2 source(s)"),
+        ("foo", "Unknown identifier"),
+        ("foo(B1)", "Unknown function foo()"),
+        ("sqrt(B1, B2)", "sqrt() expects one argument"),
+        ("min(B1)", "min() expects at least two arguments"),
+    ],
+)
+def test_pixfun_expression_errors(expression, error):
+
+    ds = gdal.Open(_expression_vrt("data/rgbsmall.tif", expression, 2))
+    with pytest.raises(Exception, match=error.replace("(", r"\(").replace(")", r"\)")):
+        ds.GetRasterBand(1).ReadRaster()
+
+
+@pytest.mark.parametrize(
+    "expression_type,error",
+    [
+        ("parentheses", "Too deeply nested expression"),
+        ("unary_minus", "Too deeply nested expression"),
+        ("power", "Too deeply nested expression"),
+        ("additions", "Too complex expression"),
+        ("max", "Too complex expression"),
+        ("long", "Too long expression"),
+    ],
+)
+def test_pixfun_expression_too_complex(expression_type, error):
+
+    n = 20000
+    if expression_type == "parentheses":
+        expression = "(" * n + "B1" + ")" * n
+    elif expression_type == "unary_minus":
+        expression = "-" * n + "B1"
+    elif expression_type == "power":
+        expression = "B1^" * n + "B1"
+    elif expression_type == "additions":
+        expression = "B1+" * 10000 + "B1"
+    elif expression_type == "max":
+        expression = "max(" + "B1," * 10000 + "B1)"
+    else:
+        expression = "B1+" + " " * 100000 + "B1"
+    ds = gdal.Open(_expression_vrt("data/rgbsmall.tif", expression, 2))
+    with pytest.raises(Exception, match=error):
+        ds.GetRasterBand(1).ReadRaster()
+
+
+def test_pixfun_expression_multithreaded(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        filename, 1000, 700, 2, gdal.GDT_Int32
+    )
+    ar = numpy.arange(1000 * 700, dtype=numpy.int32).reshape(700, 1000)
+    src_ds.GetRasterBand(1).WriteArray(ar)
+    src_ds.GetRasterBand(2).WriteArray(ar[::-1, ::-1])
+    src_ds = None
+
+    vrt = _expression_vrt(filename, "B1 < B2 ? (B1 - B2) / 3 : B2 * 0.5", 2)
+    expected = gdal.Open(vrt).GetRasterBand(1).ReadAsArray()
+    a = ar.astype(numpy.float64)
+    b = ar[::-1, ::-1].astype(numpy.float64)
+    numpy.testing.assert_array_equal(expected, numpy.where(a < b, (a - b) / 3, b * 0.5))
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        got = gdal.Open(vrt).GetRasterBand(1).ReadAsArray()
+    numpy.testing.assert_array_equal(got, expected)
+
+    # Expression bands read by the source jobs of another VRT
+    sources = []
+    for i in range(4):
+        # Distinct source files, as the jobs may run concurrently
+        copy_filename = str(tmp_vsimem / ("src%d.tif" % i))
+        gdal.GetDriverByName("GTiff").CreateCopy(copy_filename, gdal.Open(filename))
+        vrt_filename = str(tmp_vsimem / ("expr%d.vrt" % i))
+        gdal.FileFromMemBuffer(
+            vrt_filename,
+            _expression_vrt(copy_filename, "B1 < B2 ? (B1 - B2) / 3 : B2 * 0.5", 2),
+        )
+        sources.append(
+            """<SimpleSource>
+      <SourceFilename>%s</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <DstRect xOff="%d" yOff="0" xSize="1000" ySize="700"/>
+    </SimpleSource>"""
+            % (vrt_filename, i * 1000)
+        )
+    mosaic = """<VRTDataset rasterXSize="4000" rasterYSize="700">
+  <VRTRasterBand dataType="Float64" band="1">
+    %s
+  </VRTRasterBand>
+</VRTDataset>""" % "\n".join(
+        sources
+    )
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        got = gdal.Open(mosaic).GetRasterBand(1).ReadAsArray()
+    for i in range(4):
+        numpy.testing.assert_array_equal(got[:, i * 1000 : (i + 1) * 1000], expected)
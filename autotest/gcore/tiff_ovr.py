@@ -2340,6 +2340,58 @@ def test_tiff_ovr_multithreading_singleband():
     gdal.Unlink("/vsimem/test.tif")
 
 
+###############################################################################
+# Test multithreaded compression of internal overviews and mask overviews,
+# when the full resolution image is not compressed
+
+
+@pytest.mark.parametrize("interleave", ["PIXEL", "BAND"])
+def test_tiff_ovr_multithreading_compression(tmp_vsimem, interleave):
+
+    checksums = []
+    for num_threads in ["1", "8"]:
+        filename = str(tmp_vsimem / f"test_{num_threads}.tif")
+        ds = gdal.Translate(
+            filename,
+            "data/stefan_full_rgba.tif",
+            creationOptions=["INTERLEAVE=" + interleave],
+        )
+        ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+        mask_ysize = ds.RasterYSize // 2
+        ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+            0, 0, ds.RasterXSize, mask_ysize, b"\xff" * (ds.RasterXSize * mask_ysize)
+        )
+        with gdaltest.config_option("GDAL_OVR_CHUNKYSIZE", "1"):
+            ds.BuildOverviews(
+                "AVERAGE",
+                [2, 4],
+                options=[
+                    "COMPRESS_OVERVIEW=DEFLATE",
+                    "NUM_THREADS=" + num_threads,
+                ],
+            )
+        ds = None
+
+        ds = gdal.Open(filename)
+        ovr_band = ds.GetRasterBand(1).GetOverview(0)
+        assert (
+            ovr_band.GetDataset().GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE")
+            == "DEFLATE"
+        )
+        mask_band = ds.GetRasterBand(1).GetMaskBand()
+        checksums.append(
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                for i in range(4)
+                for j in range(2)
+            ]
+            + [mask_band.GetOverview(j).Checksum() for j in range(2)]
+        )
+        ds = None
+
+    assert checksums[0] == checksums[1]
+
+
 ###############################################################################
 
 
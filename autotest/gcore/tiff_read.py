@@ -4167,6 +4167,89 @@ def test_tiff_read_cog_strile_arrays_zeroified_when_possible():
     assert cs_mask == 1222
 
 
+###############################################################################
+# Test reading ahead blocks on sequential access patterns
+
+
+@pytest.mark.parametrize("readahead_blocks", ["0", "1", "3"])
+@pytest.mark.parametrize("interleave", ["PIXEL", "BAND"])
+def test_tiff_read_readahead_blocks(tmp_vsimem, readahead_blocks, interleave):
+
+    filename = str(tmp_vsimem / "test.tif")
+    src_ds = gdal.Open("data/rgbsmall.tif")
+    gdal.Translate(
+        filename,
+        src_ds,
+        creationOptions=[
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+            "COMPRESS=DEFLATE",
+            "INTERLEAVE=" + interleave,
+        ],
+    )
+
+    with gdaltest.config_options(
+        {
+            "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE": "YES",
+            "GTIFF_READAHEAD_BLOCKS": readahead_blocks,
+        }
+    ):
+        ds = gdal.Open(filename)
+        xsize = ds.RasterXSize
+        ysize = ds.RasterYSize
+
+        # Tile rows, from top to bottom
+        for y in range(0, ysize, 16):
+            h = min(16, ysize - y)
+            assert ds.ReadRaster(0, y, xsize, h) == src_ds.ReadRaster(0, y, xsize, h)
+        ds.FlushCache()
+
+        # Tile columns, from left to right, through the band API
+        band = ds.GetRasterBand(2)
+        src_band = src_ds.GetRasterBand(2)
+        for x in range(0, xsize, 16):
+            w = min(16, xsize - x)
+            assert band.ReadRaster(x, 0, w, ysize) == src_band.ReadRaster(
+                x, 0, w, ysize
+            )
+
+        # Non sequential pattern
+        assert band.ReadRaster(16, 16, 16, 16) == src_band.ReadRaster(16, 16, 16, 16)
+        assert band.ReadRaster(0, 0, 16, 16) == src_band.ReadRaster(0, 0, 16, 16)
+
+    # Check that the read ahead blocks have been loaded in the block cache
+    def cache_used_by_two_block_columns(readahead_blocks):
+        with gdaltest.config_options(
+            {
+                "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE": "YES",
+                "GTIFF_READAHEAD_BLOCKS": readahead_blocks,
+            }
+        ):
+            ds = gdal.Open(filename)
+            band = ds.GetRasterBand(1)
+            cache_used_before = gdal.GetCacheUsed()
+            band.ReadRaster(0, 0, 16, ds.RasterYSize)
+            # Advances by one block column: triggers the read ahead
+            band.ReadRaster(16, 0, 16, ds.RasterYSize)
+            cache_used = gdal.GetCacheUsed() - cache_used_before
+            ds = None
+            return cache_used
+
+    cache_used_without_readahead = cache_used_by_two_block_columns("0")
+    cache_used = cache_used_by_two_block_columns(readahead_blocks)
+    if readahead_blocks == "0":
+        assert cache_used == cache_used_without_readahead
+    else:
+        # 50x50 raster: 4 blocks per block column, and 2 block columns
+        # remaining after the second one
+        read_ahead_block_columns = min(int(readahead_blocks), 2)
+        assert (
+            cache_used - cache_used_without_readahead
+            >= read_ahead_block_columns * 4 * 16 * 16
+        )
+
+
 ###############################################################################
 # Check that our reading of a COG with /vsicurl is efficient
 
@@ -4871,6 +4954,22 @@ def test_tiff_read_multi_threaded(
             buf_band_space=pixel_size,
         )
 
+        # Resampled requests, whose blocks are decoded in parallel in the
+        # block cache
+        ds.FlushCache()
+        assert ds.ReadRaster(
+            1, 1, ds.RasterXSize - 2, ds.RasterYSize - 2, buf_xsize=20, buf_ysize=30
+        ) == ref_ds.ReadRaster(
+            1, 1, ds.RasterXSize - 2, ds.RasterYSize - 2, buf_xsize=20, buf_ysize=30
+        )
+        for i in range(1, 1 + nbands):
+            ds.FlushCache()
+            assert ds.GetRasterBand(i).ReadRaster(
+                buf_xsize=2 * ds.RasterXSize, buf_ysize=ds.RasterYSize // 3
+            ) == ref_ds.GetRasterBand(i).ReadRaster(
+                buf_xsize=2 * ds.RasterXSize, buf_ysize=ds.RasterYSize // 3
+            )
+
     ds = None
     gdal.Unlink(tmpfile)
 
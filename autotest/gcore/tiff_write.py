@@ -10114,6 +10114,120 @@ def test_tiff_write_predictor_2_float64():
     gdal.Unlink(filename)
 
 
+###############################################################################
+# Rewrite the Predictor tag of a single-IFD file, so that the (de)predicted
+# sample values stored in it can be read back as is
+
+
+def _tiff_write_patch_predictor(filename, old_predictor, new_predictor):
+
+    f = gdal.VSIFOpenL(filename, "rb+")
+    data = gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+    fmt = "<HHIHH" if data[0:2] == b"II" else ">HHIHH"
+    old_entry = struct.pack(fmt, 317, 3, 1, old_predictor, 0)
+    assert data.count(old_entry) == 1
+    gdal.VSIFSeekL(f, data.find(old_entry), 0)
+    gdal.VSIFWriteL(struct.pack(fmt, 317, 3, 1, new_predictor, 0), 1, 12, f)
+    gdal.VSIFCloseL(f)
+
+
+###############################################################################
+# Check the horizontal and floating point predictors, whose implementations
+# have vectorized code paths, against a reference implementation, for all
+# sample sizes and a variety of strides and row sizes
+
+
+@pytest.mark.parametrize(
+    "dt,predictor",
+    [
+        (gdal.GDT_Byte, 2),
+        (gdal.GDT_UInt16, 2),
+        (gdal.GDT_UInt32, 2),
+        (gdal.GDT_UInt64, 2),
+        (gdal.GDT_Float32, 3),
+        (gdal.GDT_Float64, 3),
+    ],
+)
+@pytest.mark.parametrize("nbands", [1, 2, 3, 4, 5, 8])
+@pytest.mark.parametrize("width", [1, 37, 300])
+@pytest.mark.parametrize("endianness", ["LITTLE", "BIG"])
+def test_tiff_write_predictor_against_reference(
+    tmp_vsimem, dt, predictor, nbands, width, endianness
+):
+
+    np = pytest.importorskip("numpy")
+
+    if gdal.GetDriverByName("GTiff").GetMetadataItem("LIBTIFF") != "INTERNAL":
+        pytest.skip("internal libtiff needed")
+
+    if predictor == 3 and endianness == "BIG":
+        # Predicted floating point values are byte planes, which would be
+        # byte-swapped when read back with the Predictor tag set to 1
+        pytest.skip()
+
+    np_dt = {
+        gdal.GDT_Byte: np.uint8,
+        gdal.GDT_UInt16: np.uint16,
+        gdal.GDT_UInt32: np.uint32,
+        gdal.GDT_UInt64: np.uint64,
+        gdal.GDT_Float32: np.float32,
+        gdal.GDT_Float64: np.float64,
+    }[dt]
+    height = 3
+    rng = np.random.default_rng(width * nbands)
+    if predictor == 2:
+        ref = rng.integers(
+            0, np.iinfo(np_dt).max, size=(height, width, nbands), dtype=np_dt
+        )
+    else:
+        ref = rng.normal(0, 1e5, size=(height, width, nbands)).astype(np_dt)
+
+    filename = str(tmp_vsimem / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        width,
+        height,
+        nbands,
+        dt,
+        options=[
+            "COMPRESS=DEFLATE",
+            "PREDICTOR=%d" % predictor,
+            "ENDIANNESS=%s" % endianness,
+        ],
+    )
+    for i in range(nbands):
+        ds.GetRasterBand(i + 1).WriteArray(ref[:, :, i])
+    ds = None
+
+    def read_interleaved():
+        ds = gdal.Open(filename)
+        ret = np.stack(
+            [ds.GetRasterBand(i + 1).ReadAsArray() for i in range(nbands)], axis=-1
+        )
+        ds = None
+        return ret
+
+    # Decoding
+    assert np.array_equal(read_interleaved(), ref)
+
+    # Encoding
+    _tiff_write_patch_predictor(filename, predictor, 1)
+    got = read_interleaved().reshape(height, width * nbands)
+    if predictor == 2:
+        expected = ref.reshape(height, width * nbands).copy()
+        expected[:, nbands:] -= ref.reshape(height, width * nbands)[:, :-nbands]
+        assert np.array_equal(got, expected)
+    else:
+        bps = np.dtype(np_dt).itemsize
+        row_bytes = ref.astype("<" + np.dtype(np_dt).str[1:]).view(np.uint8)
+        # One plane per byte, most significant byte first
+        planes = row_bytes.reshape(height, width * nbands, bps)[:, :, ::-1]
+        planes = planes.transpose(0, 2, 1).reshape(height, -1)
+        expected = planes.copy()
+        expected[:, nbands:] -= planes[:, :-nbands]
+        assert np.array_equal(got.view(np.uint8), expected)
+
+
 ###############################################################################
 
 
@@ -11423,3 +11537,112 @@ def test_tiff_write_copy_mdd():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test REUSE_FREED_SPACE open option
+
+
+@pytest.mark.parametrize("reuse_freed_space", [True, False])
+@pytest.mark.parametrize("num_threads", [None, "2"])
+def test_tiff_write_reuse_freed_space(tmp_vsimem, reuse_freed_space, num_threads):
+
+    md = gdaltest.tiff_drv.GetMetadata()
+    if reuse_freed_space and md["LIBTIFF"] != "INTERNAL":
+        pytest.skip("REUSE_FREED_SPACE requires the internal libtiff")
+
+    filename = str(tmp_vsimem / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        512,
+        256,
+        options=[
+            "TILED=YES",
+            "BLOCKXSIZE=256",
+            "BLOCKYSIZE=256",
+            "COMPRESS=DEFLATE",
+        ],
+    )
+    ds.GetRasterBand(1).Fill(0)
+    ds = None
+
+    noise = os.urandom(256 * 256)
+    zeros = b"\x00" * (256 * 256)
+
+    open_options = ["REUSE_FREED_SPACE=" + ("YES" if reuse_freed_space else "NO")]
+    if num_threads:
+        open_options.append("NUM_THREADS=" + num_threads)
+    ds = gdal.OpenEx(filename, gdal.OF_UPDATE, open_options=open_options)
+    band = ds.GetRasterBand(1)
+
+    # Does not fit in the previous location: appended at end of file
+    band.WriteRaster(0, 0, 256, 256, noise)
+    ds.FlushCache()
+    size_after_first_noise_write = gdal.VSIStatL(filename).size
+
+    # Rewritten in place. The tail of the previous location becomes free
+    band.WriteRaster(0, 0, 256, 256, zeros)
+    ds.FlushCache()
+
+    # Does not fit in the previous location, but fits in the previous
+    # location merged with the free space following it.
+    band.WriteRaster(0, 0, 256, 256, noise)
+    ds.FlushCache()
+    size = gdal.VSIStatL(filename).size
+    if reuse_freed_space:
+        assert size == size_after_first_noise_write
+    else:
+        assert size > size_after_first_noise_write
+    ds = None
+
+    ds = gdal.Open(filename)
+    assert ds.ReadRaster(0, 0, 256, 256) == noise
+    assert ds.ReadRaster(256, 0, 256, 256) == zeros
+    ds = None
+
+
+###############################################################################
+# Test that CreateCopy() copies compressed striles without re-encoding them
+# when the source has the same compression and layout
+
+
+@pytest.mark.parametrize("interleave", ["PIXEL", "BAND"])
+@pytest.mark.parametrize("tiled", ["YES", "NO"])
+def test_tiff_write_createcopy_raw_striles(tmp_vsimem, interleave, tiled):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    options = [
+        "TILED=" + tiled,
+        "BLOCKYSIZE=32",
+        "INTERLEAVE=" + interleave,
+        "COMPRESS=DEFLATE",
+        "PREDICTOR=2",
+    ]
+    if tiled == "YES":
+        options.append("BLOCKXSIZE=32")
+    # Use a non-default compression level, so that re-encoding would not
+    # give the same striles
+    gdal.Translate(
+        src_filename,
+        "data/rgbsmall.tif",
+        width=100,
+        height=70,
+        creationOptions=options + ["ZLEVEL=1"],
+    )
+
+    filename = str(tmp_vsimem / "out.tif")
+    src_ds = gdal.Open(src_filename)
+    ds = gdal.GetDriverByName("GTiff").CreateCopy(filename, src_ds, options=options)
+    ds = None
+
+    ds = gdal.Open(filename)
+    for i in range(3):
+        band = ds.GetRasterBand(i + 1)
+        src_band = src_ds.GetRasterBand(i + 1)
+        assert band.Checksum() == src_band.Checksum()
+        for y in range(3):
+            x_blocks = 4 if tiled == "YES" else 1
+            for x in range(x_blocks):
+                item = f"BLOCK_SIZE_{x}_{y}"
+                size = band.GetMetadataItem(item, "TIFF")
+                assert size == src_band.GetMetadataItem(item, "TIFF")
@@ -2586,3 +2586,285 @@ def test_vrt_read_compute_statistics_approximate(tmp_vsimem):
     assert "STATISTICS_MEAN" in md
     assert "STATISTICS_STDDEV" in md
     assert md["STATISTICS_VALID_PERCENT"] == "100"
+
+
+###############################################################################
+# Test reading sources in parallel, with overlapping sources, different kinds
+# of sources, several sources from the same dataset and derived bands
+
+
+def test_vrt_read_multithreaded_sources(tmp_vsimem):
+
+    src_ds = gdal.Open("data/rgbsmall.tif")
+
+    tile_filenames = []
+    for i in range(9):
+        filename = str(tmp_vsimem / ("tile%d.tif" % i))
+        gdal.Translate(
+            filename,
+            src_ds,
+            options="-srcwin %d %d 25 25" % (i * 3, i * 2),
+        )
+        tile_filenames.append(filename)
+
+    def source(kind, i, dst_x, dst_y, extra=""):
+        return """<%s>
+            <SourceFilename>%s</SourceFilename>
+            <SourceBand>1</SourceBand>
+            <SrcRect xOff="0" yOff="0" xSize="25" ySize="25"/>
+            <DstRect xOff="%d" yOff="%d" xSize="25" ySize="25"/>
+            %s
+          </%s>""" % (
+            kind,
+            tile_filenames[i],
+            dst_x,
+            dst_y,
+            extra,
+            kind,
+        )
+
+    sources = []
+    for i in range(9):
+        # Tiles overlap by 3 pixels
+        dst_x = (i % 3) * 22
+        dst_y = (i // 3) * 22
+        if i % 4 == 0:
+            sources.append(source("SimpleSource", i, dst_x, dst_y))
+        elif i % 4 == 1:
+            sources.append(
+                source(
+                    "ComplexSource",
+                    i,
+                    dst_x,
+                    dst_y,
+                    "<ScaleOffset>10</ScaleOffset><ScaleRatio>0.5</ScaleRatio>",
+                )
+            )
+        elif i % 4 == 2:
+            sources.append(
+                source("ComplexSource", i, dst_x, dst_y, "<LUT>0:255,255:0</LUT>")
+            )
+        else:
+            sources.append(
+                source("ComplexSource", i, dst_x, dst_y, "<NODATA>0</NODATA>")
+            )
+    # Several sources reading the same dataset
+    sources.append(source("AveragedSource", 0, 5, 40))
+    sources.append(source("SimpleSource", 0, 40, 5))
+
+    vrt = """<VRTDataset rasterXSize="69" rasterYSize="69">
+      <VRTRasterBand dataType="Byte" band="1">
+        %s
+      </VRTRasterBand>
+      <VRTRasterBand dataType="Float32" band="2" subClass="VRTDerivedRasterBand">
+        <PixelFunctionType>sum</PixelFunctionType>
+        %s
+      </VRTRasterBand>
+    </VRTDataset>""" % (
+        "\n".join(sources),
+        "\n".join(sources),
+    )
+
+    def read(ds):
+        ret = []
+        for band in (ds.GetRasterBand(1), ds.GetRasterBand(2)):
+            ret.append(band.ReadRaster())
+            ret.append(band.ReadRaster(3, 4, 50, 60))
+            ret.append(band.ReadRaster(buf_xsize=30, buf_ysize=30))
+            ret.append(
+                band.ReadRaster(
+                    buf_xsize=30,
+                    buf_ysize=30,
+                    resample_alg=gdal.GRIORA_Bilinear,
+                )
+            )
+        return ret
+
+    expected = read(gdal.Open(vrt))
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        assert read(gdal.Open(vrt)) == expected
+
+    # Dataset-level RasterIO() of a mosaic built by gdalbuildvrt
+    mosaic_ds = gdal.BuildVRT("", tile_filenames)
+    expected = mosaic_ds.ReadRaster()
+    mosaic_ds = gdal.BuildVRT("", tile_filenames)
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        assert mosaic_ds.ReadRaster() == expected
+
+
+###############################################################################
+# Test reading in parallel the sources of a VRT whose sources are VRTs, or
+# tiled compressed GTiff files that are themselves read with several threads
+
+
+@pytest.mark.parametrize("num_threads", ["2", "8"])
+def test_vrt_read_multithreaded_nested_sources(tmp_vsimem, num_threads):
+
+    src_ds = gdal.Open("data/byte.tif")
+
+    # 4x4 tiles of 64x64 pixels, made of blocks of 16x16 pixels
+    tile_filenames = []
+    for j in range(4):
+        for i in range(4):
+            filename = str(tmp_vsimem / ("tile_%d_%d.tif" % (i, j)))
+            gdal.Translate(
+                filename,
+                src_ds,
+                options="-outsize 64 64 -scale 0 255 %d %d -a_ullr %d %d %d %d "
+                "-co TILED=YES -co BLOCKXSIZE=16 -co BLOCKYSIZE=16 "
+                "-co COMPRESS=DEFLATE"
+                % (i * 4 + j, 255 - j, i * 64, -j * 64, (i + 1) * 64, -(j + 1) * 64),
+            )
+            tile_filenames.append(filename)
+
+    mosaic_filename = str(tmp_vsimem / "mosaic.vrt")
+    gdal.BuildVRT(mosaic_filename, tile_filenames)
+
+    # Each quadrant of the outer VRT is a VRT of 2x2 tiles
+    quadrant_filenames = []
+    for j in range(2):
+        for i in range(2):
+            filename = str(tmp_vsimem / ("quadrant_%d_%d.vrt" % (i, j)))
+            gdal.BuildVRT(
+                filename,
+                [
+                    tile_filenames[(2 * j + y) * 4 + 2 * i + x]
+                    for y in range(2)
+                    for x in range(2)
+                ],
+            )
+            quadrant_filenames.append(filename)
+    nested_filename = str(tmp_vsimem / "nested.vrt")
+    gdal.BuildVRT(nested_filename, quadrant_filenames)
+
+    def read(filename):
+        ds = gdal.Open(filename)
+        band = ds.GetRasterBand(1)
+        return [
+            ds.ReadRaster(),
+            band.ReadRaster(),
+            band.ReadRaster(30, 20, 200, 210),
+            band.ReadRaster(buf_xsize=100, buf_ysize=100),
+        ]
+
+    expected = read(mosaic_filename)
+    assert read(nested_filename) == expected
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        assert read(mosaic_filename) == expected
+        assert read(nested_filename) == expected
+
+
+###############################################################################
+# Test reading a mosaic with enough sources for the spatial index of sources
+# to be used
+
+
+@pytest.mark.parametrize("num_threads", [None, "4"])
+def test_vrt_read_many_sources_spatial_index(tmp_vsimem, num_threads):
+
+    src_ds = gdal.Open("data/rgbsmall.tif")
+
+    # 100 tiles of 5x5 pixels
+    tile_filenames = []
+    for j in range(10):
+        for i in range(10):
+            filename = str(tmp_vsimem / ("tile_%d_%d.tif" % (i, j)))
+            gdal.Translate(
+                filename, src_ds, options="-srcwin %d %d 5 5" % (i * 5, j * 5)
+            )
+            tile_filenames.append(filename)
+
+    # Constant patch added last, thus on top of the tiles
+    patch_filename = str(tmp_vsimem / "patch.tif")
+    patch_ds = gdal.GetDriverByName("GTiff").Create(patch_filename, 7, 7, 3)
+    patch_ds.SetGeoTransform(
+        [
+            src_ds.GetGeoTransform()[0] + 12 * src_ds.GetGeoTransform()[1],
+            src_ds.GetGeoTransform()[1],
+            0,
+            src_ds.GetGeoTransform()[3] + 21 * src_ds.GetGeoTransform()[5],
+            0,
+            src_ds.GetGeoTransform()[5],
+        ]
+    )
+    patch_ds.SetProjection(src_ds.GetProjectionRef())
+    patch_ds.GetRasterBand(1).Fill(255)
+    patch_ds = None
+
+    mem_ds = gdal.GetDriverByName("MEM").CreateCopy("", src_ds)
+    for i in range(3):
+        mem_ds.GetRasterBand(i + 1).WriteRaster(
+            12, 21, 7, 7, b"\xff" * 49 if i == 0 else b"\x00" * 49
+        )
+
+    windows = [
+        (0, 0, 50, 50),
+        (0, 0, 1, 1),
+        (49, 49, 1, 1),
+        (4, 4, 2, 2),
+        (7, 3, 21, 33),
+        (10, 20, 10, 10),
+        (45, 0, 5, 50),
+    ]
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        vrt_ds = gdal.BuildVRT("", tile_filenames + [patch_filename])
+        assert vrt_ds.GetRasterBand(1).GetMetadataItem("source_0", "vrt_sources")
+        for window in windows:
+            # Dataset-level and band-level code paths
+            assert vrt_ds.ReadRaster(*window) == mem_ds.ReadRaster(*window)
+            for i in range(3):
+                assert vrt_ds.GetRasterBand(i + 1).ReadRaster(
+                    *window
+                ) == mem_ds.GetRasterBand(i + 1).ReadRaster(*window)
+
+        # Replace the first tile with the last one, and check that the
+        # spatial index is refreshed
+        band = vrt_ds.GetRasterBand(1)
+        band.SetMetadataItem(
+            "source_0",
+            band.GetMetadataItem("source_99", "vrt_sources"),
+            "vrt_sources",
+        )
+        assert band.ReadRaster(0, 0, 5, 5) == b"\x00" * 25
+        assert band.ReadRaster(45, 45, 5, 5) == mem_ds.GetRasterBand(1).ReadRaster(
+            45, 45, 5, 5
+        )
+
+
+###############################################################################
+# Test multithreaded reading of a VRT with more sources than the size of the
+# dataset pool, so that sources are concurrently opened and evicted
+
+
+@pytest.mark.skipif(
+    test_cli_utilities.get_gdalinfo_path() is None, reason="gdalinfo not available"
+)
+def test_vrt_read_many_sources_small_dataset_pool(tmp_path):
+
+    src_ds = gdal.Open("data/rgbsmall.tif")
+
+    tile_filenames = []
+    for j in range(10):
+        for i in range(10):
+            filename = str(tmp_path / ("tile_%d_%d.tif" % (i, j)))
+            gdal.Translate(
+                filename, src_ds, options="-srcwin %d %d 5 5" % (i * 5, j * 5)
+            )
+            tile_filenames.append(filename)
+
+    vrt_filename = str(tmp_path / "mosaic.vrt")
+    gdal.BuildVRT(vrt_filename, tile_filenames)
+
+    expected_checksums = [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(src_ds.RasterCount)
+    ]
+
+    ret = gdaltest.runexternal(
+        test_cli_utilities.get_gdalinfo_path()
+        + " -checksum "
+        + vrt_filename
+        + " --config GDAL_MAX_DATASET_POOL_SIZE 5 --config GDAL_NUM_THREADS 4"
+    )
+    for cs in expected_checksums:
+        assert "Checksum=%d" % cs in ret
@@ -2054,6 +2054,59 @@ def test_gti_flushcache(tmp_vsimem):
     assert vrt_ds.GetRasterBand(1).ReadRaster() == b"\x02"
 
 
+###############################################################################
+# Test that the in-memory snapshot of the index gives the same results as
+# going through the spatial filter of the index layer
+
+
+def test_gti_index_snapshot(tmp_vsimem):
+
+    src_ds_list = []
+    for i, (x, y) in enumerate([(0, 4), (2, 4), (0, 2), (2, 2), (1, 3)]):
+        filename = str(tmp_vsimem / f"tile{i}.tif")
+        ds = gdal.GetDriverByName("GTiff").Create(filename, 2, 2)
+        ds.SetGeoTransform([x, 1, 0, y, 0, -1])
+        ds.GetRasterBand(1).Fill(i + 1)
+        ds.Close()
+        src_ds_list.append(gdal.Open(filename))
+
+    # The last tile, in the middle, has the highest priority
+    index_filename = str(tmp_vsimem / "index.gti.gpkg")
+    index_ds, lyr = create_basic_tileindex(
+        index_filename,
+        src_ds_list,
+        sort_field_name="z_order",
+        sort_field_type=ogr.OFTInteger,
+        sort_values=[1, 2, 3, 4, 5],
+    )
+    # Give a non-rectangular footprint to the last tile
+    f = lyr.GetFeature(5)
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POLYGON ((1 1,1 3,3 3,1 1))"))
+    lyr.SetFeature(f)
+    del index_ds
+
+    def get_results():
+        ds = gdal.Open(index_filename)
+        band = ds.GetRasterBand(1)
+        res = [band.ReadRaster()]
+        for y in range(ds.RasterYSize):
+            for x in range(ds.RasterXSize):
+                res.append(band.ReadRaster(x, y, 1, 1))
+                res.append(band.GetMetadataItem(f"Pixel_{x}_{y}", "LocationInfo"))
+        return res
+
+    expected = get_results()
+    assert expected[0] == (
+        b"\x01\x01\x02\x02\x01\x05\x05\x02\x03\x05\x05\x04\x03\x03\x04\x04"
+    )
+
+    with gdaltest.config_option("GTI_INDEX_SNAPSHOT_MAX_FEATURES", "0"):
+        assert get_results() == expected
+
+    with gdaltest.config_option("GTI_INDEX_SNAPSHOT_MAX_FEATURES", "4"):
+        assert get_results() == expected
+
+
 def test_gti_ovr_factor(tmp_vsimem):
 
     index_filename = str(tmp_vsimem / "index.gti.gpkg")
@@ -34,6 +34,7 @@ import shutil
 import stat
 import struct
 import sys
+import threading
 import time
 
 import gdaltest
@@ -4006,3 +4007,79 @@ def test_netcdf_multidim_as_classic_dataset_overview(tmp_path):
 
     test()
     test2()
+
+
+###############################################################################
+# Test GDAL_NETCDF_USE_MDARRAY_CHUNK_CACHE
+
+
+@gdaltest.enable_exceptions()
+def test_netcdf_multidim_read_through_chunk_cache(tmp_path):
+
+    filename = str(tmp_path / "test_netcdf_multidim_read_through_chunk_cache.nc")
+
+    def create():
+        drv = gdal.GetDriverByName("netCDF")
+        ds = drv.CreateMultiDimensional(filename)
+        rg = ds.GetRootGroup()
+        dim_y = rg.CreateDimension("Y", None, None, 7)
+        dim_x = rg.CreateDimension("X", None, None, 9)
+        var = rg.CreateMDArray(
+            "var",
+            [dim_y, dim_x],
+            gdal.ExtendedDataType.Create(gdal.GDT_Int16),
+            ["BLOCKSIZE=3,4"],
+        )
+        var.Write(array.array("h", [i for i in range(7 * 9)]))
+
+    create()
+
+    def read_windows(var):
+        return [
+            var.Read(),
+            var.Read(array_start_idx=[2, 3], count=[4, 5]),
+            var.Read(array_start_idx=[6, 8], count=[1, 1]),
+            var.Read(
+                array_start_idx=[1, 2],
+                count=[5, 6],
+                buffer_datatype=gdal.ExtendedDataType.Create(gdal.GDT_Float64),
+            ),
+            var.Read(array_start_idx=[6, 8], count=[3, 2], array_step=[-2, -3]),
+            var.Transpose([1, 0]).Read(),
+        ]
+
+    def open_var():
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        return ds, ds.GetRootGroup().OpenMDArray("var")
+
+    ds, var = open_var()
+    ref = read_windows(var)
+    del var
+    del ds
+
+    with gdal.config_option("GDAL_NETCDF_USE_MDARRAY_CHUNK_CACHE", "YES"):
+        ds, var = open_var()
+    # Run twice on the same array: the first pass fills the cache, and the
+    # second one is served from it
+    assert read_windows(var) == ref
+    assert read_windows(var) == ref
+
+    errors = []
+
+    def thread_func():
+        for i in range(20):
+            y = i % 7
+            x = i % 9
+            data = var.Read(array_start_idx=[y, x], count=[7 - y, 9 - x])
+            expected = array.array(
+                "h", [yy * 9 + xx for yy in range(y, 7) for xx in range(x, 9)]
+            )
+            if data != expected.tobytes():
+                errors.append((y, x))
+
+    threads = [threading.Thread(target=thread_func) for _ in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert not errors
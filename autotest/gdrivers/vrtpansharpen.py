@@ -2304,3 +2304,145 @@ def test_vrtpansharpen_out_of_order_input_bands_and_nodata():
     cs2 = [vrt_ds.GetRasterBand(i + 1).Checksum() for i in range(vrt_ds.RasterCount)]
 
     assert cs2 == cs[::-1]
+
+
+###############################################################################
+# Test floating-point weighted Brovey, including a number of pixels that is
+# not a multiple of the vector width, and null pseudo panchromatic values
+
+
+@pytest.mark.parametrize("dt", [gdal.GDT_Float32, gdal.GDT_Float64])
+def test_vrtpansharpen_weighted_brovey_floating_point(dt):
+
+    width = 7
+    pan_values = [1.5, 2, 3, 4, 5, 6, 7]
+    ms_values = [
+        [0.5, 0, 1, 2.5, 3, 1e-3, 10],
+        [1, 0, 2, 1.5, 2, 1e-3, 20],
+        [2, 0, 3, 0.5, 1, 1e-3, 30],
+    ]
+    weights = [0.25, 0.5, 0.25]
+
+    pan_ds = gdal.GetDriverByName("MEM").Create("", width, 1, 1, gdal.GDT_Float64)
+    pan_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    pan_ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, 1, struct.pack("d" * width, *pan_values)
+    )
+    ms_ds = gdal.GetDriverByName("MEM").Create("", width, 1, 3, gdal.GDT_Float64)
+    ms_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    for i in range(3):
+        ms_ds.GetRasterBand(i + 1).WriteRaster(
+            0, 0, width, 1, struct.pack("d" * width, *ms_values[i])
+        )
+
+    vrt_ds = gdal.CreatePansharpenedVRT(
+        """<VRTDataset subClass="VRTPansharpenedDataset">
+        <PansharpeningOptions>
+            <AlgorithmOptions>
+                <Weights>%s</Weights>
+            </AlgorithmOptions>
+            <Resampling>Nearest</Resampling>
+            <SpectralBand dstBand="1">
+            </SpectralBand>
+            <SpectralBand dstBand="2">
+            </SpectralBand>
+            <SpectralBand dstBand="3">
+            </SpectralBand>
+        </PansharpeningOptions>
+    </VRTDataset>"""
+        % ",".join(str(w) for w in weights),
+        pan_ds.GetRasterBand(1),
+        [ms_ds.GetRasterBand(i + 1) for i in range(3)],
+    )
+    assert vrt_ds is not None
+
+    for i in range(3):
+        got = struct.unpack(
+            "d" * width,
+            vrt_ds.GetRasterBand(i + 1).ReadRaster(buf_type=gdal.GDT_Float64),
+        )
+        got_dt = struct.unpack(
+            "d" * width,
+            gdal.Translate("", vrt_ds, format="MEM", outputType=dt, bandList=[i + 1])
+            .GetRasterBand(1)
+            .ReadRaster(buf_type=gdal.GDT_Float64),
+        )
+        for j in range(width):
+            pseudo_pan = sum(weights[k] * ms_values[k][j] for k in range(3))
+            factor = pan_values[j] / pseudo_pan if pseudo_pan != 0 else 0
+            expected = ms_values[i][j] * factor
+            assert got[j] == pytest.approx(expected, rel=1e-12)
+            assert got_dt[j] == pytest.approx(expected, rel=1e-6)
+
+
+###############################################################################
+# Test that floating-point weighted Brovey gives the same Float32 values for
+# the vectorized pixels and the remaining ones, at the edges of the Float32
+# range
+
+
+def test_vrtpansharpen_weighted_brovey_float32_range_edges():
+
+    flt_max = struct.unpack("f", struct.pack("I", 0x7F7FFFFF))[0]
+    # Rounded to FLT_MAX by a float conversion, but beyond FLT_MAX
+    above_flt_max = flt_max * (1 + 2**-26)
+    below_flt_max = flt_max * (1 - 2**-26)
+    # The first 8 pixels are processed 4 by 4, and the last one alone
+    pan_values = [
+        above_flt_max,
+        -above_flt_max,
+        flt_max,
+        -flt_max,
+        below_flt_max,
+        1.5,
+        1e300,
+        -1e300,
+        above_flt_max,
+    ]
+    width = len(pan_values)
+
+    pan_ds = gdal.GetDriverByName("MEM").Create("", width, 1, 1, gdal.GDT_Float64)
+    pan_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    pan_ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, 1, struct.pack("d" * width, *pan_values)
+    )
+    ms_ds = gdal.GetDriverByName("MEM").Create("", width, 1, 3, gdal.GDT_Float32)
+    ms_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    for i in range(3):
+        ms_ds.GetRasterBand(i + 1).Fill(1)
+
+    vrt_ds = gdal.CreatePansharpenedVRT(
+        """<VRTDataset subClass="VRTPansharpenedDataset">
+        <PansharpeningOptions>
+            <AlgorithmOptions>
+                <Weights>0.5,0.25,0.25</Weights>
+            </AlgorithmOptions>
+            <Resampling>Nearest</Resampling>
+            <SpectralBand dstBand="1">
+            </SpectralBand>
+            <SpectralBand dstBand="2">
+            </SpectralBand>
+            <SpectralBand dstBand="3">
+            </SpectralBand>
+        </PansharpeningOptions>
+    </VRTDataset>""",
+        pan_ds.GetRasterBand(1),
+        [ms_ds.GetRasterBand(i + 1) for i in range(3)],
+    )
+    assert vrt_ds is not None
+    assert vrt_ds.GetRasterBand(1).DataType == gdal.GDT_Float32
+
+    # Pseudo panchromatic values are 1, so the output is the panchromatic
+    # value, which overflows to infinity when out of the Float32 range
+    expected = []
+    for v in pan_values:
+        if v > flt_max:
+            expected.append(float("inf"))
+        elif v < -flt_max:
+            expected.append(float("-inf"))
+        else:
+            expected.append(struct.unpack("f", struct.pack("f", v))[0])
+
+    for i in range(3):
+        got = struct.unpack("f" * width, vrt_ds.GetRasterBand(i + 1).ReadRaster())
+        assert list(got) == expected
@@ -3851,6 +3851,319 @@ def test_zarr_advise_read(compression, format):
         gdal.RmdirRecursive(filename)
 
 
+@pytest.mark.parametrize("compression", ["NONE", "GZIP"])
+@pytest.mark.parametrize("format", ["ZARR_V2", "ZARR_V3"])
+def test_zarr_multithreaded_read_write(tmp_vsimem, compression, format):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    dim0_size = 123
+    dim1_size = 257
+    dim0_blocksize = 20
+    dim1_blocksize = 30
+    data = array.array("B", [(i % 255) + 1 for i in range(dim0_size * dim1_size)])
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+            filename, options=["FORMAT=" + format]
+        )
+        rg = ds.GetRootGroup()
+        dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+        dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+        ar = rg.CreateMDArray(
+            "test",
+            [dim0, dim1],
+            gdal.ExtendedDataType.Create(gdal.GDT_Byte),
+            [
+                "COMPRESS=" + compression,
+                "BLOCKSIZE=%d,%d" % (dim0_blocksize, dim1_blocksize),
+            ],
+        )
+        assert ar.Write(data) == gdal.CE_None
+        # Partial tile update, that requires the tile to be written before
+        assert ar.Write(b"\x00", array_start_idx=[1, 2], count=[1, 1]) == gdal.CE_None
+        data[1 * dim1_size + 2] = 0
+        # Read while tile writes might be pending
+        assert ar.Read() == data
+        ds = None
+
+    def read():
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        ar = ds.GetRootGroup().OpenMDArray("test")
+        return (
+            ar.Read(),
+            ar.Read(array_start_idx=[15, 25], count=[50, 100]),
+            ar.Read(array_start_idx=[15, 25], count=[50, 100], array_step=[2, 3]),
+        )
+
+    expected = read()
+    assert expected[0] == data
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert read() == expected
+
+        # Force the request to be processed in several slabs
+        with gdaltest.SetCacheMax(4 * dim0_blocksize * dim1_blocksize * 10):
+            assert read() == expected
+
+
+###############################################################################
+# Test writing and reading Zarr V3 arrays using the sharding_indexed codec
+
+
+@pytest.mark.parametrize("compression", ["NONE", "GZIP"])
+def test_zarr_v3_sharding_write_read(tmp_vsimem, compression):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    dim0_size = 45
+    dim1_size = 70
+    data = array.array("h", [i - 1000 for i in range(dim0_size * dim1_size)])
+
+    ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+        filename, options=["FORMAT=ZARR_V3"]
+    )
+    rg = ds.GetRootGroup()
+    dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+    dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+    ar = rg.CreateMDArray(
+        "test",
+        [dim0, dim1],
+        gdal.ExtendedDataType.Create(gdal.GDT_Int16),
+        [
+            "COMPRESS=" + compression,
+            "BLOCKSIZE=10,15",
+            "SHARD_BLOCKSIZE=20,30",
+        ],
+    )
+    assert ar.GetBlockSize() == [10, 15]
+    assert ar.Write(data) == gdal.CE_None
+    # Partial update of an inner chunk
+    assert ar.Write(b"\x00\x00", array_start_idx=[1, 2], count=[1, 1]) == gdal.CE_None
+    data[1 * dim1_size + 2] = 0
+    assert ar.Read() == data
+    ds = None
+
+    j = json.loads(gdal.VSIFile(filename + "/test/zarr.json", "rb").read())
+    assert j["chunk_grid"]["configuration"]["chunk_shape"] == [20, 30]
+    assert len(j["codecs"]) == 1
+    assert j["codecs"][0]["name"] == "sharding_indexed"
+    assert j["codecs"][0]["configuration"]["chunk_shape"] == [10, 15]
+
+    # One file per shard
+    assert gdal.VSIStatL(filename + "/test/c/2/2") is not None
+    assert gdal.VSIStatL(filename + "/test/c/3/0") is None
+
+    # Update an area that spans several shards, and that does not cover
+    # whole shards.
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER | gdal.OF_UPDATE)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    assert ar.GetBlockSize() == [10, 15]
+    assert (
+        ar.Write(
+            array.array("h", [1] * (20 * 25)),
+            array_start_idx=[12, 22],
+            count=[20, 25],
+        )
+        == gdal.CE_None
+    )
+    for i in range(20):
+        for j in range(25):
+            data[(12 + i) * dim1_size + 22 + j] = 1
+    ds = None
+
+    def read():
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        ar = ds.GetRootGroup().OpenMDArray("test")
+        return (
+            ar.Read(),
+            ar.Read(array_start_idx=[15, 25], count=[20, 30]),
+            ar.Read(array_start_idx=[15, 25], count=[20, 30], array_step=[2, 3]),
+        )
+
+    expected = read()
+    assert array.array("h", expected[0]) == data
+
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert read() == expected
+
+
+def _crc32c(data):
+    crc = 0xFFFFFFFF
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x82F63B78 if crc & 1 else crc >> 1
+    return crc ^ 0xFFFFFFFF
+
+
+@pytest.mark.parametrize("index_location", ["start", "end"])
+@pytest.mark.parametrize("corrupted_crc", [False, True])
+def test_zarr_v3_sharding_read(tmp_vsimem, index_location, corrupted_crc):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    j = {
+        "zarr_format": 3,
+        "node_type": "array",
+        "shape": [4, 3],
+        "data_type": "uint8",
+        "chunk_grid": {"name": "regular", "configuration": {"chunk_shape": [4, 4]}},
+        "chunk_key_encoding": {"name": "default"},
+        "fill_value": 255,
+        "codecs": [
+            {
+                "name": "sharding_indexed",
+                "configuration": {
+                    "chunk_shape": [2, 2],
+                    "codecs": [
+                        {"name": "endian", "configuration": {"endian": "little"}}
+                    ],
+                    "index_codecs": [
+                        {"name": "bytes", "configuration": {"endian": "little"}},
+                        {"name": "crc32c"},
+                    ],
+                    "index_location": index_location,
+                },
+            }
+        ],
+    }
+    gdal.Mkdir(filename, 0)
+    gdal.FileFromMemBuffer(filename + "/zarr.json", json.dumps(j))
+
+    # 4 inner chunks: the second one is missing
+    index_size = 4 * 16 + 4
+    offset = index_size if index_location == "start" else 0
+    chunks = b""
+    index = []
+    for idx, chunk in enumerate(
+        [bytes([1, 2, 5, 6]), None, bytes([9, 10, 13, 14]), bytes([11, 12, 15, 16])]
+    ):
+        if chunk is None:
+            index += [0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF]
+        else:
+            index += [offset + len(chunks), len(chunk)]
+            chunks += chunk
+    index = struct.pack("<8Q", *index)
+    index += struct.pack("<I", _crc32c(index) ^ (1 if corrupted_crc else 0))
+    gdal.Mkdir(filename + "/c", 0)
+    gdal.Mkdir(filename + "/c/0", 0)
+    gdal.FileFromMemBuffer(
+        filename + "/c/0/0",
+        index + chunks if index_location == "start" else chunks + index,
+    )
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar = ds.GetRootGroup().OpenMDArray(ds.GetRootGroup().GetMDArrayNames()[0])
+    assert ar.GetBlockSize() == [2, 2]
+    if corrupted_crc:
+        with pytest.raises(Exception, match="CRC32C checksum"):
+            with gdaltest.enable_exceptions():
+                ar.Read()
+    else:
+        assert ar.Read() == bytes([1, 2, 255, 5, 6, 255, 9, 10, 11, 13, 14, 15])
+
+
+###############################################################################
+# Test that a shard with too many inner chunks is rejected
+
+
+@gdaltest.enable_exceptions()
+def test_zarr_v3_sharding_too_many_inner_chunks(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    j = {
+        "zarr_format": 3,
+        "node_type": "array",
+        "shape": [4, 3],
+        "data_type": "uint8",
+        "chunk_grid": {
+            "name": "regular",
+            "configuration": {"chunk_shape": [1 << 31, 1 << 31]},
+        },
+        "chunk_key_encoding": {"name": "default"},
+        "fill_value": 255,
+        "codecs": [
+            {
+                "name": "sharding_indexed",
+                "configuration": {
+                    "chunk_shape": [1, 1],
+                    "codecs": [
+                        {"name": "endian", "configuration": {"endian": "little"}}
+                    ],
+                },
+            }
+        ],
+    }
+    gdal.Mkdir(filename, 0)
+    gdal.FileFromMemBuffer(filename + "/zarr.json", json.dumps(j))
+
+    with pytest.raises(Exception, match="too many inner chunks per shard"):
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        rg = ds.GetRootGroup()
+        rg.OpenMDArray(rg.GetMDArrayNames()[0])
+
+
+###############################################################################
+# Test that overlapping reads, served by the multidimensional chunk cache,
+# return consistent data, including after writes.
+
+
+@pytest.mark.parametrize("format", ["ZARR_V2", "ZARR_V3"])
+def test_zarr_multidim_chunk_cache(tmp_vsimem, format):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    dim0_size = 30
+    dim1_size = 40
+    data = array.array("h", [i for i in range(dim0_size * dim1_size)])
+
+    ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+        filename, options=["FORMAT=" + format]
+    )
+    rg = ds.GetRootGroup()
+    dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+    dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+    ar = rg.CreateMDArray(
+        "test",
+        [dim0, dim1],
+        gdal.ExtendedDataType.Create(gdal.GDT_Int16),
+        ["COMPRESS=GZIP", "BLOCKSIZE=10,10"],
+    )
+    assert ar.Write(data) == gdal.CE_None
+    ds = None
+
+    def expected(start, count):
+        return array.array(
+            "h",
+            [
+                data[(start[0] + i) * dim1_size + start[1] + j]
+                for i in range(count[0])
+                for j in range(count[1])
+            ],
+        )
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER | gdal.OF_UPDATE)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    for start, count in [
+        ([0, 0], [15, 15]),
+        ([5, 5], [15, 15]),
+        ([0, 0], [15, 15]),
+        ([2, 3], [25, 35]),
+    ]:
+        assert ar.Read(array_start_idx=start, count=count) == expected(start, count)
+
+    # Update a tile that is in the cache, but not the current one
+    assert ar.Write(b"\xff\x7f", array_start_idx=[1, 2], count=[1, 1]) == gdal.CE_None
+    data[1 * dim1_size + 2] = 0x7FFF
+    assert ar.Read(array_start_idx=[25, 25], count=[5, 5]) == expected([25, 25], [5, 5])
+    assert ar.Read(array_start_idx=[0, 0], count=[5, 5]) == expected([0, 0], [5, 5])
+    assert ar.Read() == data
+    ds = None
+
+    # Data must be identical after reopening
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar = ds.GetRootGroup().OpenMDArray("test")
+    assert ar.Read(array_start_idx=[0, 0], count=[5, 5]) == expected([0, 0], [5, 5])
+    assert ar.Read() == data
+
+
 def test_zarr_read_invalid_nczarr_dim():
 
     try:
@@ -1034,6 +1034,51 @@ def test_gdal_grid_lib_skip_nan_zvalue():
     )
 
 
+###############################################################################
+# Test that the quadtree accelerated searches give the same result as the
+# exhaustive search
+
+
+@pytest.mark.parametrize(
+    "algorithm",
+    [
+        "nearest",
+        "nearest:angle=30",
+        "linear:radius=-1",
+        "average:radius1=15:radius2=8:angle=30",
+    ],
+)
+def test_gdal_grid_lib_quadtree_same_as_exhaustive(algorithm):
+
+    wkt = "MULTIPOINT("
+    for i in range(400):
+        if i > 0:
+            wkt += ","
+        wkt += "%d %d %d" % ((i * 37) % 101, (i * 53) % 89, i)
+    wkt += ")"
+    geom = ogr.CreateGeometryFromWkt(wkt)
+
+    def grid():
+        data = gdal.Grid(
+            "",
+            geom.ExportToJson(),
+            width=50,
+            height=40,
+            outputBounds=[-20, -20, 120, 110],
+            format="MEM",
+            outputType=gdal.GDT_Float64,
+            algorithm=algorithm,
+        ).ReadRaster()
+        return struct.unpack("d" * (50 * 40), data)
+
+    with gdaltest.config_option("GDAL_GRID_POINT_COUNT_THRESHOLD", "1000000"):
+        expected = grid()
+    with gdaltest.config_option("GDAL_GRID_POINT_COUNT_THRESHOLD", "10"):
+        got = grid()
+    # Averages may differ by rounding, as points are summed in another order
+    assert got == pytest.approx(expected, rel=1e-12)
+
+
 ###############################################################################
 # Test option argument handling
 
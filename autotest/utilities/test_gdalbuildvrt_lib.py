@@ -748,3 +748,58 @@ def test_gdalbuildvrt_lib_stable_average():
     vrt_gt = vrt_ds.GetGeoTransform()
 
     assert vrt_gt == gt
+
+
+###############################################################################
+# Test opening input datasets with several threads
+
+
+def test_gdalbuildvrt_lib_num_threads(tmp_vsimem):
+
+    src_ds = gdal.Open("../gcore/data/rgbsmall.tif")
+    filenames = []
+    for j in range(5):
+        for i in range(5):
+            filename = str(tmp_vsimem / ("tile_%d_%d.tif" % (i, j)))
+            gdal.Translate(
+                filename, src_ds, options="-srcwin %d %d 10 10" % (i * 10, j * 10)
+            )
+            filenames.append(filename)
+    # Inputs skipped with a warning: heterogeneous projection, not
+    # georeferenced, and not existing
+    filenames.insert(3, "../gcore/data/byte.tif")
+    ungeoref_filename = str(tmp_vsimem / "ungeoref.tif")
+    gdal.GetDriverByName("GTiff").Create(ungeoref_filename, 1, 1, 3)
+    filenames.insert(7, ungeoref_filename)
+    filenames.insert(11, "i_dont_exist.tif")
+
+    def build(num_threads):
+        errors = []
+
+        def handler(err_level, err_no, err_msg):
+            errors.append((err_level, err_msg))
+
+        vrt_filename = str(tmp_vsimem / ("out_%d.vrt" % num_threads))
+        with gdaltest.error_handler(handler):
+            ds = gdal.BuildVRT(
+                vrt_filename, filenames, options="-num_threads %d" % num_threads
+            )
+            ds = None
+        f = gdal.VSIFOpenL(vrt_filename, "rb")
+        content = gdal.VSIFReadL(1, 1000000, f)
+        gdal.VSIFCloseL(f)
+        return content, errors
+
+    ref_vrt, ref_errors = build(1)
+    vrt, errors = build(4)
+    assert vrt == ref_vrt
+    assert errors == ref_errors
+    assert len(errors) >= 3
+
+    with gdaltest.error_handler():
+        ds = gdal.BuildVRT("", filenames, options="-num_threads 4")
+    assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+
+    with gdal.ExceptionMgr():
+        with pytest.raises(Exception):
+            gdal.BuildVRT("", filenames, options="-num_threads 4 -strict")
@@ -31,6 +31,7 @@
 
 
 import pathlib
+import struct
 
 import gdaltest
 import pytest
@@ -263,3 +264,38 @@ def test_gdalinfo_lib_json_projjson_no_epsg():
     ret = gdal.Info(ds, options="-json")
     assert ret["stac"]["proj:epsg"] is None
     assert ret["stac"]["proj:wkt2"] is not None
+
+
+###############################################################################
+# Test -hash
+
+
+@pytest.mark.parametrize("num_threads", ["1", "ALL_CPUS"])
+def test_gdalinfo_lib_hash(tmp_vsimem, num_threads):
+    def get_hash(ds):
+        return gdal.Info(ds, format="json", computeHash=True)["bands"][0]["hash"]
+
+    src_ds = gdal.Open("../gcore/data/uint16.tif")
+
+    ref_hash = get_hash(src_ds)
+    assert len(ref_hash) == 64
+
+    # The hash does not depend on the block organization or compression
+    for options in [
+        [],
+        ["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+        ["COMPRESS=DEFLATE", "BLOCKYSIZE=3"],
+    ]:
+        filename = str(tmp_vsimem / "test.tif")
+        gdal.Translate(filename, src_ds, creationOptions=options)
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ret = gdal.Info(filename, options="-hash")
+        assert ("Hash=" + ref_hash) in ret, options
+
+    # But it does depend on the data type and values
+    ds = gdal.Translate("", src_ds, format="MEM", outputType=gdal.GDT_Int32)
+    assert get_hash(ds) != ref_hash
+    ds = gdal.Translate("", src_ds, format="MEM")
+    val = struct.unpack("H", ds.GetRasterBand(1).ReadRaster(0, 0, 1, 1))[0]
+    ds.GetRasterBand(1).WriteRaster(0, 0, 1, 1, struct.pack("H", val + 1))
+    assert get_hash(ds) != ref_hash
@@ -943,3 +943,56 @@ def test_gdalmdimtranslate_dict_arguments():
     co_idx = opt.index("-co")
 
     assert opt[co_idx : co_idx + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that the destination chunking matches the source one, and -num_threads
+
+
+@pytest.mark.require_driver("ZARR")
+@pytest.mark.parametrize("num_threads", [None, "2"])
+def test_gdalmdimtranslate_match_source_chunking(tmp_vsimem, num_threads):
+
+    src_filename = str(tmp_vsimem / "src.zarr")
+    src_ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(src_filename)
+    rg = src_ds.GetRootGroup()
+    dim0 = rg.CreateDimension("dim0", None, None, 100)
+    dim1 = rg.CreateDimension("dim1", None, None, 200)
+    ar = rg.CreateMDArray(
+        "test",
+        [dim0, dim1],
+        gdal.ExtendedDataType.Create(gdal.GDT_Int16),
+        ["BLOCKSIZE=64,64"],
+    )
+    data = struct.pack("<20000h", *[i % 30000 for i in range(20000)])
+    assert ar.Write(data) == gdal.CE_None
+    src_ds = None
+
+    options = ["-num_threads", num_threads] if num_threads else []
+    with gdal.config_option("GDAL_SWATH_SIZE", "20000"):
+        out_ds = gdal.MultiDimTranslate(
+            tmp_vsimem / "out.zarr", src_filename, format="ZARR", options=list(options)
+        )
+    out_ar = out_ds.GetRootGroup().OpenMDArray("test")
+    assert out_ar.GetBlockSize() == [64, 64]
+    assert out_ar.Read() == data
+    out_ds = None
+
+    # Chunking explicitly set by the user
+    out_ds = gdal.MultiDimTranslate(
+        tmp_vsimem / "out2.zarr",
+        src_filename,
+        format="ZARR",
+        creationOptions=["ARRAY:BLOCKSIZE=50,50"],
+        options=list(options),
+    )
+    out_ar = out_ds.GetRootGroup().OpenMDArray("test")
+    assert out_ar.GetBlockSize() == [50, 50]
+    assert out_ar.Read() == data
+
+
+def test_gdalmdimtranslate_invalid_num_threads():
+
+    with pytest.raises(Exception, match="Invalid value for -num_threads"):
+        with gdaltest.enable_exceptions():
+            gdal.MultiDimTranslate("", "data/mdim.vrt", options="-num_threads 0")
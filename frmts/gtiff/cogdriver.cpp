@@ -70,13 +70,26 @@ static bool HasZSTDCompression()
 /*                           GetTmpFilename()                           */
 /************************************************************************/
 
-static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
+// If the estimated size of the temporary file fits in the remaining
+// nInMemoryBudget, the file is created in /vsimem/ and the budget is
+// decreased accordingly.
+static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt,
+                                double dfEstimatedSize,
+                                GIntBig &nInMemoryBudget)
 {
     const bool bSupportsRandomWrite =
         VSISupportsRandomWrite(pszFilename, false);
     CPLString osTmpFilename;
-    if (!bSupportsRandomWrite ||
-        CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
+    if (dfEstimatedSize <= static_cast<double>(nInMemoryBudget))
+    {
+        nInMemoryBudget -= static_cast<GIntBig>(dfEstimatedSize);
+        osTmpFilename = "/vsimem/";
+        osTmpFilename += CPLGetFilename(
+            CPLGenerateTempFilename(CPLGetBasename(pszFilename)));
+        CPLDebug("COG", "Using in-memory %s temporary file", pszExt);
+    }
+    else if (!bSupportsRandomWrite ||
+             CPLGetConfigOption("CPL_TMPDIR", nullptr) != nullptr)
     {
         osTmpFilename = CPLGenerateTempFilename(CPLGetBasename(pszFilename));
     }
@@ -88,6 +101,18 @@ static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
     return osTmpFilename;
 }
 
+/************************************************************************/
+/*                      GetTmpInMemoryBudget()                          */
+/************************************************************************/
+
+// Maximum cumulated size of temporary files that can be kept in memory.
+static GIntBig GetTmpInMemoryBudget()
+{
+    const char *pszMaxSize =
+        CPLGetConfigOption("COG_TMP_IN_MEMORY_MAX_SIZE", nullptr);
+    return pszMaxSize ? CPLAtoGIntBig(pszMaxSize) : GDALGetCacheMax64();
+}
+
 /************************************************************************/
 /*                             GetResampling()                          */
 /************************************************************************/
@@ -591,7 +616,8 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     const CPLString &osTargetSRS, const int nXSize, const int nYSize,
     const double dfMinX, const double dfMinY, const double dfMaxX,
     const double dfMaxY, const double dfRes, GDALProgressFunc pfnProgress,
-    void *pProgressData, double &dfCurPixels, double &dfTotalPixelsToProcess)
+    void *pProgressData, double &dfCurPixels, double &dfTotalPixelsToProcess,
+    GIntBig &nTmpInMemoryBudget)
 {
     char **papszArg = nullptr;
     // We could have done a warped VRT, but overview building on it might be
@@ -689,7 +715,12 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     CPLDebug("COG", "Reprojecting source dataset: start");
     GDALWarpAppOptionsSetProgress(psOptions, GDALScaledProgress,
                                   pScaledProgress);
-    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp"));
+    // Uncompressed size, with a potential alpha band
+    const double dfEstimatedSize =
+        double(nXSize) * nYSize * (nBands + 1) *
+        GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType());
+    CPLString osTmpFile(GetTmpFilename(pszDstFilename, "warped.tif.tmp",
+                                       dfEstimatedSize, nTmpInMemoryBudget));
     auto hSrcDS = GDALDataset::ToHandle(poSrcDS);
 
     std::unique_ptr<CPLConfigOptionSetter> poWarpThreadSetter;
@@ -719,6 +750,7 @@ struct GDALCOGCreator final
     std::unique_ptr<GDALDataset> m_poVRTWithOrWithoutStats{};
     CPLString m_osTmpOverviewFilename{};
     CPLString m_osTmpMskOverviewFilename{};
+    GIntBig m_nTmpInMemoryBudget = GetTmpInMemoryBudget();
 
     ~GDALCOGCreator();
 
@@ -874,7 +906,8 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
                 pszFilename, poCurDS, papszOptions, osTargetResampling,
                 osTargetSRS, nTargetXSize, nTargetYSize, dfTargetMinX,
                 dfTargetMinY, dfTargetMaxX, dfTargetMaxY, dfRes, pfnProgress,
-                pProgressData, dfCurPixels, dfTotalPixelsToProcess);
+                pProgressData, dfCurPixels, dfTotalPixelsToProcess,
+                m_nTmpInMemoryBudget);
             if (!m_poReprojectedDS)
                 return nullptr;
             poCurDS = m_poReprojectedDS.get();
@@ -1121,7 +1154,12 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateMskOvr)
     {
         CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        double dfEstimatedSize = 0;
+        for (const auto &oDim : asOverviewDims)
+            dfEstimatedSize += double(oDim.first) * oDim.second;
+        m_osTmpMskOverviewFilename =
+            GetTmpFilename(pszFilename, "msk.ovr.tmp", dfEstimatedSize,
+                           m_nTmpInMemoryBudget);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
         const char *pszResampling = CSLFetchNameValueDef(
             papszOptions, "OVERVIEW_RESAMPLING",
@@ -1151,7 +1189,13 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateOvr)
     {
         CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        double dfEstimatedSize = 0;
+        for (const auto &oDim : asOverviewDims)
+            dfEstimatedSize += double(oDim.first) * oDim.second;
+        dfEstimatedSize *=
+            nBands * GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType());
+        m_osTmpOverviewFilename = GetTmpFilename(
+            pszFilename, "ovr.tmp", dfEstimatedSize, m_nTmpInMemoryBudget);
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
@@ -1574,6 +1574,10 @@ void GDALRegister_GTiff()
         "   <Option name='IGNORE_COG_LAYOUT_BREAK' type='boolean' "
         "description='Allow update mode on files with COG structure' "
         "default='FALSE'/>"
+        "   <Option name='REUSE_FREED_SPACE' type='boolean' "
+        "description='Whether rewritten blocks can be written in space freed "
+        "by previously rewritten blocks, rather than at end of file' "
+        "default='FALSE'/>"
         "</OpenOptionList>");
     poDriver->SetMetadataItem(GDAL_DMD_SUBDATASETS, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
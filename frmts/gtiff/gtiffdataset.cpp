@@ -200,6 +200,11 @@ std::tuple<CPLErr, bool> GTiffDataset::Finalize()
         CPLVirtualMemFree(m_psVirtualMemIOMapping);
     m_psVirtualMemIOMapping = nullptr;
 
+    // Views returned by GetBlockVirtualMem() hold their own reference.
+    if (m_psBlockViewMapping)
+        CPLVirtualMemFree(m_psBlockViewMapping);
+    m_psBlockViewMapping = nullptr;
+
     /* -------------------------------------------------------------------- */
     /*      Fill in missing blocks with empty data.                         */
     /* -------------------------------------------------------------------- */
@@ -517,6 +522,21 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             bCanUseMultiThreadedRead = true;
         }
     }
+    else if (eRWFlag == GF_Read &&
+             (nXSize != nBufXSize || nYSize != nBufYSize))
+    {
+        // Resampled requests go through the block cache: decode the
+        // blocks in parallel beforehand.
+        CacheBlocksMultiThreaded(nXOff, nYOff, nXSize, nYSize, nBandCount,
+                                 panBandMap);
+    }
+
+    // Blocks to fetch in advance in case of sequential access pattern
+    std::vector<std::pair<int, int>> aoReadAheadBlocks;
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        aoReadAheadBlocks = GetReadAheadBlocks(nXOff, nYOff, nXSize, nYSize);
+    }
 
     void *pBufferedData = nullptr;
     const auto poFirstBand = cpl::down_cast<GTiffRasterBand *>(papoBands[0]);
@@ -529,10 +549,17 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
           VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF))->HasPRead()))
     {
         pBufferedData = poFirstBand->CacheMultiRange(
-            nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize, psExtraArg);
+            nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize, psExtraArg,
+            &aoReadAheadBlocks);
     }
     else if (bCanUseMultiThreadedRead)
     {
+        // Decode the read ahead blocks in the same parallel pass
+        if (!aoReadAheadBlocks.empty())
+        {
+            CacheBlocksMultiThreaded(nXOff, nYOff, nXSize, nYSize, nBandCount,
+                                     panBandMap, &aoReadAheadBlocks);
+        }
         return MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, pData, eBufType,
                                  nBandCount, panBandMap, nPixelSpace,
                                  nLineSpace, nBandSpace);
@@ -696,6 +723,8 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     if (pBufferedData)
     {
+        if (eErr == CE_None)
+            LoadReadAheadBlocks(aoReadAheadBlocks, nBandCount, panBandMap);
         VSIFree(pBufferedData);
         VSI_TIFFSetCachedRanges(TIFFClientdata(m_hTIFF), 0, nullptr, nullptr,
                                 nullptr);
@@ -32,7 +32,11 @@
 
 #include "gdal_pam.h"
 
+#include <map>
 #include <queue>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "cpl_mem_cache.h"
 #include "cpl_worker_thread_pool.h"  // CPLJobQueue, CPLWorkerThreadPool
@@ -162,6 +166,7 @@ class GTiffDataset final : public GDALPamDataset
     CPLVirtualMem *m_pBaseMapping = nullptr;
     GByte *m_pTempBufferForCommonDirectIO = nullptr;
     CPLVirtualMem *m_psVirtualMemIOMapping = nullptr;
+    CPLVirtualMem *m_psBlockViewMapping = nullptr;
     CPLWorkerThreadPool *m_poThreadPool = nullptr;
     std::unique_ptr<CPLJobQueue> m_poCompressQueue{};
     CPLMutex *m_hCompressThreadPoolMutex = nullptr;
@@ -169,6 +174,16 @@ class GTiffDataset final : public GDALPamDataset
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>>
         m_oCacheStrileToOffsetByteCount{1024};
 
+    // Extents of the file no longer referenced by any strile, that can be
+    // reused when REUSE_FREED_SPACE=YES. Only used on the root dataset.
+    std::map<vsi_l_offset, vsi_l_offset> m_oMapFreeExtents{};  // offset->size
+    std::set<std::pair<vsi_l_offset, vsi_l_offset>>
+        m_oSetFreeExtentsBySize{};  // (size, offset)
+    // Number of striles of this IFD whose data starts at a given offset, as
+    // some writers share the data of identical striles. Built on the first
+    // strile write when REUSE_FREED_SPACE=YES.
+    std::map<vsi_l_offset, int> m_oMapStrileOffsetRefCount{};
+
     MaskOffset *m_panMaskOffsetLsb = nullptr;
     char *m_pszVertUnit = nullptr;
     char *m_pszFilename = nullptr;
@@ -204,6 +219,13 @@ class GTiffDataset final : public GDALPamDataset
     int m_nRefBaseMapping = 0;
     int m_nGCPCount = 0;
     int m_nDisableMultiThreadedRead = 0;
+    int m_nReadAheadBlocks = -1;  // Lazily initialized
+    // Range of blocks of the last read request, used to detect sequential
+    // access patterns.
+    int m_nLastReadBlockX1 = -1;
+    int m_nLastReadBlockY1 = -1;
+    int m_nLastReadBlockX2 = -1;
+    int m_nLastReadBlockY2 = -1;
 
     GTIFFKeysFlavorEnum m_eGeoTIFFKeysFlavor = GEOTIFF_KEYS_STANDARD;
     GeoTIFFVersionEnum m_eGeoTIFFVersion = GEOTIFF_VERSION_AUTO;
@@ -262,6 +284,9 @@ class GTiffDataset final : public GDALPamDataset
     bool m_bStreamingOut : 1;
     bool m_bScanDeferred : 1;
     bool m_bSingleIFDOpened = false;
+    bool m_bReuseFreedSpace = false;
+    bool m_bStrileOffsetRefCountBuilt = false;
+    bool m_bBlockViewMappingTried = false;
     bool m_bLoadedBlockDirty : 1;
     bool m_bWriteError : 1;
     bool m_bLookedForProjection : 1;
@@ -372,10 +397,20 @@ class GTiffDataset final : public GDALPamDataset
     void DiscardLsb(GByte *pabyBuffer, GPtrDiff_t nBytes, int iBand) const;
     void GetDiscardLsbOption(char **papszOptions);
     void InitCompressionThreads(bool bUpdateMode, CSLConstList papszOptions);
+    void CreateCompressionQueue(CPLWorkerThreadPool *poThreadPool,
+                                int nThreads);
+    void InitCompressionThreadsForOverviews(CSLConstList papszOptions);
     void InitCreationOrOpenOptions(bool bUpdateMode, CSLConstList papszOptions);
     static void ThreadCompressionFunc(void *pData);
     void WaitCompletionForJobIdx(int i);
     void WaitCompletionForBlock(int nBlockId);
+    void AddFreeExtent(vsi_l_offset nOffset, vsi_l_offset nSize);
+    bool TakeFreeExtent(vsi_l_offset nSize, vsi_l_offset &nOffset);
+    void BuildStrileOffsetRefCount(const toff_t *panOffsets);
+    bool PlaceStripOrTileInFreeExtent(int nStripOrTile, const GByte *pabyData,
+                                      vsi_l_offset nSize,
+                                      const toff_t *panOffsets,
+                                      const toff_t *panByteCounts);
     void WriteRawStripOrTile(int nStripOrTile, GByte *pabyCompressedBuffer,
                              GPtrDiff_t nCompressedBufferSize);
     bool SubmitCompressionJob(int nStripOrTile, GByte *pabyData, GPtrDiff_t cc,
@@ -400,6 +435,8 @@ class GTiffDataset final : public GDALPamDataset
                      GSpacing nPixelSpace, GSpacing nLineSpace,
                      GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg);
 
+    CPLVirtualMem *GetBlockViewMapping();
+
     void SetStructuralMDFromParent(GTiffDataset *poParentDS);
 
     template <class FetchBuffer>
@@ -432,9 +469,19 @@ class GTiffDataset final : public GDALPamDataset
     static CPLErr CopyImageryAndMask(GTiffDataset *poDstDS,
                                      GDALDataset *poSrcDS,
                                      GDALRasterBand *poSrcMaskBand,
+                                     GTiffDataset *poSrcRawDS,
                                      GDALProgressFunc pfnProgress,
                                      void *pProgressData);
 
+    static GTiffDataset *GetRawCopySource(GTiffDataset *poDstDS,
+                                          GDALDataset *poSrcDS,
+                                          GDALRasterBand *poSrcBand);
+    CPLErr CopyRawStripOrTile(GTiffDataset *poSrcDS, int nStripOrTile,
+                              std::vector<GByte> &abyBuffer, bool &bCopied);
+    CPLErr CopyRawStripsOrTiles(GTiffDataset *poSrcDS,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressData);
+
     bool GetOverviewParameters(int &nCompression, uint16_t &nPlanarConfig,
                                uint16_t &nPredictor, uint16_t &nPhotometric,
                                int &nOvrJpegQuality, std::string &osNoData,
@@ -474,6 +521,16 @@ class GTiffDataset final : public GDALPamDataset
                              void *pData, GDALDataType eBufType, int nBandCount,
                              const int *panBandMap, GSpacing nPixelSpace,
                              GSpacing nLineSpace, GSpacing nBandSpace);
+    void CacheBlocksMultiThreaded(
+        int nXOff, int nYOff, int nXSize, int nYSize, int nBandCount,
+        const int *panBandMap,
+        const std::vector<std::pair<int, int>> *paoReadAheadBlocks = nullptr);
+    std::vector<std::pair<int, int>> GetReadAheadBlocks(int nXOff, int nYOff,
+                                                        int nXSize,
+                                                        int nYSize);
+    void LoadReadAheadBlocks(
+        const std::vector<std::pair<int, int>> &aoReadAheadBlocks,
+        int nBandCount, const int *panBandMap);
 
     virtual CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              int nXSize, int nYSize, void *pData, int nBufXSize,
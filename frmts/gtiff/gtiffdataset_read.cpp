@@ -494,6 +494,10 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
 
     if (psJob->nSize == 0)
     {
+        // Nothing to decode. In cache-only mode, leave the initialization
+        // of sparse blocks to IReadBlock()
+        if (psContext->pabyData == nullptr)
+            return;
         {
             std::lock_guard<std::mutex> oLock(psContext->oMutex);
             if (!psContext->bSuccess)
@@ -690,9 +694,11 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
     }
 
     const int nDTSize = GDALGetDataTypeSizeBytes(psContext->eDT);
-    GByte *pDstPtr = psContext->pabyData +
-                     nYOffsetInData * psContext->nLineSpace +
-                     nXOffsetInData * psContext->nPixelSpace;
+    GByte *pDstPtr = psContext->pabyData
+                         ? psContext->pabyData +
+                               nYOffsetInData * psContext->nLineSpace +
+                               nXOffsetInData * psContext->nPixelSpace
+                         : nullptr;
 
     if (nAlreadyLoadedBlocks != nBandsToCache)
     {
@@ -849,6 +855,10 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
             }
         }
 
+        // Cache-only mode: we are done
+        if (pDstPtr == nullptr)
+            return;
+
         const GByte *pSrcPtr =
             pabyOutput +
             (static_cast<size_t>(nYOffsetInBlock) * poDS->m_nBlockXSize +
@@ -929,6 +939,10 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
 
     CPLAssert(!psContext->bSkipBlockCache);
 
+    // Cache-only mode: we are done
+    if (pDstPtr == nullptr)
+        return;
+
     // Compose cached blocks into final buffer
     for (int i = 0; i < nBandsToWrite; ++i)
     {
@@ -979,10 +993,189 @@ bool GTiffDataset::IsMultiThreadedReadCompatible() const
             m_nCompression == COMPRESSION_JPEG);
 }
 
+/************************************************************************/
+/*                      CacheBlocksMultiThreaded()                      */
+/************************************************************************/
+
+// Decode in parallel, into the block cache, the blocks intersecting a window
+// that is going to be read through the generic block based code path, for
+// example because of resampling. This is only an optimization: any failure
+// is silently ignored, and will be reported by the generic code path.
+void GTiffDataset::CacheBlocksMultiThreaded(
+    int nXOff, int nYOff, int nXSize, int nYSize, int nBandCount,
+    const int *panBandMap,
+    const std::vector<std::pair<int, int>> *paoReadAheadBlocks)
+{
+    if (m_nDisableMultiThreadedRead != 0 || m_poThreadPool == nullptr ||
+        m_bDirectIO || m_eVirtualMemIOUsage != VirtualMemIOEnum::NO ||
+        !IsMultiThreadedReadCompatible())
+    {
+        return;
+    }
+
+    // When the file does not support pread(), CacheMultiRange() is the
+    // preferred strategy
+    if (HasOptimizedReadMultiRange() &&
+        !VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF))->HasPRead())
+    {
+        return;
+    }
+
+    // Extend the window to the read ahead blocks (which are ordered by
+    // increasing distance to it)
+    if (paoReadAheadBlocks && !paoReadAheadBlocks->empty())
+    {
+        const auto &oLastBlock = paoReadAheadBlocks->back();
+        const int nLastBlockXEnd = (oLastBlock.first + 1) * m_nBlockXSize;
+        const int nLastBlockYEnd = (oLastBlock.second + 1) * m_nBlockYSize;
+        const int nXEnd =
+            std::min(nRasterXSize, std::max(nXOff + nXSize, nLastBlockXEnd));
+        const int nYEnd =
+            std::min(nRasterYSize, std::max(nYOff + nYSize, nLastBlockYEnd));
+        nXSize = nXEnd - nXOff;
+        nYSize = nYEnd - nYOff;
+    }
+
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nXBlocks = nBlockX2 - nBlockX1 + 1;
+    const int nYBlocks = nBlockY2 - nBlockY1 + 1;
+    if (nXBlocks * nYBlocks <= 1 &&
+        (m_nPlanarConfig == PLANARCONFIG_CONTIG || nBandCount == 1))
+    {
+        return;
+    }
+
+    // Do not bother if the decoded blocks would not fit in the block cache
+    const GIntBig nRequiredMem =
+        static_cast<GIntBig>(
+            m_nPlanarConfig == PLANARCONFIG_CONTIG ? nBands : nBandCount) *
+        nXBlocks * nYBlocks * m_nBlockXSize * m_nBlockYSize *
+        GDALGetDataTypeSizeBytes(GetRasterBand(1)->GetRasterDataType());
+    if (nRequiredMem > GDALGetCacheMax64())
+        return;
+
+    CPLErrorStateBackuper oErrorStateBackuper;
+    CPLErrorHandlerPusher oErrorHandlerPusher(CPLQuietErrorHandler);
+    if (MultiThreadedRead(nXOff, nYOff, nXSize, nYSize, nullptr,
+                          GetRasterBand(1)->GetRasterDataType(), nBandCount,
+                          panBandMap, 0, 0, 0) != CE_None)
+    {
+        // Evict blocks that might have been partially decoded
+        for (int iBand = 1; iBand <= nBands; ++iBand)
+        {
+            for (int y = nBlockY1; y <= nBlockY2; ++y)
+            {
+                for (int x = nBlockX1; x <= nBlockX2; ++x)
+                {
+                    GetRasterBand(iBand)->FlushBlock(x, y);
+                }
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                         GetReadAheadBlocks()                         */
+/************************************************************************/
+
+// Detects sequential access patterns between successive read requests: a
+// window that follows the previous one on the same block rows (tile by tile
+// scanning), or on the same block columns (row by row scanning). In that
+// case, returns the coordinates of the next GTIFF_READAHEAD_BLOCKS block
+// columns or rows, closest ones first. This is only done on read-only files
+// for which multi-range reading is optimized, typically network files.
+std::vector<std::pair<int, int>>
+GTiffDataset::GetReadAheadBlocks(int nXOff, int nYOff, int nXSize, int nYSize)
+{
+    std::vector<std::pair<int, int>> aoBlocks;
+
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const bool bHorizontalAdvance = nBlockY1 == m_nLastReadBlockY1 &&
+                                    nBlockY2 == m_nLastReadBlockY2 &&
+                                    nBlockX1 == m_nLastReadBlockX2 + 1;
+    const bool bVerticalAdvance = nBlockX1 == m_nLastReadBlockX1 &&
+                                  nBlockX2 == m_nLastReadBlockX2 &&
+                                  nBlockY1 == m_nLastReadBlockY2 + 1;
+    m_nLastReadBlockX1 = nBlockX1;
+    m_nLastReadBlockY1 = nBlockY1;
+    m_nLastReadBlockX2 = nBlockX2;
+    m_nLastReadBlockY2 = nBlockY2;
+
+    if ((!bHorizontalAdvance && !bVerticalAdvance) || eAccess != GA_ReadOnly ||
+        m_bStreamingIn || !HasOptimizedReadMultiRange())
+    {
+        return aoBlocks;
+    }
+
+    if (m_nReadAheadBlocks < 0)
+    {
+        m_nReadAheadBlocks = std::max(
+            0, atoi(CPLGetConfigOption("GTIFF_READAHEAD_BLOCKS", "1")));
+    }
+
+    if (bHorizontalAdvance)
+    {
+        const int nLastX =
+            std::min(m_nBlocksPerRow - 1, nBlockX2 + m_nReadAheadBlocks);
+        for (int iX = nBlockX2 + 1; iX <= nLastX; ++iX)
+        {
+            for (int iY = nBlockY1; iY <= nBlockY2; ++iY)
+                aoBlocks.emplace_back(iX, iY);
+        }
+    }
+    else
+    {
+        const int nLastY =
+            std::min(m_nBlocksPerColumn - 1, nBlockY2 + m_nReadAheadBlocks);
+        for (int iY = nBlockY2 + 1; iY <= nLastY; ++iY)
+        {
+            for (int iX = nBlockX1; iX <= nBlockX2; ++iX)
+                aoBlocks.emplace_back(iX, iY);
+        }
+    }
+    return aoBlocks;
+}
+
+/************************************************************************/
+/*                        LoadReadAheadBlocks()                         */
+/************************************************************************/
+
+// Loads in the block cache the read ahead blocks, whose raw data has been
+// fetched by CacheMultiRange() and is still available in the cached ranges.
+void GTiffDataset::LoadReadAheadBlocks(
+    const std::vector<std::pair<int, int>> &aoReadAheadBlocks, int nBandCount,
+    const int *panBandMap)
+{
+    if (aoReadAheadBlocks.empty())
+        return;
+
+    // Errors will be reported when the blocks are actually requested
+    CPLErrorStateBackuper oErrorStateBackuper;
+    CPLErrorHandlerPusher oErrorHandlerPusher(CPLQuietErrorHandler);
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        auto poBand = GetRasterBand(panBandMap[i]);
+        for (const auto &oBlock : aoReadAheadBlocks)
+        {
+            auto poBlock = poBand->GetLockedBlockRef(oBlock.first,
+                                                     oBlock.second);
+            if (poBlock)
+                poBlock->DropLock();
+        }
+    }
+}
+
 /************************************************************************/
 /*                        MultiThreadedRead()                           */
 /************************************************************************/
 
+// If pData is nullptr, blocks are only decoded into the block cache.
 CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                                        int nYSize, void *pData,
                                        GDALDataType eBufType, int nBandCount,
@@ -1040,7 +1233,11 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
     sContext.nPredictor = PREDICTOR_NONE;
     sContext.nBlocksPerRow = m_nBlocksPerRow;
 
-    if (m_bDirectIO)
+    if (pData == nullptr)
+    {
+        // Cache-only mode
+    }
+    else if (m_bDirectIO)
     {
         sContext.bSkipBlockCache = true;
     }
@@ -1065,7 +1262,8 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
         }
     }
 
-    if (m_nPlanarConfig == PLANARCONFIG_CONTIG && nBandCount == nBands &&
+    if (pData != nullptr && m_nPlanarConfig == PLANARCONFIG_CONTIG &&
+        nBandCount == nBands &&
         nPixelSpace == nBands * static_cast<GSpacing>(sContext.nBufDTSize))
     {
         sContext.bUseBIPOptim = true;
@@ -1196,6 +1394,11 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                 }
             }
         after_loop:
+            if (bUseBaseImplementation && pData == nullptr)
+            {
+                // Cache-only mode: let the caller use the block cache
+                return CE_None;
+            }
             if (bUseBaseImplementation)
             {
                 ++m_nDisableMultiThreadedRead;
@@ -1482,6 +1685,37 @@ class FetchBufferVirtualMemIO final
     static const bool bMinimizeIO = false;
 };
 
+/************************************************************************/
+/*                        GetBlockViewMapping()                         */
+/************************************************************************/
+
+// Returns a read-only mapping of the whole file, shared by the main dataset,
+// its overviews and masks, from which GetBlockVirtualMem() derives its views.
+
+CPLVirtualMem *GTiffDataset::GetBlockViewMapping()
+{
+    if (m_poBaseDS)
+        return m_poBaseDS->GetBlockViewMapping();
+
+    if (m_psBlockViewMapping == nullptr && !m_bBlockViewMappingTried)
+    {
+        m_bBlockViewMappingTried = true;
+        VSILFILE *fp = VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF));
+        if (!CPLIsVirtualMemFileMapAvailable() ||
+            VSIFGetNativeFileDescriptorL(fp) == nullptr ||
+            VSIFSeekL(fp, 0, SEEK_END) != 0)
+        {
+            return nullptr;
+        }
+        const vsi_l_offset nLength = VSIFTellL(fp);
+        if (static_cast<size_t>(nLength) != nLength)
+            return nullptr;
+        m_psBlockViewMapping = CPLVirtualMemFileMapNew(
+            fp, 0, nLength, VIRTUALMEM_READONLY, nullptr, nullptr);
+    }
+    return m_psBlockViewMapping;
+}
+
 /************************************************************************/
 /*                         VirtualMemIO()                               */
 /************************************************************************/
@@ -3899,6 +4133,20 @@ GDALDataset *GTiffDataset::Open(GDALOpenInfo *poOpenInfo)
     if (CPLFetchBool(poOpenInfo->papszOpenOptions, "SPARSE_OK", false))
         poDS->m_bWriteEmptyTiles = false;
 
+    // Should the space of rewritten blocks be reused?
+    poDS->m_bReuseFreedSpace =
+        poOpenInfo->eAccess == GA_Update &&
+        CPLFetchBool(poOpenInfo->papszOpenOptions, "REUSE_FREED_SPACE", false);
+#ifndef INTERNAL_LIBTIFF
+    if (poDS->m_bReuseFreedSpace)
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "REUSE_FREED_SPACE=YES is only supported when GDAL is built "
+                 "against its internal libtiff. Ignoring it");
+        poDS->m_bReuseFreedSpace = false;
+    }
+#endif
+
     poDS->InitCreationOrOpenOptions(poOpenInfo->eAccess == GA_Update,
                                     poOpenInfo->papszOpenOptions);
 
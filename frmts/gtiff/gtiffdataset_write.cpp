@@ -826,38 +826,7 @@ void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
 
                 m_poThreadPool = GDALGetGlobalThreadPool(nThreads);
                 if (bUpdateMode && m_poThreadPool)
-                    m_poCompressQueue = m_poThreadPool->CreateJobQueue();
-
-                if (m_poCompressQueue != nullptr)
-                {
-                    // Add a margin of an extra job w.r.t thread number
-                    // so as to optimize compression time (enables the main
-                    // thread to do boring I/O while all CPUs are working).
-                    m_asCompressionJobs.resize(nThreads + 1);
-                    memset(&m_asCompressionJobs[0], 0,
-                           m_asCompressionJobs.size() *
-                               sizeof(GTiffCompressionJob));
-                    for (int i = 0;
-                         i < static_cast<int>(m_asCompressionJobs.size()); ++i)
-                    {
-                        m_asCompressionJobs[i].pszTmpFilename =
-                            CPLStrdup(CPLSPrintf("/vsimem/gtiff/thread/job/%p",
-                                                 &m_asCompressionJobs[i]));
-                        m_asCompressionJobs[i].nStripOrTile = -1;
-                    }
-                    m_hCompressThreadPoolMutex = CPLCreateMutex();
-                    CPLReleaseMutex(m_hCompressThreadPoolMutex);
-
-                    // This is kind of a hack, but basically using
-                    // TIFFWriteRawStrip/Tile and then TIFFReadEncodedStrip/Tile
-                    // does not work on a newly created file, because
-                    // TIFF_MYBUFFER is not set in tif_flags
-                    // (if using TIFFWriteEncodedStrip/Tile first,
-                    // TIFFWriteBufferSetup() is automatically called).
-                    // This should likely rather fixed in libtiff itself.
-                    CPL_IGNORE_RET_VAL(
-                        TIFFWriteBufferSetup(m_hTIFF, nullptr, -1));
-                }
+                    CreateCompressionQueue(m_poThreadPool, nThreads);
             }
         }
         else if (nThreads < 0 ||
@@ -870,6 +839,75 @@ void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
     }
 }
 
+/************************************************************************/
+/*                       CreateCompressionQueue()                       */
+/************************************************************************/
+
+void GTiffDataset::CreateCompressionQueue(CPLWorkerThreadPool *poThreadPool,
+                                          int nThreads)
+{
+    CPLAssert(m_poCompressQueue == nullptr);
+
+    m_poCompressQueue = poThreadPool->CreateJobQueue();
+    if (m_poCompressQueue == nullptr)
+        return;
+
+    // Add a margin of an extra job w.r.t thread number
+    // so as to optimize compression time (enables the main
+    // thread to do boring I/O while all CPUs are working).
+    m_asCompressionJobs.resize(nThreads + 1);
+    memset(&m_asCompressionJobs[0], 0,
+           m_asCompressionJobs.size() * sizeof(GTiffCompressionJob));
+    for (int i = 0; i < static_cast<int>(m_asCompressionJobs.size()); ++i)
+    {
+        m_asCompressionJobs[i].pszTmpFilename = CPLStrdup(
+            CPLSPrintf("/vsimem/gtiff/thread/job/%p", &m_asCompressionJobs[i]));
+        m_asCompressionJobs[i].nStripOrTile = -1;
+    }
+    m_hCompressThreadPoolMutex = CPLCreateMutex();
+    CPLReleaseMutex(m_hCompressThreadPoolMutex);
+
+    // This is kind of a hack, but basically using
+    // TIFFWriteRawStrip/Tile and then TIFFReadEncodedStrip/Tile
+    // does not work on a newly created file, because
+    // TIFF_MYBUFFER is not set in tif_flags
+    // (if using TIFFWriteEncodedStrip/Tile first,
+    // TIFFWriteBufferSetup() is automatically called).
+    // This should likely rather fixed in libtiff itself.
+    CPL_IGNORE_RET_VAL(TIFFWriteBufferSetup(m_hTIFF, nullptr, -1));
+}
+
+/************************************************************************/
+/*                 InitCompressionThreadsForOverviews()                 */
+/************************************************************************/
+
+// Overview and mask datasets use the compression queue of the main dataset,
+// which has not been created at opening time if the full resolution image is
+// not compressed or made of a single block, or if NUM_THREADS is only passed
+// as a BuildOverviews() option.
+void GTiffDataset::InitCompressionThreadsForOverviews(CSLConstList papszOptions)
+{
+    if (m_poCompressQueue != nullptr || m_poBaseDS != nullptr)
+        return;
+
+    const char *pszValue = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszValue == nullptr)
+        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszValue == nullptr)
+        return;
+    const int nThreads = std::min(
+        1024, EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue));
+    if (nThreads <= 1)
+        return;
+
+    auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool == nullptr)
+        return;
+    CPLDebug("GTiff", "Using up to %d threads for overview compression",
+             nThreads);
+    CreateCompressionQueue(poThreadPool, nThreads);
+}
+
 /************************************************************************/
 /*                      ThreadCompressionFunc()                         */
 /************************************************************************/
@@ -965,6 +1003,152 @@ void GTiffDataset::ThreadCompressionFunc(void *pData)
     }
 }
 
+/************************************************************************/
+/*                           AddFreeExtent()                            */
+/************************************************************************/
+
+void GTiffDataset::AddFreeExtent(vsi_l_offset nOffset, vsi_l_offset nSize)
+{
+    CPLAssert(m_poBaseDS == nullptr);
+    if (nSize == 0)
+        return;
+
+    // Coalesce with the adjacent free extents
+    auto oIter = m_oMapFreeExtents.lower_bound(nOffset);
+    if (oIter != m_oMapFreeExtents.end() && nOffset + nSize == oIter->first)
+    {
+        nSize += oIter->second;
+        m_oSetFreeExtentsBySize.erase(
+            std::make_pair(oIter->second, oIter->first));
+        oIter = m_oMapFreeExtents.erase(oIter);
+    }
+    if (oIter != m_oMapFreeExtents.begin())
+    {
+        --oIter;
+        if (oIter->first + oIter->second == nOffset)
+        {
+            nOffset = oIter->first;
+            nSize += oIter->second;
+            m_oSetFreeExtentsBySize.erase(
+                std::make_pair(oIter->second, oIter->first));
+            m_oMapFreeExtents.erase(oIter);
+        }
+    }
+
+    m_oMapFreeExtents[nOffset] = nSize;
+    m_oSetFreeExtentsBySize.insert(std::make_pair(nSize, nOffset));
+}
+
+/************************************************************************/
+/*                           TakeFreeExtent()                           */
+/************************************************************************/
+
+// Reserves the smallest free extent of at least nSize bytes.
+bool GTiffDataset::TakeFreeExtent(vsi_l_offset nSize, vsi_l_offset &nOffset)
+{
+    CPLAssert(m_poBaseDS == nullptr);
+    const auto oIter =
+        m_oSetFreeExtentsBySize.lower_bound(std::make_pair(nSize, 0));
+    if (oIter == m_oSetFreeExtentsBySize.end())
+        return false;
+
+    const vsi_l_offset nExtentSize = oIter->first;
+    nOffset = oIter->second;
+    m_oSetFreeExtentsBySize.erase(oIter);
+    m_oMapFreeExtents.erase(nOffset);
+    if (nExtentSize > nSize)
+    {
+        m_oMapFreeExtents[nOffset + nSize] = nExtentSize - nSize;
+        m_oSetFreeExtentsBySize.insert(
+            std::make_pair(nExtentSize - nSize, nOffset + nSize));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     BuildStrileOffsetRefCount()                      */
+/************************************************************************/
+
+void GTiffDataset::BuildStrileOffsetRefCount(const toff_t *panOffsets)
+{
+    const int nStriles = TIFFIsTiled(m_hTIFF) ? TIFFNumberOfTiles(m_hTIFF)
+                                              : TIFFNumberOfStrips(m_hTIFF);
+    for (int i = 0; i < nStriles; ++i)
+    {
+        if (panOffsets[i] != 0)
+            ++m_oMapStrileOffsetRefCount[panOffsets[i]];
+    }
+    m_bStrileOffsetRefCountBuilt = true;
+}
+
+/************************************************************************/
+/*                   PlaceStripOrTileInFreeExtent()                     */
+/************************************************************************/
+
+// Called before a strile of nSize bytes is written, when REUSE_FREED_SPACE
+// is enabled. Registers the space that the strile is going to leave, and
+// writes it in a free extent when possible, in which case true is returned.
+// Otherwise, the strile must be written by libtiff, in place or at the end
+// of the file.
+bool GTiffDataset::PlaceStripOrTileInFreeExtent(int nStripOrTile,
+                                                const GByte *pabyData,
+                                                vsi_l_offset nSize,
+                                                const toff_t *panOffsets,
+                                                const toff_t *panByteCounts)
+{
+    GTiffDataset *poRootDS = m_poBaseDS ? m_poBaseDS : this;
+
+    if (!m_bStrileOffsetRefCountBuilt)
+        BuildStrileOffsetRefCount(panOffsets);
+
+    const vsi_l_offset nOldOffset = panOffsets[nStripOrTile];
+    const vsi_l_offset nOldSize = panByteCounts[nStripOrTile];
+    bool bOwnsOldExtent = false;
+    if (nOldOffset != 0)
+    {
+        // Some writers share the data of identical striles. Never free it.
+        auto oIter = m_oMapStrileOffsetRefCount.find(nOldOffset);
+        bOwnsOldExtent = nOldSize != 0 &&
+                         oIter != m_oMapStrileOffsetRefCount.end() &&
+                         oIter->second == 1;
+        if (nOldSize != 0 && nSize <= nOldSize)
+        {
+            // libtiff rewrites the strile in place: only its tail is freed
+            if (bOwnsOldExtent)
+                poRootDS->AddFreeExtent(nOldOffset + nSize, nOldSize - nSize);
+            return false;
+        }
+        if (oIter != m_oMapStrileOffsetRefCount.end() && --oIter->second == 0)
+            m_oMapStrileOffsetRefCount.erase(oIter);
+    }
+
+    // The old extent is freed first, so that it can be reused if it is
+    // adjacent to a free extent.
+    if (bOwnsOldExtent)
+        poRootDS->AddFreeExtent(nOldOffset, nOldSize);
+
+#ifdef INTERNAL_LIBTIFF
+    vsi_l_offset nNewOffset = 0;
+    if (!poRootDS->TakeFreeExtent(nSize, nNewOffset))
+        return false;
+
+    if (VSI_TIFFSeek(m_hTIFF, nNewOffset, SEEK_SET) != nNewOffset ||
+        !VSI_TIFFWrite(m_hTIFF, pabyData, static_cast<size_t>(nSize)) ||
+        !TIFFSetStrileOffsetAndByteCount(m_hTIFF, nStripOrTile, nNewOffset,
+                                         nSize))
+    {
+        m_bWriteError = true;
+    }
+    m_oCacheStrileToOffsetByteCount.remove(nStripOrTile);
+    ++m_oMapStrileOffsetRefCount[nNewOffset];
+    return true;
+#else
+    // Writing a strile at a given offset requires the internal libtiff
+    CPL_IGNORE_RET_VAL(pabyData);
+    return false;
+#endif
+}
+
 /************************************************************************/
 /*                        WriteRawStripOrTile()                         */
 /************************************************************************/
@@ -1063,6 +1247,32 @@ void GTiffDataset::WriteRawStripOrTile(int nStripOrTile,
             }
         }
     }
+    GTiffDataset *poRootDS = m_poBaseDS ? m_poBaseDS : this;
+    const bool bTrackFreedSpace =
+        poRootDS->m_bReuseFreedSpace && !bWriteLeader && !bWriteTrailer &&
+        panOffsets != nullptr &&
+        (panByteCounts != nullptr ||
+         (TIFFGetField(m_hTIFF,
+                       TIFFIsTiled(m_hTIFF) ? TIFFTAG_TILEBYTECOUNTS
+                                            : TIFFTAG_STRIPBYTECOUNTS,
+                       &panByteCounts) &&
+          panByteCounts != nullptr));
+    if (!bTrackFreedSpace && m_bStrileOffsetRefCountBuilt)
+    {
+        // The strile offsets will have to be counted again
+        m_oMapStrileOffsetRefCount.clear();
+        m_bStrileOffsetRefCountBuilt = false;
+    }
+    const vsi_l_offset nOldOffset =
+        bTrackFreedSpace ? panOffsets[nStripOrTile] : 0;
+    if (bTrackFreedSpace &&
+        PlaceStripOrTileInFreeExtent(nStripOrTile, pabyCompressedBuffer,
+                                     nCompressedBufferSize, panOffsets,
+                                     panByteCounts))
+    {
+        return;
+    }
+
     if (bWriteLeader &&
         static_cast<GUIntBig>(nCompressedBufferSize) <= 0xFFFFFFFFU)
     {
@@ -1117,6 +1327,13 @@ void GTiffDataset::WriteRawStripOrTile(int nStripOrTile,
         if (!VSI_TIFFWrite(m_hTIFF, abyLastBytes, 4))
             m_bWriteError = true;
     }
+    // Account for the location where libtiff has written the strile, unless
+    // it has been rewritten in place.
+    if (bTrackFreedSpace && panOffsets[nStripOrTile] != 0 &&
+        panOffsets[nStripOrTile] != nOldOffset)
+    {
+        ++m_oMapStrileOffsetRefCount[panOffsets[nStripOrTile]];
+    }
 }
 
 /************************************************************************/
@@ -1270,8 +1487,13 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
                                 m_nCompression == COMPRESSION_WEBP ||
                                 m_nCompression == COMPRESSION_JPEG))
     {
+        // When reusing freed space, the size of the compressed strile must
+        // be known before writing it, hence compress it ourselves.
+        const bool bReuseFreedSpace =
+            (m_poBaseDS ? m_poBaseDS : this)->m_bReuseFreedSpace &&
+            m_nCompression != COMPRESSION_NONE;
         if (m_bBlockOrderRowMajor || m_bLeaderSizeAsUInt4 ||
-            m_bTrailerRepeatedLast4BytesRepeated)
+            m_bTrailerRepeatedLast4BytesRepeated || bReuseFreedSpace)
         {
             GTiffCompressionJob sJob;
             memset(&sJob, 0, sizeof(sJob));
@@ -3030,6 +3252,19 @@ CPLErr GTiffDataset::IBuildOverviews(const char *pszResampling, int nOverviews,
         return CE_Failure;
     }
 
+    // Encode overview (and mask overview) blocks in worker threads
+    if (nCompression != COMPRESSION_NONE || m_poMaskDS != nullptr)
+        InitCompressionThreadsForOverviews(papszOptions);
+
+    // Resample in worker threads too, if NUM_THREADS is specified
+    std::unique_ptr<CPLConfigOptionSetter> poNumThreadsSetter;
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads)
+    {
+        poNumThreadsSetter.reset(new CPLConfigOptionSetter(
+            "GDAL_NUM_THREADS", pszNumThreads, false));
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Do we have a palette?  If so, create a TIFF compatible version. */
     /* -------------------------------------------------------------------- */
@@ -6293,6 +6528,200 @@ GDALDataset *GTiffDataset::Create(const char *pszFilename, int nXSize,
     return poDS;
 }
 
+/************************************************************************/
+/*                          GetRawCopySource()                          */
+/************************************************************************/
+
+// Returns the GTiff dataset that owns poSrcBand if its striles can be
+// copied verbatim into poDstDS, that is if they are already encoded the
+// way poDstDS would encode them. poSrcDS is the dataset poSrcBand comes from
+// (or whose overview it is). Returns nullptr otherwise.
+
+GTiffDataset *GTiffDataset::GetRawCopySource(GTiffDataset *poDstDS,
+                                             GDALDataset *poSrcDS,
+                                             GDALRasterBand *poSrcBand)
+{
+    if (!CPLTestBool(CPLGetConfigOption("GTIFF_COPY_RAW_BLOCKS", "YES")))
+        return nullptr;
+
+    auto poSrcRootDS = dynamic_cast<GTiffDataset *>(poSrcDS);
+    auto poSrcRawDS =
+        poSrcBand ? dynamic_cast<GTiffDataset *>(poSrcBand->GetDataset())
+                  : nullptr;
+    if (poSrcRootDS == nullptr || poSrcRawDS == nullptr ||
+        (poSrcRawDS != poSrcRootDS && poSrcRawDS->m_poBaseDS != poSrcRootDS))
+    {
+        return nullptr;
+    }
+
+    // Re-encoding JPEG striles is the job of gt_jpeg_copy.cpp
+    if (poDstDS->m_nCompression == COMPRESSION_NONE ||
+        poDstDS->m_nCompression == COMPRESSION_JPEG ||
+        poSrcRawDS->m_nCompression != poDstDS->m_nCompression)
+    {
+        return nullptr;
+    }
+
+    if (poSrcRootDS->GetAccess() != GA_ReadOnly || poSrcRawDS->m_bStreamingIn ||
+        poDstDS->m_bStreamingOut || poDstDS->m_panMaskOffsetLsb)
+    {
+        return nullptr;
+    }
+
+    if (poSrcRawDS->nRasterXSize != poDstDS->nRasterXSize ||
+        poSrcRawDS->nRasterYSize != poDstDS->nRasterYSize ||
+        poSrcRawDS->nBands != poDstDS->nBands ||
+        poSrcRawDS->m_nBlockXSize != poDstDS->m_nBlockXSize ||
+        poSrcRawDS->m_nBlockYSize != poDstDS->m_nBlockYSize ||
+        poSrcRawDS->m_nPlanarConfig != poDstDS->m_nPlanarConfig ||
+        poSrcRawDS->m_nBitsPerSample != poDstDS->m_nBitsPerSample ||
+        poSrcRawDS->m_nSampleFormat != poDstDS->m_nSampleFormat ||
+        poSrcRawDS->m_nPhotometric != poDstDS->m_nPhotometric ||
+        TIFFIsTiled(poSrcRawDS->m_hTIFF) != TIFFIsTiled(poDstDS->m_hTIFF) ||
+        TIFFIsByteSwapped(poSrcRawDS->m_hTIFF) !=
+            TIFFIsByteSwapped(poDstDS->m_hTIFF))
+    {
+        return nullptr;
+    }
+
+    uint16_t nSrcPredictor = PREDICTOR_NONE;
+    uint16_t nDstPredictor = PREDICTOR_NONE;
+    TIFFGetField(poSrcRawDS->m_hTIFF, TIFFTAG_PREDICTOR, &nSrcPredictor);
+    TIFFGetField(poDstDS->m_hTIFF, TIFFTAG_PREDICTOR, &nDstPredictor);
+    if (nSrcPredictor != nDstPredictor)
+        return nullptr;
+
+    if (poDstDS->m_nCompression == COMPRESSION_LERC &&
+        memcmp(poSrcRawDS->m_anLercAddCompressionAndVersion,
+               poDstDS->m_anLercAddCompressionAndVersion,
+               sizeof(poDstDS->m_anLercAddCompressionAndVersion)) != 0)
+    {
+        return nullptr;
+    }
+
+    // If the user explicitly asked for a given compression level or
+    // quality, honour it by re-encoding.
+    const GTiffDataset *poDstRootDS =
+        poDstDS->m_poBaseDS ? poDstDS->m_poBaseDS : poDstDS;
+    for (const char *pszKey :
+         {"ZLEVEL", "ZSTD_LEVEL", "LZMA_PRESET", "WEBP_LEVEL", "WEBP_LOSSLESS",
+          "JXL_LOSSLESS", "JXL_EFFORT", "JXL_DISTANCE", "JXL_ALPHA_DISTANCE",
+          "MAX_Z_ERROR", "DISCARD_LSB"})
+    {
+        if (CSLFetchNameValue(poDstRootDS->m_papszCreationOptions, pszKey))
+            return nullptr;
+        if (poDstDS->m_poBaseDS)
+        {
+            const std::string osOvrKey = std::string(pszKey) + "_OVERVIEW";
+            if (CSLFetchNameValue(poDstRootDS->m_papszCreationOptions,
+                                  osOvrKey.c_str()) ||
+                CPLGetConfigOption(osOvrKey.c_str(), nullptr))
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    CPLDebug("GTiff", "Copying compressed striles of %s without re-encoding",
+             poSrcRawDS->GetDescription());
+    return poSrcRawDS;
+}
+
+/************************************************************************/
+/*                         CopyRawStripOrTile()                         */
+/************************************************************************/
+
+// Copies the compressed bytes of a strile of poSrcDS into the same strile
+// of this dataset. bCopied is set to false if the source strile is sparse,
+// in which case it is up to the caller to write it.
+
+CPLErr GTiffDataset::CopyRawStripOrTile(GTiffDataset *poSrcDS,
+                                        int nStripOrTile,
+                                        std::vector<GByte> &abyBuffer,
+                                        bool &bCopied)
+{
+    bCopied = false;
+
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nSize = 0;
+    if (!poSrcDS->IsBlockAvailable(nStripOrTile, &nOffset, &nSize) ||
+        nSize == 0 ||
+        nSize > static_cast<vsi_l_offset>(std::numeric_limits<int>::max()))
+    {
+        return CE_None;
+    }
+
+    const auto nRawSize = static_cast<tmsize_t>(nSize);
+    try
+    {
+        abyBuffer.resize(static_cast<size_t>(nRawSize));
+    }
+    catch (const std::exception &)
+    {
+        ReportError(CE_Failure, CPLE_OutOfMemory,
+                    "Cannot allocate buffer for strile %d", nStripOrTile);
+        return CE_Failure;
+    }
+
+    const tmsize_t nRead =
+        TIFFIsTiled(poSrcDS->m_hTIFF)
+            ? TIFFReadRawTile(poSrcDS->m_hTIFF, nStripOrTile,
+                              abyBuffer.data(), nRawSize)
+            : TIFFReadRawStrip(poSrcDS->m_hTIFF, nStripOrTile,
+                               abyBuffer.data(), nRawSize);
+    if (nRead != nRawSize)
+    {
+        ReportError(CE_Failure, CPLE_FileIO, "Cannot read strile %d",
+                    nStripOrTile);
+        return CE_Failure;
+    }
+
+    // Striles still being compressed by worker threads must be written
+    // before this one, so that the block order is preserved.
+    auto &oQueue = m_poBaseDS ? m_poBaseDS->m_asQueueJobIdx : m_asQueueJobIdx;
+    while (!oQueue.empty())
+    {
+        WaitCompletionForJobIdx(oQueue.front());
+    }
+
+    WriteRawStripOrTile(nStripOrTile, abyBuffer.data(), nRawSize);
+    if (m_bWriteError)
+        return CE_Failure;
+
+    bCopied = true;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                        CopyRawStripsOrTiles()                        */
+/************************************************************************/
+
+CPLErr GTiffDataset::CopyRawStripsOrTiles(GTiffDataset *poSrcDS,
+                                          GDALProgressFunc pfnProgress,
+                                          void *pProgressData)
+{
+    const int nStriles =
+        m_nBlocksPerBand *
+        (m_nPlanarConfig == PLANARCONFIG_SEPARATE ? nBands : 1);
+    std::vector<GByte> abyBuffer;
+    for (int i = 0; i < nStriles; ++i)
+    {
+        // Sparse striles of the source are left sparse, and will be filled
+        // at closing if SPARSE_OK is not set.
+        bool bCopied = false;
+        if (CopyRawStripOrTile(poSrcDS, i, abyBuffer, bCopied) != CE_None)
+            return CE_Failure;
+
+        if (!pfnProgress(static_cast<double>(i + 1) / nStriles, nullptr,
+                         pProgressData))
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           CopyImageryAndMask()                       */
 /************************************************************************/
@@ -6300,6 +6729,7 @@ GDALDataset *GTiffDataset::Create(const char *pszFilename, int nXSize,
 CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
                                         GDALDataset *poSrcDS,
                                         GDALRasterBand *poSrcMaskBand,
+                                        GTiffDataset *poSrcRawDS,
                                         GDALProgressFunc pfnProgress,
                                         void *pProgressData)
 {
@@ -6324,6 +6754,8 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
     const bool bIsOddBand =
         dynamic_cast<GTiffOddBitsBand *>(poDstDS->GetRasterBand(1)) != nullptr;
 
+    std::vector<GByte> abyRawBuffer;
+
     if (poDstDS->m_poMaskDS)
     {
         CPLAssert(poDstDS->m_poMaskDS->m_nBlockXSize == poDstDS->m_nBlockXSize);
@@ -6353,73 +6785,84 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
                            poDstDS->m_nBlockYSize * l_nBands * nDataTypeSize);
             }
 
-            if (!bIsOddBand)
+            bool bCopied = false;
+            if (poSrcRawDS)
             {
-                eErr = poSrcDS->RasterIO(
-                    GF_Read, iX, iY, nReqXSize, nReqYSize, pBlockBuffer,
-                    nReqXSize, nReqYSize, eType, l_nBands, nullptr,
-                    static_cast<GSpacing>(nDataTypeSize) * l_nBands,
-                    static_cast<GSpacing>(nDataTypeSize) * l_nBands *
-                        poDstDS->m_nBlockXSize,
-                    nDataTypeSize, nullptr);
-                if (eErr == CE_None)
-                {
-                    eErr = poDstDS->WriteEncodedTileOrStrip(
-                        iBlock, pBlockBuffer, false);
-                }
+                eErr = poDstDS->CopyRawStripOrTile(poSrcRawDS, iBlock,
+                                                   abyRawBuffer, bCopied);
             }
-            else
+
+            // Decode and re-encode the strile if it was not copied verbatim
+            if (!bCopied && eErr == CE_None)
             {
-                // In the odd bit case, this is a bit messy to ensure
-                // the strile gets written synchronously.
-                // We load the content of the n-1 bands in the cache,
-                // and for the last band we invoke WriteBlock() directly
-                // We also force FlushBlockBuf()
-                std::vector<GDALRasterBlock *> apoLockedBlocks;
-                for (int i = 0; eErr == CE_None && i < l_nBands - 1; i++)
+                if (!bIsOddBand)
+                {
+                    eErr = poSrcDS->RasterIO(
+                        GF_Read, iX, iY, nReqXSize, nReqYSize, pBlockBuffer,
+                        nReqXSize, nReqYSize, eType, l_nBands, nullptr,
+                        static_cast<GSpacing>(nDataTypeSize) * l_nBands,
+                        static_cast<GSpacing>(nDataTypeSize) * l_nBands *
+                            poDstDS->m_nBlockXSize,
+                        nDataTypeSize, nullptr);
+                    if (eErr == CE_None)
+                    {
+                        eErr = poDstDS->WriteEncodedTileOrStrip(
+                            iBlock, pBlockBuffer, false);
+                    }
+                }
+                else
                 {
-                    auto poBlock =
-                        poDstDS->GetRasterBand(i + 1)->GetLockedBlockRef(
-                            nXBlock, nYBlock, TRUE);
-                    if (poBlock)
+                    // In the odd bit case, this is a bit messy to ensure
+                    // the strile gets written synchronously.
+                    // We load the content of the n-1 bands in the cache,
+                    // and for the last band we invoke WriteBlock() directly
+                    // We also force FlushBlockBuf()
+                    std::vector<GDALRasterBlock *> apoLockedBlocks;
+                    for (int i = 0; eErr == CE_None && i < l_nBands - 1; i++)
                     {
-                        eErr = poSrcDS->GetRasterBand(i + 1)->RasterIO(
-                            GF_Read, iX, iY, nReqXSize, nReqYSize,
-                            poBlock->GetDataRef(), nReqXSize, nReqYSize, eType,
-                            nDataTypeSize,
+                        auto poBlock =
+                            poDstDS->GetRasterBand(i + 1)->GetLockedBlockRef(
+                                nXBlock, nYBlock, TRUE);
+                        if (poBlock)
+                        {
+                            eErr = poSrcDS->GetRasterBand(i + 1)->RasterIO(
+                                GF_Read, iX, iY, nReqXSize, nReqYSize,
+                                poBlock->GetDataRef(), nReqXSize, nReqYSize,
+                                eType, nDataTypeSize,
+                                static_cast<GSpacing>(nDataTypeSize) *
+                                    poDstDS->m_nBlockXSize,
+                                nullptr);
+                            poBlock->MarkDirty();
+                            apoLockedBlocks.emplace_back(poBlock);
+                        }
+                        else
+                        {
+                            eErr = CE_Failure;
+                        }
+                    }
+                    if (eErr == CE_None)
+                    {
+                        eErr = poSrcDS->GetRasterBand(l_nBands)->RasterIO(
+                            GF_Read, iX, iY, nReqXSize, nReqYSize, pBlockBuffer,
+                            nReqXSize, nReqYSize, eType, nDataTypeSize,
                             static_cast<GSpacing>(nDataTypeSize) *
                                 poDstDS->m_nBlockXSize,
                             nullptr);
-                        poBlock->MarkDirty();
-                        apoLockedBlocks.emplace_back(poBlock);
                     }
-                    else
+                    if (eErr == CE_None)
                     {
-                        eErr = CE_Failure;
+                        // Avoid any attempt to load from disk
+                        poDstDS->m_nLoadedBlock = iBlock;
+                        eErr = poDstDS->GetRasterBand(l_nBands)->WriteBlock(
+                            nXBlock, nYBlock, pBlockBuffer);
+                        if (eErr == CE_None)
+                            eErr = poDstDS->FlushBlockBuf();
+                    }
+                    for (auto poBlock : apoLockedBlocks)
+                    {
+                        poBlock->MarkClean();
+                        poBlock->DropLock();
                     }
-                }
-                if (eErr == CE_None)
-                {
-                    eErr = poSrcDS->GetRasterBand(l_nBands)->RasterIO(
-                        GF_Read, iX, iY, nReqXSize, nReqYSize, pBlockBuffer,
-                        nReqXSize, nReqYSize, eType, nDataTypeSize,
-                        static_cast<GSpacing>(nDataTypeSize) *
-                            poDstDS->m_nBlockXSize,
-                        nullptr);
-                }
-                if (eErr == CE_None)
-                {
-                    // Avoid any attempt to load from disk
-                    poDstDS->m_nLoadedBlock = iBlock;
-                    eErr = poDstDS->GetRasterBand(l_nBands)->WriteBlock(
-                        nXBlock, nYBlock, pBlockBuffer);
-                    if (eErr == CE_None)
-                        eErr = poDstDS->FlushBlockBuf();
-                }
-                for (auto poBlock : apoLockedBlocks)
-                {
-                    poBlock->MarkClean();
-                    poBlock->DropLock();
                 }
             }
 
@@ -7841,9 +8284,12 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
                         dfNextCurPixels / dfTotalPixels, pfnProgress,
                         pProgressData);
 
-                    eErr =
-                        CopyImageryAndMask(poDstDS, poSrcOvrDS, poSrcMaskBand,
-                                           GDALScaledProgress, pScaledData);
+                    GTiffDataset *poSrcRawDS = GetRawCopySource(
+                        poDstDS, poOvrDS ? poOvrDS.get() : poSrcDS,
+                        poSrcOvrBand);
+                    eErr = CopyImageryAndMask(poDstDS, poSrcOvrDS,
+                                              poSrcMaskBand, poSrcRawDS,
+                                              GDALScaledProgress, pScaledData);
 
                     dfCurPixels = dfNextCurPixels;
                     GDALDestroyScaledProgress(pScaledData);
@@ -8071,14 +8517,21 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
                                              pfnProgress, pProgressData);
             }
 
-            eErr = CopyImageryAndMask(poDS, poSrcDS,
-                                      poSrcDS->GetRasterBand(1)->GetMaskBand(),
-                                      GDALScaledProgress, pScaledData);
+            eErr = CopyImageryAndMask(
+                poDS, poSrcDS, poSrcDS->GetRasterBand(1)->GetMaskBand(),
+                GetRawCopySource(poDS, poSrcDS, poSrcDS->GetRasterBand(1)),
+                GDALScaledProgress, pScaledData);
             if (poDS->m_poMaskDS)
             {
                 bWriteMask = false;
             }
         }
+        else if (auto poSrcRawDS = GetRawCopySource(
+                     poDS, poSrcDS, poSrcDS->GetRasterBand(1)))
+        {
+            eErr = poDS->CopyRawStripsOrTiles(poSrcRawDS, GDALScaledProgress,
+                                              pScaledData);
+        }
         else
         {
             eErr = GDALDatasetCopyWholeRaster(
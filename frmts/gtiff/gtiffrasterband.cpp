@@ -287,6 +287,22 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             bCanUseMultiThreadedRead = true;
         }
     }
+    else if (eRWFlag == GF_Read &&
+             (nXSize != nBufXSize || nYSize != nBufYSize))
+    {
+        // Resampled requests go through the block cache: decode the
+        // blocks in parallel beforehand.
+        m_poGDS->CacheBlocksMultiThreaded(nXOff, nYOff, nXSize, nYSize, 1,
+                                          &nBand);
+    }
+
+    // Blocks to fetch in advance in case of sequential access pattern
+    std::vector<std::pair<int, int>> aoReadAheadBlocks;
+    if (eRWFlag == GF_Read && nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        aoReadAheadBlocks =
+            m_poGDS->GetReadAheadBlocks(nXOff, nYOff, nXSize, nYSize);
+    }
 
     void *pBufferedData = nullptr;
     if (m_poGDS->eAccess == GA_ReadOnly && eRWFlag == GF_Read &&
@@ -297,6 +313,13 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         {
             // use the multi-threaded implementation rather than the multi-range
             // one
+            // and decode the read ahead blocks in the same parallel pass
+            if (!aoReadAheadBlocks.empty())
+            {
+                m_poGDS->CacheBlocksMultiThreaded(nXOff, nYOff, nXSize, nYSize,
+                                                  1, &nBand,
+                                                  &aoReadAheadBlocks);
+            }
         }
         else
         {
@@ -312,7 +335,8 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                     m_poGDS->m_poImageryDS->GetRasterBand(1));
             }
             pBufferedData = poBandForCache->CacheMultiRange(
-                nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize, psExtraArg);
+                nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize, psExtraArg,
+                &aoReadAheadBlocks);
         }
     }
 
@@ -458,6 +482,8 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     if (pBufferedData)
     {
+        if (eErr == CE_None)
+            m_poGDS->LoadReadAheadBlocks(aoReadAheadBlocks, 1, &nBand);
         VSIFree(pBufferedData);
         VSI_TIFFSetCachedRanges(TIFFClientdata(m_poGDS->m_hTIFF), 0, nullptr,
                                 nullptr, nullptr);
@@ -69,9 +69,10 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
                                              GIntBig *pnLineSpace,
                                              char **papszOptions);
 
-    void *CacheMultiRange(int nXOff, int nYOff, int nXSize, int nYSize,
-                          int nBufXSize, int nBufYSize,
-                          GDALRasterIOExtraArg *psExtraArg);
+    void *CacheMultiRange(
+        int nXOff, int nYOff, int nXSize, int nYSize, int nBufXSize,
+        int nBufYSize, GDALRasterIOExtraArg *psExtraArg,
+        std::vector<std::pair<int, int>> *paoReadAheadBlocks = nullptr);
 
   protected:
     GTiffDataset *m_poGDS = nullptr;
@@ -164,6 +165,10 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     virtual CPLVirtualMem *
     GetVirtualMemAuto(GDALRWFlag eRWFlag, int *pnPixelSpace,
                       GIntBig *pnLineSpace, char **papszOptions) override final;
+    virtual CPLVirtualMem *
+    GetBlockVirtualMem(int nXBlockOff, int nYBlockOff, int *pnPixelSpace,
+                       GIntBig *pnLineSpace,
+                       CSLConstList papszOptions) override final;
 
     GDALRasterAttributeTable *GetDefaultRAT() override final;
     virtual CPLErr
@@ -611,6 +611,71 @@ CPLVirtualMem *GTiffRasterBand::GetVirtualMemAutoInternal(GDALRWFlag eRWFlag,
     return pVMem;
 }
 
+/************************************************************************/
+/*                         GetBlockVirtualMem()                         */
+/************************************************************************/
+
+CPLVirtualMem *GTiffRasterBand::GetBlockVirtualMem(
+    int nXBlockOff, int nYBlockOff, int *pnPixelSpace, GIntBig *pnLineSpace,
+    CSLConstList /*papszOptions*/)
+{
+    if (nXBlockOff < 0 || nXBlockOff >= nBlocksPerRow || nYBlockOff < 0 ||
+        nYBlockOff >= nBlocksPerColumn)
+    {
+        return nullptr;
+    }
+
+    // In update mode, the file content may not reflect the block cache.
+    if (m_poGDS->eAccess != GA_ReadOnly || m_poGDS->m_bStreamingIn ||
+        m_poGDS->m_bTreatAsSplit || m_poGDS->m_bTreatAsSplitBitmap ||
+        m_poGDS->m_nSamplesPerPixel != m_poGDS->nBands ||
+        m_poGDS->m_nCompression != COMPRESSION_NONE ||
+        !(m_poGDS->m_nPhotometric == PHOTOMETRIC_MINISBLACK ||
+          m_poGDS->m_nPhotometric == PHOTOMETRIC_RGB ||
+          m_poGDS->m_nPhotometric == PHOTOMETRIC_PALETTE) ||
+        m_poGDS->m_nBitsPerSample != GDALGetDataTypeSizeBits(eDataType) ||
+        TIFFIsByteSwapped(m_poGDS->m_hTIFF))
+    {
+        return nullptr;
+    }
+
+    const int nBlockId = ComputeBlockId(nXBlockOff, nYBlockOff);
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nSize = 0;
+    if (!m_poGDS->IsBlockAvailable(nBlockId, &nOffset, &nSize))
+        return nullptr;
+
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const bool bContig = m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG;
+    const int nPixelSpace = bContig ? nDTSize * m_poGDS->nBands : nDTSize;
+    const GIntBig nLineSpace = static_cast<GIntBig>(nPixelSpace) * nBlockXSize;
+
+    // The last strip of a stripped file only contains the valid lines.
+    int nLines = nBlockYSize;
+    if (!TIFFIsTiled(m_poGDS->m_hTIFF) && nYBlockOff == nBlocksPerColumn - 1)
+        nLines = nRasterYSize - nYBlockOff * nBlockYSize;
+    const vsi_l_offset nViewSize =
+        static_cast<vsi_l_offset>(nLineSpace) * nLines;
+    if (nSize < nViewSize)
+        return nullptr;
+
+    CPLVirtualMem *psMapping = m_poGDS->GetBlockViewMapping();
+    if (psMapping == nullptr)
+        return nullptr;
+
+    const vsi_l_offset nBandOffset =
+        bContig ? static_cast<vsi_l_offset>(nBand - 1) * nDTSize : 0;
+    CPLVirtualMem *psView =
+        CPLVirtualMemDerivedNew(psMapping, nOffset + nBandOffset,
+                                nViewSize - nBandOffset, nullptr, nullptr);
+    if (psView == nullptr)
+        return nullptr;
+
+    *pnPixelSpace = nPixelSpace;
+    *pnLineSpace = nLineSpace;
+    return psView;
+}
+
 /************************************************************************/
 /*                         CacheMultiRange()                            */
 /************************************************************************/
@@ -632,9 +697,14 @@ static bool CheckTrailer(const GByte *strileData, vsi_l_offset nStrileSize)
     return memcmp(abyTrailer, abyLastBytes, 4) == 0;
 }
 
-void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
-                                       int nYSize, int nBufXSize, int nBufYSize,
-                                       GDALRasterIOExtraArg *psExtraArg)
+// If paoReadAheadBlocks is set, the raw data of those blocks is also
+// fetched, after the one of the blocks of the window, within the limit of
+// GDAL_MAX_RAW_BLOCK_CACHE_SIZE. On return, it contains the blocks whose
+// data is available in the cached ranges.
+void *GTiffRasterBand::CacheMultiRange(
+    int nXOff, int nYOff, int nXSize, int nYSize, int nBufXSize, int nBufYSize,
+    GDALRasterIOExtraArg *psExtraArg,
+    std::vector<std::pair<int, int>> *paoReadAheadBlocks)
 {
     void *pBufferedData = nullptr;
     // Same logic as in GDALRasterBand::IRasterIO()
@@ -926,6 +996,10 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
         return true;
     };
 
+    std::vector<std::pair<int, int>> aoReadAheadBlocks;
+    if (paoReadAheadBlocks)
+        std::swap(aoReadAheadBlocks, *paoReadAheadBlocks);
+
     thandle_t th = TIFFClientdata(m_poGDS->m_hTIFF);
     if (!VSI_TIFFHasCachedRanges(th))
     {
@@ -933,59 +1007,76 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
         size_t nTotalSize = 0;
         const unsigned int nMaxRawBlockCacheSize = atoi(
             CPLGetConfigOption("GDAL_MAX_RAW_BLOCK_CACHE_SIZE", "10485760"));
-        bool bGoOn = true;
-        for (int iY = nBlockY1; bGoOn && iY <= nBlockY2; iY++)
+
+        // Returns false if the maximum raw block cache size is reached
+        const auto AddBlock = [&](int iX, int iY)
         {
-            for (int iX = nBlockX1; bGoOn && iX <= nBlockX2; iX++)
+            GDALRasterBlock *poBlock = TryGetLockedBlockRef(iX, iY);
+            if (poBlock != nullptr)
             {
-                GDALRasterBlock *poBlock = TryGetLockedBlockRef(iX, iY);
-                if (poBlock != nullptr)
-                {
-                    poBlock->DropLock();
-                    continue;
-                }
-                int nBlockId = iX + iY * nBlocksPerRow;
-                if (m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
-                    nBlockId += (nBand - 1) * m_poGDS->m_nBlocksPerBand;
-                vsi_l_offset nOffset = 0;
-                vsi_l_offset nSize = 0;
-
-                if ((m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ||
-                     m_poGDS->nBands == 1) &&
-                    !m_poGDS->m_bStreamingIn &&
-                    m_poGDS->m_bBlockOrderRowMajor &&
-                    m_poGDS->m_bLeaderSizeAsUInt4)
+                poBlock->DropLock();
+                return true;
+            }
+            int nBlockId = iX + iY * nBlocksPerRow;
+            if (m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+                nBlockId += (nBand - 1) * m_poGDS->m_nBlocksPerBand;
+            vsi_l_offset nOffset = 0;
+            vsi_l_offset nSize = 0;
+
+            if ((m_poGDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ||
+                 m_poGDS->nBands == 1) &&
+                !m_poGDS->m_bStreamingIn && m_poGDS->m_bBlockOrderRowMajor &&
+                m_poGDS->m_bLeaderSizeAsUInt4)
+            {
+                OptimizedRetrievalOfOffsetSize(nBlockId, nOffset, nSize,
+                                               nTotalSize,
+                                               nMaxRawBlockCacheSize);
+            }
+            else
+            {
+                CPL_IGNORE_RET_VAL(
+                    m_poGDS->IsBlockAvailable(nBlockId, &nOffset, &nSize));
+            }
+            if (nSize)
+            {
+                if (nTotalSize + nSize < nMaxRawBlockCacheSize)
                 {
-                    OptimizedRetrievalOfOffsetSize(nBlockId, nOffset, nSize,
-                                                   nTotalSize,
-                                                   nMaxRawBlockCacheSize);
+#ifdef DEBUG_VERBOSE
+                    CPLDebug("GTiff",
+                             "Precaching for block (%d, %d), " CPL_FRMT_GUIB
+                             "-" CPL_FRMT_GUIB,
+                             iX, iY, nOffset,
+                             nOffset + static_cast<size_t>(nSize) - 1);
+#endif
+                    aOffsetSize.push_back(
+                        std::pair(nOffset, static_cast<size_t>(nSize)));
+                    nTotalSize += static_cast<size_t>(nSize);
                 }
                 else
                 {
-                    CPL_IGNORE_RET_VAL(
-                        m_poGDS->IsBlockAvailable(nBlockId, &nOffset, &nSize));
-                }
-                if (nSize)
-                {
-                    if (nTotalSize + nSize < nMaxRawBlockCacheSize)
-                    {
-#ifdef DEBUG_VERBOSE
-                        CPLDebug("GTiff",
-                                 "Precaching for block (%d, %d), " CPL_FRMT_GUIB
-                                 "-" CPL_FRMT_GUIB,
-                                 iX, iY, nOffset,
-                                 nOffset + static_cast<size_t>(nSize) - 1);
-#endif
-                        aOffsetSize.push_back(
-                            std::pair(nOffset, static_cast<size_t>(nSize)));
-                        nTotalSize += static_cast<size_t>(nSize);
-                    }
-                    else
-                    {
-                        bGoOn = false;
-                    }
+                    return false;
                 }
             }
+            return true;
+        };
+
+        bool bGoOn = true;
+        for (int iY = nBlockY1; bGoOn && iY <= nBlockY2; iY++)
+        {
+            for (int iX = nBlockX1; bGoOn && iX <= nBlockX2; iX++)
+            {
+                bGoOn = AddBlock(iX, iY);
+            }
+        }
+
+        std::vector<std::pair<int, int>> aoFetchedReadAheadBlocks;
+        for (const auto &oBlock : aoReadAheadBlocks)
+        {
+            if (!bGoOn)
+                break;
+            bGoOn = AddBlock(oBlock.first, oBlock.second);
+            if (bGoOn)
+                aoFetchedReadAheadBlocks.push_back(oBlock);
         }
 
         std::sort(aOffsetSize.begin(), aOffsetSize.end());
@@ -1061,9 +1152,11 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                         // Retry without optimization
                         CPLFree(pBufferedData);
                         m_poGDS->m_bLeaderSizeAsUInt4 = false;
-                        void *pRet =
-                            CacheMultiRange(nXOff, nYOff, nXSize, nYSize,
-                                            nBufXSize, nBufYSize, psExtraArg);
+                        if (paoReadAheadBlocks)
+                            *paoReadAheadBlocks = std::move(aoReadAheadBlocks);
+                        void *pRet = CacheMultiRange(
+                            nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize,
+                            psExtraArg, paoReadAheadBlocks);
                         m_poGDS->m_bLeaderSizeAsUInt4 = true;
                         return pRet;
                     }
@@ -1071,6 +1164,11 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
                     VSI_TIFFSetCachedRanges(
                         th, static_cast<int>(anSizes.size()), &apData[0],
                         &anOffsets[0], &anSizes[0]);
+                    if (paoReadAheadBlocks)
+                    {
+                        *paoReadAheadBlocks =
+                            std::move(aoFetchedReadAheadBlocks);
+                    }
                 }
             }
         }
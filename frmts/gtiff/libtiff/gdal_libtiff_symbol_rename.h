@@ -667,6 +667,7 @@
 #define _TIFFsetNString gdal__TIFFsetNString
 #define _TIFFsetShortArray gdal__TIFFsetShortArray
 #define _TIFFsetShortArrayExt gdal__TIFFsetShortArrayExt
+#define TIFFSetStrileOffsetAndByteCount gdal_TIFFSetStrileOffsetAndByteCount
 #define TIFFSetSubDirectory gdal_TIFFSetSubDirectory
 #define TIFFSetTagExtender gdal_TIFFSetTagExtender
 #define _TIFFSetupFields gdal__TIFFSetupFields
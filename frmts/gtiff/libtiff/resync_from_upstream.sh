@@ -25,10 +25,15 @@ for i in *.c; do
   fi
 done
 for i in *.h; do
-  if test "$i" != "gdal_libtiff_symbol_rename.h" -a "$i" != "tif_config.h" -a "$i" != "tiffconf.h"; then
+  if test "$i" != "gdal_libtiff_symbol_rename.h" -a "$i" != "tif_vsi.h" -a "$i" != "tif_config.h" -a "$i" != "tiffconf.h"; then
     echo "Resync $i"
     cp tmp_libtiff/libtiff/$i .
   fi
 done
 
+for i in *.patch; do
+  echo "Apply $i"
+  patch -p1 < "$i"
+done
+
 rm -rf tmp_libtiff
@@ -30,6 +30,12 @@
 #include "tif_predict.h"
 #include "tiffiop.h"
 
+/* SSE2 is part of the x86-64 baseline, so no CPU detection is needed there */
+#if (defined(__x86_64__) || defined(_M_X64)) && !WORDS_BIGENDIAN
+#define TIFF_PREDICT_SSE2
+#include <emmintrin.h>
+#endif
+
 #define PredictorState(tif) ((TIFFPredictorState *)(tif)->tif_data)
 
 static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc);
@@ -338,6 +344,262 @@ static int PredictorSetupEncode(TIFF *tif)
 /* - when storing into the byte stream, we explicitly mask with 0xff so */
 /*   as to make icc -check=conversions happy (not necessary by the standard) */
 
+#ifdef TIFF_PREDICT_SSE2
+
+/* Broadcast the last g bytes of v to the whole register (g = 1, 2, 4, 8) */
+static inline __m128i horAccBroadcastTail(__m128i v, tmsize_t g)
+{
+    if (g == 1)
+    {
+        v = _mm_unpackhi_epi8(v, v);
+        g = 2;
+    }
+    if (g == 2)
+        v = _mm_shufflehi_epi16(v, 0xFF);
+    else if (g == 4)
+        return _mm_shuffle_epi32(v, 0xFF);
+    return _mm_unpackhi_epi64(v, v);
+}
+
+/* Accumulation of 16 bytes whose predecessors, G bytes earlier, are already */
+/* final. When G < 16, the running sums are propagated inside the register */
+/* with log2(16/G) shift-and-add steps, and then carried over to the next */
+/* 16 bytes by broadcasting the last group of G bytes. */
+#define HOR_ACC_SSE2_SMALL(G, ADD)                                             \
+    do                                                                         \
+    {                                                                          \
+        uint8_t init[16];                                                      \
+        __m128i carry;                                                         \
+        int k;                                                                 \
+        for (k = 0; k < 16; k++)                                               \
+            init[k] = cp[k % (G)];                                             \
+        carry = _mm_loadu_si128((const __m128i *)init);                        \
+        for (; i + 16 <= cc; i += 16)                                          \
+        {                                                                      \
+            __m128i v = _mm_loadu_si128((const __m128i *)(cp + i));            \
+            v = ADD(v, _mm_slli_si128(v, (G)));                                \
+            if (2 * (G) < 16)                                                  \
+                v = ADD(v, _mm_slli_si128(v, 2 * (G)));                        \
+            if (4 * (G) < 16)                                                  \
+                v = ADD(v, _mm_slli_si128(v, 4 * (G)));                        \
+            if (8 * (G) < 16)                                                  \
+                v = ADD(v, _mm_slli_si128(v, 8 * (G)));                        \
+            v = ADD(v, carry);                                                 \
+            _mm_storeu_si128((__m128i *)(cp + i), v);                          \
+            carry = horAccBroadcastTail(v, (G));                               \
+        }                                                                      \
+    } while (0)
+
+#define HOR_ACC_SSE2_LARGE(ADD)                                                \
+    do                                                                         \
+    {                                                                          \
+        for (; i + 16 <= cc; i += 16)                                          \
+        {                                                                      \
+            __m128i v = _mm_loadu_si128((const __m128i *)(cp + i));            \
+            __m128i p = _mm_loadu_si128((const __m128i *)(cp + i - g));        \
+            _mm_storeu_si128((__m128i *)(cp + i), ADD(v, p));                  \
+        }                                                                      \
+    } while (0)
+
+/*
+ * Horizontal accumulation of cc bytes made of samples of eltsize bytes, with
+ * a distance of g bytes between a sample and its predictor. Returns the
+ * offset in bytes up to which the accumulation has been done (g if nothing
+ * could be done), so that the caller can finish with its scalar loop.
+ */
+TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
+static tmsize_t horAccSSE2(uint8_t *cp, tmsize_t cc, tmsize_t g, int eltsize)
+{
+    tmsize_t i = g;
+    if (cc - g < 16)
+        return i;
+    if (g >= 16)
+    {
+        switch (eltsize)
+        {
+            case 1:
+                HOR_ACC_SSE2_LARGE(_mm_add_epi8);
+                break;
+            case 2:
+                HOR_ACC_SSE2_LARGE(_mm_add_epi16);
+                break;
+            case 4:
+                HOR_ACC_SSE2_LARGE(_mm_add_epi32);
+                break;
+            default:
+                HOR_ACC_SSE2_LARGE(_mm_add_epi64);
+                break;
+        }
+        return i;
+    }
+    switch (eltsize * 16 + g)
+    {
+        case 16 + 1:
+            HOR_ACC_SSE2_SMALL(1, _mm_add_epi8);
+            break;
+        case 16 + 2:
+            HOR_ACC_SSE2_SMALL(2, _mm_add_epi8);
+            break;
+        case 16 + 4:
+            HOR_ACC_SSE2_SMALL(4, _mm_add_epi8);
+            break;
+        case 16 + 8:
+            HOR_ACC_SSE2_SMALL(8, _mm_add_epi8);
+            break;
+        case 32 + 2:
+            HOR_ACC_SSE2_SMALL(2, _mm_add_epi16);
+            break;
+        case 32 + 4:
+            HOR_ACC_SSE2_SMALL(4, _mm_add_epi16);
+            break;
+        case 32 + 8:
+            HOR_ACC_SSE2_SMALL(8, _mm_add_epi16);
+            break;
+        case 64 + 4:
+            HOR_ACC_SSE2_SMALL(4, _mm_add_epi32);
+            break;
+        case 64 + 8:
+            HOR_ACC_SSE2_SMALL(8, _mm_add_epi32);
+            break;
+        case 128 + 8:
+            HOR_ACC_SSE2_SMALL(8, _mm_add_epi64);
+            break;
+        default:
+            /* Group size not dividing 16 bytes (e.g. RGB): scalar code */
+            break;
+    }
+    return i;
+}
+
+#define HOR_DIFF_SSE2(SUB)                                                     \
+    do                                                                         \
+    {                                                                          \
+        while (i - 16 >= g)                                                    \
+        {                                                                      \
+            __m128i v, p;                                                      \
+            i -= 16;                                                           \
+            v = _mm_loadu_si128((const __m128i *)(cp + i));                    \
+            p = _mm_loadu_si128((const __m128i *)(cp + i - g));                \
+            _mm_storeu_si128((__m128i *)(cp + i), SUB(v, p));                  \
+        }                                                                      \
+    } while (0)
+
+/*
+ * Horizontal differencing of cc bytes made of samples of eltsize bytes, with
+ * a distance of g bytes between a sample and its predictor. The buffer is
+ * processed backwards, so that the predictors are still unmodified when they
+ * are loaded. Returns the offset in bytes from which the differencing has
+ * been done (cc if nothing could be done); the caller must process the bytes
+ * in [g, returned value[ with its scalar loop.
+ */
+TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
+static tmsize_t horDiffSSE2(uint8_t *cp, tmsize_t cc, tmsize_t g, int eltsize)
+{
+    tmsize_t i = cc;
+    switch (eltsize)
+    {
+        case 1:
+            HOR_DIFF_SSE2(_mm_sub_epi8);
+            break;
+        case 2:
+            HOR_DIFF_SSE2(_mm_sub_epi16);
+            break;
+        case 4:
+            HOR_DIFF_SSE2(_mm_sub_epi32);
+            break;
+        default:
+            HOR_DIFF_SSE2(_mm_sub_epi64);
+            break;
+    }
+    return i;
+}
+
+/*
+ * Byte (de)interleaving for the floating point predictor. The predictor
+ * stores byte k (in big endian order) of all the samples of a row in
+ * a contiguous plane. fpInterleaveSSE2() rebuilds bps * 16 bytes of samples
+ * from 16 bytes of each plane, and fpDeinterleaveSSE2() does the reverse.
+ * Each of the log2(bps) steps (de)interleaves pairs of bytes, words or
+ * dwords, so that after the last step the registers are in natural order.
+ */
+static inline void fpDeinterleaveStepSSE2(__m128i *v, uint32_t bps)
+{
+    const __m128i mask = _mm_set1_epi16(0xFF);
+    __m128i tmp[8];
+    uint32_t m;
+    for (m = 0; m < bps / 2; m++)
+    {
+        const __m128i a = v[2 * m];
+        const __m128i b = v[2 * m + 1];
+        tmp[m] = _mm_packus_epi16(_mm_and_si128(a, mask),
+                                  _mm_and_si128(b, mask));
+        tmp[bps / 2 + m] =
+            _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+    }
+    for (m = 0; m < bps; m++)
+        v[m] = tmp[m];
+}
+
+static inline void fpInterleaveStepSSE2(__m128i *v, uint32_t bps)
+{
+    __m128i tmp[8];
+    uint32_t m;
+    for (m = 0; m < bps / 2; m++)
+    {
+        tmp[2 * m] = _mm_unpacklo_epi8(v[m], v[bps / 2 + m]);
+        tmp[2 * m + 1] = _mm_unpackhi_epi8(v[m], v[bps / 2 + m]);
+    }
+    for (m = 0; m < bps; m++)
+        v[m] = tmp[m];
+}
+
+/* Returns the number of samples processed */
+static tmsize_t fpInterleaveSSE2(uint8_t *cp, const uint8_t *tmp, tmsize_t wc,
+                                 uint32_t bps)
+{
+    tmsize_t count = 0;
+    if (bps != 2 && bps != 4 && bps != 8)
+        return 0;
+    for (; count + 16 <= wc; count += 16)
+    {
+        __m128i v[8];
+        uint32_t k, step;
+        for (k = 0; k < bps; k++)
+            v[k] = _mm_loadu_si128(
+                (const __m128i *)(tmp + (bps - k - 1) * wc + count));
+        for (step = 1; step < bps; step *= 2)
+            fpInterleaveStepSSE2(v, bps);
+        for (k = 0; k < bps; k++)
+            _mm_storeu_si128((__m128i *)(cp + bps * count + 16 * k), v[k]);
+    }
+    return count;
+}
+
+/* Returns the number of samples processed */
+static tmsize_t fpDeinterleaveSSE2(uint8_t *cp, const uint8_t *tmp,
+                                   tmsize_t wc, uint32_t bps)
+{
+    tmsize_t count = 0;
+    if (bps != 2 && bps != 4 && bps != 8)
+        return 0;
+    for (; count + 16 <= wc; count += 16)
+    {
+        __m128i v[8];
+        uint32_t k, step;
+        for (k = 0; k < bps; k++)
+            v[k] = _mm_loadu_si128(
+                (const __m128i *)(tmp + bps * count + 16 * k));
+        for (step = 1; step < bps; step *= 2)
+            fpDeinterleaveStepSSE2(v, bps);
+        for (k = 0; k < bps; k++)
+            _mm_storeu_si128((__m128i *)(cp + (bps - k - 1) * wc + count),
+                             v[k]);
+    }
+    return count;
+}
+
+#endif /* TIFF_PREDICT_SSE2 */
+
 TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
 static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 {
@@ -352,6 +614,15 @@ static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (cc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horAccSSE2(cp, cc, stride, 1);
+        if (pos > stride)
+        {
+            for (; pos < cc; pos++)
+                cp[pos] = (unsigned char)((cp[pos] + cp[pos - stride]) & 0xff);
+            return 1;
+        }
+#endif
         /*
          * Pipeline the most common cases.
          */
@@ -422,6 +693,17 @@ static int horAcc16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horAccSSE2(cp0, cc, 2 * stride, 2) / 2;
+        if (pos > stride)
+        {
+            for (; pos < wc; pos++)
+                wp[pos] = (uint16_t)(((unsigned int)wp[pos] +
+                                      (unsigned int)wp[pos - stride]) &
+                                     0xffff);
+            return 1;
+        }
+#endif
         wc -= stride;
         do
         {
@@ -459,6 +741,15 @@ static int horAcc32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horAccSSE2(cp0, cc, 4 * stride, 4) / 4;
+        if (pos > stride)
+        {
+            for (; pos < wc; pos++)
+                wp[pos] += wp[pos - stride];
+            return 1;
+        }
+#endif
         wc -= stride;
         do
         {
@@ -493,6 +784,15 @@ static int horAcc64(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horAccSSE2(cp0, cc, 8 * stride, 8) / 8;
+        if (pos > stride)
+        {
+            for (; pos < wc; pos++)
+                wp[pos] += wp[pos - stride];
+            return 1;
+        }
+#endif
         wc -= stride;
         do
         {
@@ -525,6 +825,14 @@ static int fpAcc(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     if (!tmp)
         return 0;
 
+#ifdef TIFF_PREDICT_SSE2
+    if (count > stride)
+    {
+        tmsize_t pos = horAccSSE2(cp, cc, stride, 1);
+        for (; pos < cc; pos++)
+            cp[pos] = (unsigned char)((cp[pos] + cp[pos - stride]) & 0xff);
+    }
+#else
     while (count > stride)
     {
         REPEAT4(stride,
@@ -532,10 +840,16 @@ static int fpAcc(TIFF *tif, uint8_t *cp0, tmsize_t cc)
                 cp++)
         count -= stride;
     }
+#endif
 
     _TIFFmemcpy(tmp, cp0, cc);
     cp = (uint8_t *)cp0;
-    for (count = 0; count < wc; count++)
+#ifdef TIFF_PREDICT_SSE2
+    count = fpInterleaveSSE2(cp, tmp, wc, bps);
+#else
+    count = 0;
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -625,6 +939,18 @@ static int horDiff8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (cc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horDiffSSE2(cp, cc, stride, 1);
+        if (pos < cc)
+        {
+            while (pos > stride)
+            {
+                pos--;
+                cp[pos] = (unsigned char)((cp[pos] - cp[pos - stride]) & 0xff);
+            }
+            return 1;
+        }
+#endif
         cc -= stride;
         /*
          * Pipeline the most common cases.
@@ -704,6 +1030,20 @@ static int horDiff16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horDiffSSE2(cp0, cc, 2 * stride, 2) / 2;
+        if (pos < wc)
+        {
+            while (pos > stride)
+            {
+                pos--;
+                wp[pos] = (uint16_t)(((unsigned int)wp[pos] -
+                                      (unsigned int)wp[pos - stride]) &
+                                     0xffff);
+            }
+            return 1;
+        }
+#endif
         wc -= stride;
         wp += wc - 1;
         do
@@ -746,6 +1086,18 @@ static int horDiff32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horDiffSSE2(cp0, cc, 4 * stride, 4) / 4;
+        if (pos < wc)
+        {
+            while (pos > stride)
+            {
+                pos--;
+                wp[pos] -= wp[pos - stride];
+            }
+            return 1;
+        }
+#endif
         wc -= stride;
         wp += wc - 1;
         do
@@ -785,6 +1137,18 @@ static int horDiff64(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (wc > stride)
     {
+#ifdef TIFF_PREDICT_SSE2
+        tmsize_t pos = horDiffSSE2(cp0, cc, 8 * stride, 8) / 8;
+        if (pos < wc)
+        {
+            while (pos > stride)
+            {
+                pos--;
+                wp[pos] -= wp[pos - stride];
+            }
+            return 1;
+        }
+#endif
         wc -= stride;
         wp += wc - 1;
         do
@@ -832,7 +1196,12 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
 
     _TIFFmemcpy(tmp, cp0, cc);
-    for (count = 0; count < wc; count++)
+#ifdef TIFF_PREDICT_SSE2
+    count = fpDeinterleaveSSE2(cp, tmp, wc, bps);
+#else
+    count = 0;
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -847,11 +1216,23 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     _TIFFfreeExt(tif, tmp);
 
     cp = (uint8_t *)cp0;
+#ifdef TIFF_PREDICT_SSE2
+    if (cc > stride)
+    {
+        tmsize_t pos = horDiffSSE2(cp, cc, stride, 1);
+        while (pos > stride)
+        {
+            pos--;
+            cp[pos] = (unsigned char)((cp[pos] - cp[pos - stride]) & 0xff);
+        }
+    }
+#else
     cp += cc - stride - 1;
     for (count = cc; count > stride; count -= stride)
         REPEAT4(stride,
                 cp[stride] = (unsigned char)((cp[stride] - cp[0]) & 0xff);
                 cp--)
+#endif
     return 1;
 }
 
@@ -29,6 +29,18 @@
  */
 #include "tiffiop.h"
 
+/* SSE2 is part of the x86-64 baseline, so no CPU detection is needed there */
+#if defined(__x86_64__) || defined(_M_X64)
+#define TIFF_SWAB_SSE2
+#include <emmintrin.h>
+
+/* Swap the two bytes of each 16-bit word of v */
+static inline __m128i TIFFSwabWordsSSE2(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+#endif
+
 #if defined(DISABLE_CHECK_TIFFSWABMACROS) || !defined(TIFFSwabShort)
 void TIFFSwabShort(uint16_t *wp)
 {
@@ -83,6 +95,13 @@ void TIFFSwabArrayOfShort(register uint16_t *wp, tmsize_t n)
     register unsigned char *cp;
     register unsigned char t;
     assert(sizeof(uint16_t) == 2);
+#ifdef TIFF_SWAB_SSE2
+    for (; n >= 8; n -= 8, wp += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)wp);
+        _mm_storeu_si128((__m128i *)wp, TIFFSwabWordsSSE2(v));
+    }
+#endif
     /* XXX unroll loop some */
     while (n-- > 0)
     {
@@ -119,6 +138,16 @@ void TIFFSwabArrayOfLong(register uint32_t *lp, tmsize_t n)
     register unsigned char *cp;
     register unsigned char t;
     assert(sizeof(uint32_t) == 4);
+#ifdef TIFF_SWAB_SSE2
+    for (; n >= 4; n -= 4, lp += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)lp);
+        /* Swap the 16-bit words of each 32-bit value, and then their bytes */
+        v = _mm_shufflelo_epi16(v, 0xB1);
+        v = _mm_shufflehi_epi16(v, 0xB1);
+        _mm_storeu_si128((__m128i *)lp, TIFFSwabWordsSSE2(v));
+    }
+#endif
     /* XXX unroll loop some */
     while (n-- > 0)
     {
@@ -140,6 +169,17 @@ void TIFFSwabArrayOfLong8(register uint64_t *lp, tmsize_t n)
     register unsigned char *cp;
     register unsigned char t;
     assert(sizeof(uint64_t) == 8);
+#ifdef TIFF_SWAB_SSE2
+    for (; n >= 2; n -= 2, lp += 2)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)lp);
+        /* Reverse the 16-bit words of each 64-bit value, and then swap */
+        /* their bytes */
+        v = _mm_shufflelo_epi16(v, 0x1B);
+        v = _mm_shufflehi_epi16(v, 0x1B);
+        _mm_storeu_si128((__m128i *)lp, TIFFSwabWordsSSE2(v));
+    }
+#endif
     /* XXX unroll loop some */
     while (n-- > 0)
     {
@@ -182,6 +222,15 @@ void TIFFSwabArrayOfFloat(register float *fp, tmsize_t n)
     register unsigned char *cp;
     register unsigned char t;
     assert(sizeof(float) == 4);
+#ifdef TIFF_SWAB_SSE2
+    for (; n >= 4; n -= 4, fp += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)fp);
+        v = _mm_shufflelo_epi16(v, 0xB1);
+        v = _mm_shufflehi_epi16(v, 0xB1);
+        _mm_storeu_si128((__m128i *)fp, TIFFSwabWordsSSE2(v));
+    }
+#endif
     /* XXX unroll loop some */
     while (n-- > 0)
     {
@@ -224,6 +273,15 @@ void TIFFSwabArrayOfDouble(double *dp, tmsize_t n)
     register unsigned char *cp;
     register unsigned char t;
     assert(sizeof(double) == 8);
+#ifdef TIFF_SWAB_SSE2
+    for (; n >= 2; n -= 2, dp += 2)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)dp);
+        v = _mm_shufflelo_epi16(v, 0x1B);
+        v = _mm_shufflehi_epi16(v, 0x1B);
+        _mm_storeu_si128((__m128i *)dp, TIFFSwabWordsSSE2(v));
+    }
+#endif
     /* XXX unroll loop some */
     while (n-- > 0)
     {
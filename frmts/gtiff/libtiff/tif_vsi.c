@@ -33,6 +33,7 @@
  * TIFF Library UNIX-specific Routines.
  */
 #include "tiffiop.h"
+#include "tif_vsi.h"
 #include "cpl_vsi.h"
 
 CPL_INLINE static void CPL_IGNORE_RET_VAL_INT(CPL_UNUSED int unused) {}
@@ -217,3 +218,35 @@ unixErrorHandler(const char* module, const char* fmt, va_list ap)
 	fprintf(stderr, ".\n");
 }
 TIFFErrorHandler _TIFFerrorHandler = unixErrorHandler;
+
+/*
+ * GDAL specific: record that the data of a strile has been written by the
+ * caller at the given offset, and mark the strile arrays as dirty so that
+ * they are rewritten when the directory is flushed.
+ */
+int
+TIFFSetStrileOffsetAndByteCount(TIFF* tif, uint32_t strile,
+                                uint64_t offset, uint64_t bytecount)
+{
+	static const char module[] = "TIFFSetStrileOffsetAndByteCount";
+	TIFFDirectory *td = &tif->tif_dir;
+
+	if (tif->tif_mode == O_RDONLY) {
+		TIFFErrorExtR(tif, module, "File opened in read-only mode");
+		return 0;
+	}
+	if (!_TIFFFillStriles(tif) || td->td_stripoffset_p == NULL ||
+	    td->td_stripbytecount_p == NULL) {
+		TIFFErrorExtR(tif, module, "Strile arrays are not available");
+		return 0;
+	}
+	if (strile >= td->td_nstrips) {
+		TIFFErrorExtR(tif, module, "%u: Strile out of range, max %u",
+		              strile, td->td_nstrips);
+		return 0;
+	}
+	td->td_stripoffset_p[strile] = offset;
+	td->td_stripbytecount_p[strile] = bytecount;
+	tif->tif_flags |= TIFF_DIRTYSTRIP;
+	return 1;
+}
@@ -53,4 +53,9 @@ void VSI_TIFFSetCachedRanges(
     const vsi_l_offset *panOffsets, const size_t *panSizes);
 void *VSI_TIFFGetCachedRange(thandle_t th, vsi_l_offset nOffset, size_t nSize);
 
+#ifdef INTERNAL_LIBTIFF
+// Implemented in libtiff/tif_vsi.c
+#include "tif_vsi.h"
+#endif
+
 #endif  // TIFVSI_H_INCLUDED
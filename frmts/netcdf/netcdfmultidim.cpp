@@ -29,6 +29,7 @@
 #include <limits>
 #include <map>
 
+#include "gdalmultidim_chunkcache.h"
 #include "netcdfdataset.h"
 #include "netcdfdrivercore.h"
 
@@ -59,6 +60,7 @@ class netCDFSharedResources
     bool m_bIsInIndexingVariable = false;
     std::shared_ptr<GDALPamMultiDim> m_poPAM{};
     std::map<int, std::weak_ptr<GDALDimension>> m_oCachedDimensions{};
+    const uint64_t m_nChunkCacheOwnerId;
 
   public:
     explicit netCDFSharedResources(const std::string &osFilename);
@@ -114,6 +116,11 @@ class netCDFSharedResources
             return nullptr;
         return oIter->second.lock();
     }
+
+    uint64_t GetChunkCacheOwnerId() const
+    {
+        return m_nChunkCacheOwnerId;
+    }
 };
 
 /************************************************************************/
@@ -122,7 +129,8 @@ class netCDFSharedResources
 
 netCDFSharedResources::netCDFSharedResources(const std::string &osFilename)
     : m_bImappIsInElements(false), m_osFilename(osFilename),
-      m_poPAM(std::make_shared<GDALPamMultiDim>(osFilename))
+      m_poPAM(std::make_shared<GDALPamMultiDim>(osFilename)),
+      m_nChunkCacheOwnerId(GDALMDArrayChunkCache::GetNewOwnerId())
 {
     // netcdf >= 4.4 uses imapp argument of nc_get/put_varm as a stride in
     // elements, whereas earlier versions use bytes.
@@ -518,6 +526,8 @@ class netCDFVariable final : public GDALPamMDArray, public netCDFAttributeHolder
     mutable std::vector<GUInt64> m_cachedArrayStartIdx{};
     mutable std::vector<size_t> m_cachedCount{};
     mutable std::shared_ptr<GDALMDArray> m_poCachedArray{};
+    //! Chunk size, when GDAL_NETCDF_USE_MDARRAY_CHUNK_CACHE is enabled
+    std::vector<size_t> m_anChunkCacheBlockSize{};
 
     void ConvertNCToGDAL(GByte *) const;
     void ConvertGDALToNC(GByte *) const;
@@ -551,6 +561,14 @@ class netCDFVariable final : public GDALPamMDArray, public netCDFAttributeHolder
                     NCGetPutVarmFuncType NCGetPutVarmFunc,
                     ReadOrWriteOneElementType ReadOrWriteOneElement) const;
 
+    bool CanUseChunkCache(const size_t *count, const GInt64 *arrayStep,
+                          const GDALExtendedDataType &bufferDataType) const;
+
+    bool ReadFromChunkCache(const GUInt64 *arrayStartIdx, const size_t *count,
+                            const GPtrDiff_t *bufferStride,
+                            const GDALExtendedDataType &bufferDataType,
+                            void *pDstBuffer) const;
+
   protected:
     netCDFVariable(const std::shared_ptr<netCDFSharedResources> &poShared,
                    int gid, int varid,
@@ -723,6 +741,8 @@ netCDFSharedResources::~netCDFSharedResources()
     if (m_fpVSIMEM)
         VSIFCloseL(m_fpVSIMEM);
 
+    GDALMDArrayChunkCache::GetSingleton().RemoveOwner(m_nChunkCacheOwnerId);
+
 #ifdef ENABLE_NCDUMP
     if (m_bFileToDestroyAtClosing)
         VSIUnlink(m_osFilename);
@@ -1112,6 +1132,18 @@ std::shared_ptr<GDALMDArray> netCDFGroup::CreateMDArray(
         return nullptr;
 
     const char *pszBlockSize = CSLFetchNameValue(papszOptions, "BLOCKSIZE");
+    if (pszBlockSize)
+    {
+        int nFormat = 0;
+        nc_inq_format(m_gid, &nFormat);
+        if (nFormat != NC_FORMAT_NETCDF4 &&
+            nFormat != NC_FORMAT_NETCDF4_CLASSIC)
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "BLOCKSIZE ignored: only supported for netCDF-4 files");
+            pszBlockSize = nullptr;
+        }
+    }
     if (pszBlockSize &&
         /* ignore for now BLOCKSIZE for 1-dim string variables created as 2-dim
          */
@@ -2107,6 +2139,22 @@ netCDFVariable::netCDFVariable(
     }
     m_bWriteGDALTags = CPLTestBool(
         CSLFetchNameValueDef(papszOptions, "WRITE_GDAL_TAGS", "YES"));
+
+    if (m_poShared->IsReadOnly() && m_nDims > 0 && m_nVarType != NC_CHAR &&
+        CPLTestBool(CPLGetConfigOption("GDAL_NETCDF_USE_MDARRAY_CHUNK_CACHE",
+                                       "NO")))
+    {
+        int nStorageType = 0;
+        std::vector<size_t> anChunkSize(m_nDims);
+        if (nc_inq_var_chunking(m_gid, m_varid, &nStorageType,
+                                anChunkSize.data()) == NC_NOERR &&
+            nStorageType == NC_CHUNKED &&
+            std::find(anChunkSize.begin(), anChunkSize.end(),
+                      static_cast<size_t>(0)) == anChunkSize.end())
+        {
+            m_anChunkCacheBlockSize = std::move(anChunkSize);
+        }
+    }
 }
 
 /************************************************************************/
@@ -3477,6 +3525,12 @@ bool netCDFVariable::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
         }
     }
 
+    if (CanUseChunkCache(count, arrayStep, bufferDataType))
+    {
+        return ReadFromChunkCache(arrayStartIdx, count, bufferStride,
+                                  bufferDataType, pDstBuffer);
+    }
+
     if (IsTransposedRequest(count, bufferStride))
     {
         return ReadForTransposedRequest(arrayStartIdx, count, arrayStep,
@@ -3489,6 +3543,176 @@ bool netCDFVariable::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
                       nc_get_varm, &netCDFVariable::ReadOneElement);
 }
 
+/************************************************************************/
+/*                          CanUseChunkCache()                          */
+/************************************************************************/
+
+bool netCDFVariable::CanUseChunkCache(
+    const size_t *count, const GInt64 *arrayStep,
+    const GDALExtendedDataType &bufferDataType) const
+{
+    if (m_anChunkCacheBlockSize.empty() ||
+        GetDimensions().size() != m_anChunkCacheBlockSize.size() ||
+        bufferDataType.GetClass() != GEDTC_NUMERIC)
+    {
+        return false;
+    }
+    const auto &dt = GetDataType();
+    if (dt.GetClass() != GEDTC_NUMERIC || !m_bPerfectDataTypeMatch)
+        return false;
+    for (size_t i = 0; i < m_anChunkCacheBlockSize.size(); ++i)
+    {
+        if (count[i] != 1 && arrayStep[i] != 1)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadFromChunkCache()                         */
+/************************************************************************/
+
+// Serves a read request from decoded chunks stored in the process-wide
+// GDALMDArrayChunkCache. Only chunks missing from the cache are read with
+// the netCDF library, under hNCMutex. Cached chunks are copied to the user
+// buffer without taking that mutex, so concurrent readers only contend on
+// chunks that have not been decoded yet.
+bool netCDFVariable::ReadFromChunkCache(
+    const GUInt64 *arrayStartIdx, const size_t *count,
+    const GPtrDiff_t *bufferStride, const GDALExtendedDataType &bufferDataType,
+    void *pDstBuffer) const
+{
+    const size_t nDims = m_anChunkCacheBlockSize.size();
+    const auto &apoDims = GetDimensions();
+    const auto eDT = GetDataType().GetNumericDataType();
+    const auto eBufferDT = bufferDataType.GetNumericDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const int nBufferDTSize = GDALGetDataTypeSizeBytes(eBufferDT);
+    auto &oCache = GDALMDArrayChunkCache::GetSingleton();
+    const uint64_t nOwnerId = m_poShared->GetChunkCacheOwnerId();
+
+    // Key of a chunk: group id, variable id and chunk indices
+    std::vector<uint64_t> anKey(2 + nDims);
+    anKey[0] = static_cast<uint64_t>(m_gid);
+    anKey[1] = static_cast<uint64_t>(m_varid);
+
+    std::vector<uint64_t> anFirstChunk(nDims);
+    std::vector<uint64_t> anLastChunk(nDims);
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        anFirstChunk[i] = arrayStartIdx[i] / m_anChunkCacheBlockSize[i];
+        anLastChunk[i] = (arrayStartIdx[i] + count[i] - 1) /
+                         m_anChunkCacheBlockSize[i];
+    }
+
+    std::vector<uint64_t> anChunkIdx(anFirstChunk);
+    std::vector<size_t> anChunkStart(nDims);
+    std::vector<size_t> anChunkCount(nDims);
+    std::vector<size_t> anCopyCount(nDims);
+    std::vector<size_t> anIter(nDims);
+    while (true)
+    {
+        size_t nChunkElts = 1;
+        for (size_t i = 0; i < nDims; ++i)
+        {
+            anKey[2 + i] = anChunkIdx[i];
+            anChunkStart[i] =
+                static_cast<size_t>(anChunkIdx[i] * m_anChunkCacheBlockSize[i]);
+            anChunkCount[i] = static_cast<size_t>(
+                std::min<GUInt64>(m_anChunkCacheBlockSize[i],
+                                  apoDims[i]->GetSize() - anChunkStart[i]));
+            nChunkElts *= anChunkCount[i];
+        }
+
+        auto poChunk = oCache.Get(nOwnerId, anKey);
+        if (!poChunk)
+        {
+            auto poNewChunk = std::make_shared<std::vector<GByte>>();
+            try
+            {
+                poNewChunk->resize(nChunkElts * nDTSize);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate memory for chunk");
+                return false;
+            }
+            {
+                CPLMutexHolderD(&hNCMutex);
+                int ret = nc_get_vara(m_gid, m_varid, anChunkStart.data(),
+                                      anChunkCount.data(), poNewChunk->data());
+                NCDF_ERR(ret);
+                if (ret != NC_NOERR)
+                    return false;
+            }
+            poChunk = std::move(poNewChunk);
+            oCache.Insert(nOwnerId, anKey, poChunk);
+        }
+
+        // Copy the intersection of the chunk with the requested window,
+        // one run along the last dimension at a time.
+        const GByte *pabySrc = poChunk->data();
+        GByte *pabyDst = static_cast<GByte *>(pDstBuffer);
+        for (size_t i = 0; i < nDims; ++i)
+        {
+            const GUInt64 nLo = std::max<GUInt64>(arrayStartIdx[i],
+                                                  anChunkStart[i]);
+            const GUInt64 nHi =
+                std::min<GUInt64>(arrayStartIdx[i] + count[i],
+                                  anChunkStart[i] + anChunkCount[i]);
+            anCopyCount[i] = static_cast<size_t>(nHi - nLo);
+            size_t nSrcStride = nDTSize;
+            for (size_t j = i + 1; j < nDims; ++j)
+                nSrcStride *= anChunkCount[j];
+            pabySrc += static_cast<size_t>(nLo - anChunkStart[i]) * nSrcStride;
+            pabyDst += static_cast<GPtrDiff_t>(nLo - arrayStartIdx[i]) *
+                       bufferStride[i] * nBufferDTSize;
+            anIter[i] = 0;
+        }
+        const size_t nLastDim = nDims - 1;
+        bool bDone = false;
+        while (!bDone)
+        {
+            GDALCopyWords64(pabySrc, eDT, nDTSize, pabyDst, eBufferDT,
+                            static_cast<int>(bufferStride[nLastDim] *
+                                             nBufferDTSize),
+                            anCopyCount[nLastDim]);
+
+            bDone = true;
+            size_t nSrcStride = nDTSize * anChunkCount[nLastDim];
+            for (size_t i = nLastDim; i > 0;)
+            {
+                --i;
+                pabySrc += nSrcStride;
+                pabyDst += bufferStride[i] * nBufferDTSize;
+                if (++anIter[i] < anCopyCount[i])
+                {
+                    bDone = false;
+                    break;
+                }
+                pabySrc -= anCopyCount[i] * nSrcStride;
+                pabyDst -= static_cast<GPtrDiff_t>(anCopyCount[i]) *
+                           bufferStride[i] * nBufferDTSize;
+                anIter[i] = 0;
+                nSrcStride *= anChunkCount[i];
+            }
+        }
+
+        // Advance to next chunk
+        size_t i = nDims;
+        while (true)
+        {
+            if (i == 0)
+                return true;
+            --i;
+            if (++anChunkIdx[i] <= anLastChunk[i])
+                break;
+            anChunkIdx[i] = anFirstChunk[i];
+        }
+    }
+}
+
 /************************************************************************/
 /*                             IAdviseRead()                            */
 /************************************************************************/
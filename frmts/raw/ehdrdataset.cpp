@@ -285,6 +285,23 @@ CPLErr EHdrRasterBand::IWriteBlock(int nBlockXOff, int nBlockYOff, void *pImage)
     return CE_None;
 }
 
+/************************************************************************/
+/*                         GetBlockVirtualMem()                         */
+/************************************************************************/
+
+CPLVirtualMem *EHdrRasterBand::GetBlockVirtualMem(int nXBlockOff,
+                                                  int nYBlockOff,
+                                                  int *pnPixelSpace,
+                                                  GIntBig *pnLineSpace,
+                                                  CSLConstList papszOptions)
+{
+    // Sub-byte samples need to be unpacked by IReadBlock()
+    if (nBits < 8)
+        return nullptr;
+    return RawRasterBand::GetBlockVirtualMem(
+        nXBlockOff, nYBlockOff, pnPixelSpace, pnLineSpace, papszOptions);
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
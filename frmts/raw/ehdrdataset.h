@@ -175,6 +175,10 @@ class EHdrRasterBand final : public RawRasterBand
     CPLErr IReadBlock(int, int, void *) override;
     CPLErr IWriteBlock(int, int, void *) override;
 
+    CPLVirtualMem *GetBlockVirtualMem(int nXBlockOff, int nYBlockOff,
+                                      int *pnPixelSpace, GIntBig *pnLineSpace,
+                                      CSLConstList papszOptions) override;
+
     double GetNoDataValue(int *pbSuccess = nullptr) override;
     double GetMinimum(int *pbSuccess = nullptr) override;
     double GetMaximum(int *pbSuccess = nullptr) override;
@@ -39,6 +39,7 @@
 #include "cpl_port.h"
 #include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
 #include "vrtdataset.h"
 #include "vrt_priv.h"
 #include "ogrsf_frmts.h"
@@ -219,12 +220,82 @@ class GDALTileIndexDataset final : public GDALPamDataset
     //! SRS of the tile index.
     OGRSpatialReference m_oSRS{};
 
-    //! Cache from dataset name to dataset handle.
+    //! Properties of a source dataset that do not depend on the pixel
+    //! request, computed once when the source is first used.
+    struct SharedSource
+    {
+        //! Source dataset handle.
+        std::shared_ptr<GDALDataset> poDS{};
+
+        //! Whether the source has a geotransform.
+        bool bHasGeoTransform = false;
+
+        //! Whether the source intersects the extent of the tile index.
+        bool bIntersects = false;
+
+        //! Source window, in source pixel coordinates.
+        double dfSrcXOff = 0;
+        double dfSrcYOff = 0;
+        double dfSrcXSize = 0;
+        double dfSrcYSize = 0;
+
+        //! Destination window, in tile index pixel coordinates.
+        double dfDstXOff = 0;
+        double dfDstYOff = 0;
+        double dfDstXSize = 0;
+        double dfDstYSize = 0;
+
+        //! Whether the source has a nodata value at least in one of its band.
+        bool bHasNoData = false;
+
+        //! Whether all bands of the source have the same nodata value.
+        bool bSameNoData = true;
+
+        //! Nodata value (of the last band that has one).
+        double dfNoDataValue = 0;
+
+        //! Mask band of the source.
+        GDALRasterBand *poMaskBand = nullptr;
+    };
+
+    //! Cache from dataset name to dataset handle and properties.
     //! Note that the dataset objects are ultimately GDALProxyPoolDataset,
     //! and that the GDALProxyPoolDataset limits the number of simultaneously
     //! opened real datasets (controlled by GDAL_MAX_DATASET_POOL_SIZE). Hence 500 is not too big.
-    lru11::Cache<std::string, std::shared_ptr<GDALDataset>> m_oMapSharedSources{
-        500};
+    lru11::Cache<std::string, std::shared_ptr<SharedSource>>
+        m_oMapSharedSources{500};
+
+    //! Entry of the in-memory snapshot of the tile index.
+    struct IndexSnapshotEntry
+    {
+        //! Tile name, as stored in the index, and then made absolute once
+        //! the tile has been used.
+        std::string osTileName{};
+
+        //! Whether osTileName has been made absolute.
+        bool bTileNameResolved = false;
+
+        //! Envelope of the footprint.
+        OGREnvelope sEnvelope{};
+
+        //! Footprint, only stored when it is not its own envelope.
+        std::unique_ptr<OGRGeometry> poGeom{};
+    };
+
+    //! Whether the in-memory snapshot of the tile index has been attempted.
+    bool m_bIndexSnapshotTried = false;
+
+    //! In-memory snapshot of the tile index, sorted by increasing priority.
+    std::vector<IndexSnapshotEntry> m_aoIndexSnapshot{};
+
+    //! Quad tree of the index of m_aoIndexSnapshot[] entries.
+    CPLQuadTree *m_hIndexSnapshotQuadTree = nullptr;
+
+    //! Build the in-memory snapshot of the tile index, if it is small enough.
+    void BuildIndexSnapshot();
+
+    //! Release the in-memory snapshot of the tile index.
+    void ClearIndexSnapshot();
 
     //! Mask band (e.g. for JPEG compressed + mask band)
     std::unique_ptr<GDALTileIndexBand> m_poMaskBand{};
@@ -288,6 +359,8 @@ class GDALTileIndexDataset final : public GDALPamDataset
         std::unique_ptr<VRTSimpleSource> poSource{};
 
         //! OGRFeature corresponding to the source in the tile index.
+        //! Null when the source comes from the in-memory index snapshot, in
+        //! which case osName is already set.
         std::unique_ptr<OGRFeature> poFeature{};
 
         //! Work buffer containing the value of the mask band for the current pixel query.
@@ -2151,6 +2224,7 @@ CPLErr GDALTileIndexDataset::FlushCache(bool bAtClosing)
     // change the content of a source and would want the GTI dataset to see
     // the refreshed content.
     m_oMapSharedSources.clear();
+    ClearIndexSnapshot();
     m_dfLastMinXFilter = std::numeric_limits<double>::quiet_NaN();
     m_dfLastMinYFilter = std::numeric_limits<double>::quiet_NaN();
     m_dfLastMaxXFilter = std::numeric_limits<double>::quiet_NaN();
@@ -2697,10 +2771,10 @@ GDALTileIndexDataset::GetSourcesMoreRecentThan(int64_t mTime)
 bool GDALTileIndexDataset::GetSourceDesc(const std::string &osTileName,
                                          SourceDesc &oSourceDesc)
 {
-    std::shared_ptr<GDALDataset> poTileDS;
-    if (!m_oMapSharedSources.tryGet(osTileName, poTileDS))
+    std::shared_ptr<SharedSource> poShared;
+    if (!m_oMapSharedSources.tryGet(osTileName, poShared))
     {
-        poTileDS = std::shared_ptr<GDALDataset>(
+        auto poTileDS = std::shared_ptr<GDALDataset>(
             GDALProxyPoolDataset::Create(
                 osTileName.c_str(), nullptr, GA_ReadOnly,
                 /* bShared = */ true, m_osUniqueHandle.c_str()),
@@ -2831,82 +2905,100 @@ bool GDALTileIndexDataset::GetSourceDesc(const std::string &osTileName,
             poTileDS.reset(poWarpDS.release());
         }
 
-        m_oMapSharedSources.insert(osTileName, poTileDS);
+        // Compute once for all the properties of the source that do not
+        // depend on the pixel request.
+        poShared = std::make_shared<SharedSource>();
+        double adfGeoTransformTile[6];
+        poShared->bHasGeoTransform =
+            poTileDS->GetGeoTransform(adfGeoTransformTile) == CE_None;
+        if (poShared->bHasGeoTransform)
+        {
+            const int nBandCount = poTileDS->GetRasterCount();
+            for (int iBand = 0; iBand < nBandCount; ++iBand)
+            {
+                auto poTileBand = poTileDS->GetRasterBand(iBand + 1);
+                int bThisBandHasNoData = false;
+                const double dfThisBandNoDataValue =
+                    poTileBand->GetNoDataValue(&bThisBandHasNoData);
+                if (bThisBandHasNoData)
+                {
+                    poShared->bHasNoData = true;
+                    poShared->dfNoDataValue = dfThisBandNoDataValue;
+                }
+                if (iBand > 0 &&
+                    (static_cast<int>(bThisBandHasNoData) !=
+                         static_cast<int>(poShared->bHasNoData) ||
+                     (poShared->bHasNoData &&
+                      !IsSameNaNAware(poShared->dfNoDataValue,
+                                      dfThisBandNoDataValue))))
+                {
+                    poShared->bSameNoData = false;
+                }
+
+                if (poTileBand->GetMaskFlags() == GMF_PER_DATASET)
+                    poShared->poMaskBand = poTileBand->GetMaskBand();
+                else if (poTileBand->GetColorInterpretation() ==
+                         GCI_AlphaBand)
+                    poShared->poMaskBand = poTileBand;
+            }
+
+            poShared->bIntersects = GetSrcDstWin(
+                adfGeoTransformTile, poTileDS->GetRasterXSize(),
+                poTileDS->GetRasterYSize(), m_adfGeoTransform.data(),
+                GetRasterXSize(), GetRasterYSize(), &poShared->dfSrcXOff,
+                &poShared->dfSrcYOff, &poShared->dfSrcXSize,
+                &poShared->dfSrcYSize, &poShared->dfDstXOff,
+                &poShared->dfDstYOff, &poShared->dfDstXSize,
+                &poShared->dfDstYSize);
+        }
+        poShared->poDS = std::move(poTileDS);
+
+        m_oMapSharedSources.insert(osTileName, poShared);
     }
 
-    double adfGeoTransformTile[6];
-    if (poTileDS->GetGeoTransform(adfGeoTransformTile) != CE_None)
+    if (!poShared->bHasGeoTransform)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "%s lacks geotransform",
                  osTileName.c_str());
         return false;
     }
 
-    bool bHasNoData = false;
-    bool bSameNoData = true;
-    double dfNoDataValue = 0;
-    GDALRasterBand *poMaskBand = nullptr;
-    const int nBandCount = poTileDS->GetRasterCount();
-    for (int iBand = 0; iBand < nBandCount; ++iBand)
+    if (!poShared->bIntersects)
     {
-        auto poTileBand = poTileDS->GetRasterBand(iBand + 1);
-        int bThisBandHasNoData = false;
-        const double dfThisBandNoDataValue =
-            poTileBand->GetNoDataValue(&bThisBandHasNoData);
-        if (bThisBandHasNoData)
-        {
-            bHasNoData = true;
-            dfNoDataValue = dfThisBandNoDataValue;
-        }
-        if (iBand > 0 &&
-            (static_cast<int>(bThisBandHasNoData) !=
-                 static_cast<int>(bHasNoData) ||
-             (bHasNoData &&
-              !IsSameNaNAware(dfNoDataValue, dfThisBandNoDataValue))))
-        {
-            bSameNoData = false;
-        }
-
-        if (poTileBand->GetMaskFlags() == GMF_PER_DATASET)
-            poMaskBand = poTileBand->GetMaskBand();
-        else if (poTileBand->GetColorInterpretation() == GCI_AlphaBand)
-            poMaskBand = poTileBand;
+        // Should not happen on a consistent tile index
+        CPLDebug("VRT", "Tile %s does not actually intersect area of interest",
+                 osTileName.c_str());
+        return false;
     }
 
     std::unique_ptr<VRTSimpleSource> poSource;
-    if (!bHasNoData)
+    if (!poShared->bHasNoData)
     {
         poSource = std::make_unique<VRTSimpleSource>();
     }
     else
     {
         auto poComplexSource = std::make_unique<VRTComplexSource>();
-        poComplexSource->SetNoDataValue(dfNoDataValue);
+        poComplexSource->SetNoDataValue(poShared->dfNoDataValue);
         poSource = std::move(poComplexSource);
     }
-
-    if (!GetSrcDstWin(adfGeoTransformTile, poTileDS->GetRasterXSize(),
-                      poTileDS->GetRasterYSize(), m_adfGeoTransform.data(),
-                      GetRasterXSize(), GetRasterYSize(),
-                      &poSource->m_dfSrcXOff, &poSource->m_dfSrcYOff,
-                      &poSource->m_dfSrcXSize, &poSource->m_dfSrcYSize,
-                      &poSource->m_dfDstXOff, &poSource->m_dfDstYOff,
-                      &poSource->m_dfDstXSize, &poSource->m_dfDstYSize))
-    {
-        // Should not happen on a consistent tile index
-        CPLDebug("VRT", "Tile %s does not actually intersect area of interest",
-                 osTileName.c_str());
-        return false;
-    }
+    poSource->m_dfSrcXOff = poShared->dfSrcXOff;
+    poSource->m_dfSrcYOff = poShared->dfSrcYOff;
+    poSource->m_dfSrcXSize = poShared->dfSrcXSize;
+    poSource->m_dfSrcYSize = poShared->dfSrcYSize;
+    poSource->m_dfDstXOff = poShared->dfDstXOff;
+    poSource->m_dfDstYOff = poShared->dfDstYOff;
+    poSource->m_dfDstXSize = poShared->dfDstXSize;
+    poSource->m_dfDstYSize = poShared->dfDstYSize;
 
     oSourceDesc.osName = osTileName;
-    oSourceDesc.poDS = std::move(poTileDS);
+    oSourceDesc.poDS = poShared->poDS;
     oSourceDesc.poSource = std::move(poSource);
-    oSourceDesc.bHasNoData = bHasNoData;
-    oSourceDesc.bSameNoData = bSameNoData;
-    if (bSameNoData)
-        oSourceDesc.dfSameNoData = dfNoDataValue;
-    oSourceDesc.poMaskBand = poMaskBand;
+    oSourceDesc.bHasNoData = poShared->bHasNoData;
+    oSourceDesc.bSameNoData = poShared->bSameNoData;
+    if (poShared->bSameNoData)
+        oSourceDesc.dfSameNoData = poShared->dfNoDataValue;
+    oSourceDesc.poMaskBand = poShared->poMaskBand;
     return true;
 }
 
@@ -2935,38 +3027,100 @@ bool GDALTileIndexDataset::CollectSources(double dfXOff, double dfYOff,
     m_dfLastMaxXFilter = dfMaxX;
     m_dfLastMaxYFilter = dfMaxY;
 
-    m_poLayer->SetSpatialFilterRect(dfMinX, dfMinY, dfMaxX, dfMaxY);
-    m_poLayer->ResetReading();
+    if (!m_bIndexSnapshotTried)
+        BuildIndexSnapshot();
 
     m_aoSourceDesc.clear();
-    while (true)
+    if (m_hIndexSnapshotQuadTree)
     {
-        auto poFeature =
-            std::unique_ptr<OGRFeature>(m_poLayer->GetNextFeature());
-        if (!poFeature)
-            break;
-        if (!poFeature->IsFieldSetAndNotNull(m_nLocationFieldIndex))
+        CPLRectObj sAOI;
+        sAOI.minx = dfMinX;
+        sAOI.miny = dfMinY;
+        sAOI.maxx = dfMaxX;
+        sAOI.maxy = dfMaxY;
+        int nFeatureCount = 0;
+        void **pahRet =
+            CPLQuadTreeSearch(m_hIndexSnapshotQuadTree, &sAOI, &nFeatureCount);
+        std::vector<size_t> anIndices;
+        anIndices.reserve(nFeatureCount);
+        for (int i = 0; i < nFeatureCount; ++i)
         {
-            continue;
+            anIndices.push_back(static_cast<size_t>(
+                reinterpret_cast<uintptr_t>(pahRet[i])));
         }
+        CPLFree(pahRet);
 
-        SourceDesc oSourceDesc;
-        oSourceDesc.poFeature = std::move(poFeature);
-        m_aoSourceDesc.emplace_back(std::move(oSourceDesc));
+        // Snapshot entries are stored by increasing priority
+        std::sort(anIndices.begin(), anIndices.end());
 
-        if (m_aoSourceDesc.size() > 10 * 1000 * 1000)
+        std::unique_ptr<OGRPolygon> poAOI;
+        for (const size_t nIdx : anIndices)
         {
-            // Safety belt...
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "More than 10 million contributing sources to a "
-                     "single RasterIO() request is not supported");
-            return false;
+            auto &oEntry = m_aoIndexSnapshot[nIdx];
+            if (oEntry.poGeom)
+            {
+                if (!poAOI)
+                {
+                    auto poRing = std::make_unique<OGRLinearRing>();
+                    poRing->addPoint(dfMinX, dfMinY);
+                    poRing->addPoint(dfMinX, dfMaxY);
+                    poRing->addPoint(dfMaxX, dfMaxY);
+                    poRing->addPoint(dfMaxX, dfMinY);
+                    poRing->addPoint(dfMinX, dfMinY);
+                    poAOI = std::make_unique<OGRPolygon>();
+                    poAOI->addRingDirectly(poRing.release());
+                }
+                if (!oEntry.poGeom->Intersects(poAOI.get()))
+                    continue;
+            }
+
+            if (!oEntry.bTileNameResolved)
+            {
+                oEntry.osTileName =
+                    GetAbsoluteFileName(oEntry.osTileName.c_str(),
+                                        GetDescription());
+                oEntry.bTileNameResolved = true;
+            }
+
+            SourceDesc oSourceDesc;
+            oSourceDesc.osName = oEntry.osTileName;
+            m_aoSourceDesc.emplace_back(std::move(oSourceDesc));
         }
     }
-
-    if (m_aoSourceDesc.size() > 1)
+    else
     {
-        SortSourceDesc();
+        m_poLayer->SetSpatialFilterRect(dfMinX, dfMinY, dfMaxX, dfMaxY);
+        m_poLayer->ResetReading();
+
+        while (true)
+        {
+            auto poFeature =
+                std::unique_ptr<OGRFeature>(m_poLayer->GetNextFeature());
+            if (!poFeature)
+                break;
+            if (!poFeature->IsFieldSetAndNotNull(m_nLocationFieldIndex))
+            {
+                continue;
+            }
+
+            SourceDesc oSourceDesc;
+            oSourceDesc.poFeature = std::move(poFeature);
+            m_aoSourceDesc.emplace_back(std::move(oSourceDesc));
+
+            if (m_aoSourceDesc.size() > 10 * 1000 * 1000)
+            {
+                // Safety belt...
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "More than 10 million contributing sources to a "
+                         "single RasterIO() request is not supported");
+                return false;
+            }
+        }
+
+        if (m_aoSourceDesc.size() > 1)
+        {
+            SortSourceDesc();
+        }
     }
 
     // Try to find the last (most prioritary) fully opaque source covering
@@ -2976,10 +3130,11 @@ bool GDALTileIndexDataset::CollectSources(double dfXOff, double dfYOff,
     {
         --i;
         auto &poFeature = m_aoSourceDesc[i].poFeature;
-        const char *pszTileName =
-            poFeature->GetFieldAsString(m_nLocationFieldIndex);
         const std::string osTileName(
-            GetAbsoluteFileName(pszTileName, GetDescription()));
+            poFeature ? GetAbsoluteFileName(
+                            poFeature->GetFieldAsString(m_nLocationFieldIndex),
+                            GetDescription())
+                      : m_aoSourceDesc[i].osName);
 
         SourceDesc oSourceDesc;
         if (!GetSourceDesc(osTileName, oSourceDesc))
@@ -3036,6 +3191,153 @@ bool GDALTileIndexDataset::CollectSources(double dfXOff, double dfYOff,
     return true;
 }
 
+/************************************************************************/
+/*                        BuildIndexSnapshot()                          */
+/************************************************************************/
+
+// Load the footprints and tile names of the index in memory, so that
+// CollectSources() does not need to go through a spatial filter and feature
+// fetching on the tile index layer for each pixel request.
+void GDALTileIndexDataset::BuildIndexSnapshot()
+{
+    m_bIndexSnapshotTried = true;
+
+    const GIntBig nMaxFeatures = std::strtoll(
+        CPLGetConfigOption("GTI_INDEX_SNAPSHOT_MAX_FEATURES", "100000"),
+        nullptr, 10);
+    if (nMaxFeatures <= 0 ||
+        m_poLayer->GetFeatureCount(/* bForce = */ false) > nMaxFeatures)
+    {
+        return;
+    }
+
+    m_poLayer->SetSpatialFilter(nullptr);
+    m_poLayer->ResetReading();
+
+    m_aoSourceDesc.clear();
+    while (true)
+    {
+        auto poFeature =
+            std::unique_ptr<OGRFeature>(m_poLayer->GetNextFeature());
+        if (!poFeature)
+            break;
+        if (!poFeature->IsFieldSetAndNotNull(m_nLocationFieldIndex))
+            continue;
+        const auto poGeom = poFeature->GetGeometryRef();
+        if (!poGeom || poGeom->IsEmpty())
+            continue;
+
+        if (static_cast<GIntBig>(m_aoSourceDesc.size()) >= nMaxFeatures)
+        {
+            CPLDebug("VRT",
+                     "More than " CPL_FRMT_GIB " features in tile index. "
+                     "Not building in-memory snapshot",
+                     nMaxFeatures);
+            m_aoSourceDesc.clear();
+            return;
+        }
+
+        SourceDesc oSourceDesc;
+        oSourceDesc.poFeature = std::move(poFeature);
+        m_aoSourceDesc.emplace_back(std::move(oSourceDesc));
+    }
+
+    if (m_aoSourceDesc.size() > 1)
+    {
+        SortSourceDesc();
+    }
+
+    m_aoIndexSnapshot.reserve(m_aoSourceDesc.size());
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = std::numeric_limits<double>::max();
+    sGlobalBounds.miny = std::numeric_limits<double>::max();
+    sGlobalBounds.maxx = -std::numeric_limits<double>::max();
+    sGlobalBounds.maxy = -std::numeric_limits<double>::max();
+    for (auto &oSourceDesc : m_aoSourceDesc)
+    {
+        IndexSnapshotEntry oEntry;
+        oEntry.osTileName =
+            oSourceDesc.poFeature->GetFieldAsString(m_nLocationFieldIndex);
+        auto poGeom = oSourceDesc.poFeature->StealGeometry();
+        poGeom->getEnvelope(&oEntry.sEnvelope);
+
+        // Only keep the footprint if it is not a rectangle, in which case
+        // the envelope test is not sufficient.
+        bool bIsRectangle = false;
+        if (wkbFlatten(poGeom->getGeometryType()) == wkbPolygon)
+        {
+            const auto poPoly = poGeom->toPolygon();
+            const auto poRing = poPoly->getExteriorRing();
+            if (poPoly->getNumInteriorRings() == 0 && poRing &&
+                poRing->getNumPoints() == 5)
+            {
+                bIsRectangle = true;
+                for (int i = 0; i < 5; ++i)
+                {
+                    const double dfX = poRing->getX(i);
+                    const double dfY = poRing->getY(i);
+                    if ((dfX != oEntry.sEnvelope.MinX &&
+                         dfX != oEntry.sEnvelope.MaxX) ||
+                        (dfY != oEntry.sEnvelope.MinY &&
+                         dfY != oEntry.sEnvelope.MaxY))
+                    {
+                        bIsRectangle = false;
+                        break;
+                    }
+                }
+            }
+        }
+        if (!bIsRectangle)
+            oEntry.poGeom.reset(poGeom);
+        else
+            delete poGeom;
+
+        sGlobalBounds.minx =
+            std::min(sGlobalBounds.minx, oEntry.sEnvelope.MinX);
+        sGlobalBounds.miny =
+            std::min(sGlobalBounds.miny, oEntry.sEnvelope.MinY);
+        sGlobalBounds.maxx =
+            std::max(sGlobalBounds.maxx, oEntry.sEnvelope.MaxX);
+        sGlobalBounds.maxy =
+            std::max(sGlobalBounds.maxy, oEntry.sEnvelope.MaxY);
+
+        m_aoIndexSnapshot.emplace_back(std::move(oEntry));
+    }
+    m_aoSourceDesc.clear();
+
+    if (m_aoIndexSnapshot.empty())
+        return;
+
+    m_hIndexSnapshotQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+    for (size_t i = 0; i < m_aoIndexSnapshot.size(); ++i)
+    {
+        const auto &sEnvelope = m_aoIndexSnapshot[i].sEnvelope;
+        CPLRectObj sBounds;
+        sBounds.minx = sEnvelope.MinX;
+        sBounds.miny = sEnvelope.MinY;
+        sBounds.maxx = sEnvelope.MaxX;
+        sBounds.maxy = sEnvelope.MaxY;
+        CPLQuadTreeInsertWithBounds(
+            m_hIndexSnapshotQuadTree,
+            reinterpret_cast<void *>(static_cast<uintptr_t>(i)), &sBounds);
+    }
+}
+
+/************************************************************************/
+/*                        ClearIndexSnapshot()                          */
+/************************************************************************/
+
+void GDALTileIndexDataset::ClearIndexSnapshot()
+{
+    if (m_hIndexSnapshotQuadTree)
+    {
+        CPLQuadTreeDestroy(m_hIndexSnapshotQuadTree);
+        m_hIndexSnapshotQuadTree = nullptr;
+    }
+    m_aoIndexSnapshot.clear();
+    m_bIndexSnapshotTried = false;
+}
+
 /************************************************************************/
 /*                          SortSourceDesc()                            */
 /************************************************************************/
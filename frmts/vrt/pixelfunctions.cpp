@@ -30,8 +30,10 @@
 #include <cmath>
 #include "gdal.h"
 #include "vrtdataset.h"
+#include "vrt_priv.h"
 
 #include <limits>
+#include <vector>
 
 template <typename T>
 inline double GetSrcVal(const void *pSource, GDALDataType eSrcType, T ii)
@@ -77,6 +79,87 @@ inline double GetSrcVal(const void *pSource, GDALDataType eSrcType, T ii)
     return 0;
 }
 
+/************************************************************************/
+/*                          DispatchSrcLine()                           */
+/************************************************************************/
+
+// The functions below let pixel functions for real data types work on a
+// whole line at once: f() is instantiated for each source data type, so that
+// its loop over pixels has no per-pixel type switch and can be vectorized,
+// and the result line is written with a single GDALCopyWords() call.
+
+/** Calls f with a pointer, typed after eSrcType, to the nOffset-th pixel of
+ * a buffer of a non-complex data type. */
+template <class F>
+static void DispatchSrcLine(const void *pSource, GDALDataType eSrcType,
+                            size_t nOffset, F &&f)
+{
+    switch (eSrcType)
+    {
+        case GDT_Byte:
+            f(static_cast<const GByte *>(pSource) + nOffset);
+            break;
+        case GDT_Int8:
+            f(static_cast<const GInt8 *>(pSource) + nOffset);
+            break;
+        case GDT_UInt16:
+            f(static_cast<const GUInt16 *>(pSource) + nOffset);
+            break;
+        case GDT_Int16:
+            f(static_cast<const GInt16 *>(pSource) + nOffset);
+            break;
+        case GDT_UInt32:
+            f(static_cast<const GUInt32 *>(pSource) + nOffset);
+            break;
+        case GDT_Int32:
+            f(static_cast<const GInt32 *>(pSource) + nOffset);
+            break;
+        case GDT_UInt64:
+            f(static_cast<const uint64_t *>(pSource) + nOffset);
+            break;
+        case GDT_Int64:
+            f(static_cast<const int64_t *>(pSource) + nOffset);
+            break;
+        case GDT_Float32:
+            f(static_cast<const float *>(pSource) + nOffset);
+            break;
+        case GDT_Float64:
+            f(static_cast<const double *>(pSource) + nOffset);
+            break;
+        case GDT_Unknown:
+        case GDT_CInt16:
+        case GDT_CInt32:
+        case GDT_CFloat32:
+        case GDT_CFloat64:
+        case GDT_TypeCount:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/** Converts nXSize pixels of a non-complex buffer to double */
+static void GetSrcLine(const void *pSource, GDALDataType eSrcType,
+                       size_t nOffset, int nXSize, double *padfLine)
+{
+    DispatchSrcLine(pSource, eSrcType, nOffset,
+                    [padfLine, nXSize](auto pSrc)
+                    {
+                        for (int iCol = 0; iCol < nXSize; ++iCol)
+                            padfLine[iCol] = static_cast<double>(pSrc[iCol]);
+                    });
+}
+
+/** Writes a line of doubles to the iLine-th line of the output buffer */
+static void SetDstLine(const double *padfLine, void *pData, int iLine,
+                       int nXSize, GDALDataType eBufType, int nPixelSpace,
+                       int nLineSpace)
+{
+    GDALCopyWords(padfLine, GDT_Float64, static_cast<int>(sizeof(double)),
+                  static_cast<GByte *>(pData) +
+                      static_cast<GSpacing>(nLineSpace) * iLine,
+                  eBufType, nPixelSpace, nXSize);
+}
+
 static CPLErr FetchDoubleArg(CSLConstList papszArgs, const char *pszName,
                              double *pdfX, double *pdfDefault = nullptr)
 {
@@ -543,26 +626,26 @@ static CPLErr SumPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
+        std::vector<double> adfSum(nXSize);
+        double *const padfSum = adfSum.data();
         for (int iLine = 0; iLine < nYSize; ++iLine)
         {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
-            {
-                double dfSum = dfK;  // Not complex.
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            std::fill(adfSum.begin(), adfSum.end(), dfK);  // Not complex.
 
-                for (int iSrc = 0; iSrc < nSources; ++iSrc)
-                {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfSum += GetSrcVal(papoSources[iSrc], eSrcType, ii);
-                }
-
-                GDALCopyWords(&dfSum, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
+            for (int iSrc = 0; iSrc < nSources; ++iSrc)
+            {
+                DispatchSrcLine(
+                    papoSources[iSrc], eSrcType, nOffset,
+                    [padfSum, nXSize](auto pSrc)
+                    {
+                        for (int iCol = 0; iCol < nXSize; ++iCol)
+                            padfSum[iCol] += static_cast<double>(pSrc[iCol]);
+                    });
             }
+
+            SetDstLine(padfSum, pData, iLine, nXSize, eBufType, nPixelSpace,
+                       nLineSpace);
         }
     }
 
@@ -612,23 +695,21 @@ static CPLErr DiffPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
+        std::vector<double> adfLine(2 * static_cast<size_t>(nXSize));
+        double *const padfLeft = adfLine.data();
+        double *const padfRight = padfLeft + nXSize;
         for (int iLine = 0; iLine < nYSize; ++iLine)
         {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
-            {
-                // Source raster pixels may be obtained with GetSrcVal macro.
-                // Not complex.
-                const double dfPixVal =
-                    GetSrcVal(papoSources[0], eSrcType, ii) -
-                    GetSrcVal(papoSources[1], eSrcType, ii);
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            GetSrcLine(papoSources[0], eSrcType, nOffset, nXSize, padfLeft);
+            GetSrcLine(papoSources[1], eSrcType, nOffset, nXSize, padfRight);
 
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
+            // Not complex.
+            for (int iCol = 0; iCol < nXSize; ++iCol)
+                padfLeft[iCol] -= padfRight[iCol];
+
+            SetDstLine(padfLeft, pData, iLine, nXSize, eBufType, nPixelSpace,
+                       nLineSpace);
         }
     }
 
@@ -697,26 +778,26 @@ static CPLErr MulPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
+        std::vector<double> adfPixVal(nXSize);
+        double *const padfPixVal = adfPixVal.data();
         for (int iLine = 0; iLine < nYSize; ++iLine)
         {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
-            {
-                double dfPixVal = dfK;  // Not complex.
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            std::fill(adfPixVal.begin(), adfPixVal.end(), dfK);  // Not complex.
 
-                for (int iSrc = 0; iSrc < nSources; ++iSrc)
-                {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfPixVal *= GetSrcVal(papoSources[iSrc], eSrcType, ii);
-                }
-
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
+            for (int iSrc = 0; iSrc < nSources; ++iSrc)
+            {
+                DispatchSrcLine(
+                    papoSources[iSrc], eSrcType, nOffset,
+                    [padfPixVal, nXSize](auto pSrc)
+                    {
+                        for (int iCol = 0; iCol < nXSize; ++iCol)
+                            padfPixVal[iCol] *= static_cast<double>(pSrc[iCol]);
+                    });
             }
+
+            SetDstLine(padfPixVal, pData, iLine, nXSize, eBufType, nPixelSpace,
+                       nLineSpace);
         }
     }
 
@@ -776,23 +857,25 @@ static CPLErr DivPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
+        std::vector<double> adfLine(2 * static_cast<size_t>(nXSize));
+        double *const padfLeft = adfLine.data();
+        double *const padfRight = padfLeft + nXSize;
         for (int iLine = 0; iLine < nYSize; ++iLine)
         {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
-            {
-                const double dfVal = GetSrcVal(papoSources[1], eSrcType, ii);
-                double dfPixVal =
-                    dfVal == 0
-                        ? std::numeric_limits<double>::infinity()
-                        : GetSrcVal(papoSources[0], eSrcType, ii) / dfVal;
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            GetSrcLine(papoSources[0], eSrcType, nOffset, nXSize, padfLeft);
+            GetSrcLine(papoSources[1], eSrcType, nOffset, nXSize, padfRight);
 
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
+            for (int iCol = 0; iCol < nXSize; ++iCol)
+            {
+                const double dfVal = padfRight[iCol];
+                padfLeft[iCol] = dfVal == 0
+                                     ? std::numeric_limits<double>::infinity()
+                                     : padfLeft[iCol] / dfVal;
             }
+
+            SetDstLine(padfLeft, pData, iLine, nXSize, eBufType, nPixelSpace,
+                       nLineSpace);
         }
     }
 
@@ -1402,21 +1485,22 @@ static CPLErr ReplaceNoDataPixelFunc(void **papoSources, int nSources,
     }
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
+    std::vector<double> adfPixVal(nXSize);
+    double *const padfPixVal = adfPixVal.data();
     for (int iLine = 0; iLine < nYSize; ++iLine)
     {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        GetSrcLine(papoSources[0], eSrcType, nOffset, nXSize, padfPixVal);
+
+        for (int iCol = 0; iCol < nXSize; ++iCol)
         {
-            double dfPixVal = GetSrcVal(papoSources[0], eSrcType, ii);
+            const double dfPixVal = padfPixVal[iCol];
             if (dfPixVal == dfOldNoData || std::isnan(dfPixVal))
-                dfPixVal = dfNewNoData;
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
+                padfPixVal[iCol] = dfNewNoData;
         }
+
+        SetDstLine(padfPixVal, pData, iLine, nXSize, eBufType, nPixelSpace,
+                   nLineSpace);
     }
 
     /* ---- Return success ---- */
@@ -1451,20 +1535,22 @@ static CPLErr ScalePixelFunc(void **papoSources, int nSources, void *pData,
         return CE_Failure;
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
+    std::vector<double> adfPixVal(nXSize);
+    double *const padfPixVal = adfPixVal.data();
     for (int iLine = 0; iLine < nYSize; ++iLine)
     {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
-        {
-            const double dfPixVal =
-                GetSrcVal(papoSources[0], eSrcType, ii) * dfScale + dfOffset;
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        DispatchSrcLine(
+            papoSources[0], eSrcType, nOffset,
+            [padfPixVal, nXSize, dfScale, dfOffset](auto pSrc)
+            {
+                for (int iCol = 0; iCol < nXSize; ++iCol)
+                    padfPixVal[iCol] =
+                        static_cast<double>(pSrc[iCol]) * dfScale + dfOffset;
+            });
 
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
+        SetDstLine(padfPixVal, pData, iLine, nXSize, eBufType, nPixelSpace,
+                   nLineSpace);
     }
 
     /* ---- Return success ---- */
@@ -1488,26 +1574,29 @@ static CPLErr NormDiffPixelFunc(void **papoSources, int nSources, void *pData,
     }
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
+    std::vector<double> adfLine(2 * static_cast<size_t>(nXSize));
+    double *const padfLeft = adfLine.data();
+    double *const padfRight = padfLeft + nXSize;
     for (int iLine = 0; iLine < nYSize; ++iLine)
     {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        GetSrcLine(papoSources[0], eSrcType, nOffset, nXSize, padfLeft);
+        GetSrcLine(papoSources[1], eSrcType, nOffset, nXSize, padfRight);
+
+        for (int iCol = 0; iCol < nXSize; ++iCol)
         {
-            const double dfLeftVal = GetSrcVal(papoSources[0], eSrcType, ii);
-            const double dfRightVal = GetSrcVal(papoSources[1], eSrcType, ii);
+            const double dfLeftVal = padfLeft[iCol];
+            const double dfRightVal = padfRight[iCol];
 
             const double dfDenom = (dfLeftVal + dfRightVal);
 
-            const double dfPixVal =
-                dfDenom == 0 ? std::numeric_limits<double>::infinity()
-                             : (dfLeftVal - dfRightVal) / dfDenom;
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
+            padfLeft[iCol] = dfDenom == 0
+                                 ? std::numeric_limits<double>::infinity()
+                                 : (dfLeftVal - dfRightVal) / dfDenom;
         }
+
+        SetDstLine(padfLeft, pData, iLine, nXSize, eBufType, nPixelSpace,
+                   nLineSpace);
     }
 
     /* ---- Return success ---- */
@@ -1550,42 +1639,58 @@ static CPLErr MinOrMaxPixelFunc(void **papoSources, int nSources, void *pData,
         CSLFetchNameValueDef(papszArgs, "propagateNoData", "false"));
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
+    std::vector<double> adfRes(nXSize);
+    double *const padfRes = adfRes.data();
+    // Whether a nodata source pixel has been propagated to the result
+    std::vector<GByte> abyNoDataFound(nXSize);
+    GByte *const pabyNoDataFound = abyNoDataFound.data();
     for (int iLine = 0; iLine < nYSize; ++iLine)
     {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
-        {
-            double dfRes = std::numeric_limits<double>::quiet_NaN();
-
-            for (int iSrc = 0; iSrc < nSources; ++iSrc)
-            {
-                const double dfVal = GetSrcVal(papoSources[iSrc], eSrcType, ii);
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        std::fill(adfRes.begin(), adfRes.end(),
+                  std::numeric_limits<double>::quiet_NaN());
+        std::fill(abyNoDataFound.begin(), abyNoDataFound.end(), 0);
 
-                if (std::isnan(dfVal) || dfVal == dfNoData)
+        for (int iSrc = 0; iSrc < nSources; ++iSrc)
+        {
+            DispatchSrcLine(
+                papoSources[iSrc], eSrcType, nOffset,
+                [padfRes, pabyNoDataFound, nXSize, dfNoData,
+                 bPropagateNoData](auto pSrc)
                 {
-                    if (bPropagateNoData)
+                    for (int iCol = 0; iCol < nXSize; ++iCol)
                     {
-                        dfRes = dfNoData;
-                        break;
+                        if (pabyNoDataFound[iCol])
+                            continue;
+
+                        const double dfVal = static_cast<double>(pSrc[iCol]);
+                        if (std::isnan(dfVal) || dfVal == dfNoData)
+                        {
+                            if (bPropagateNoData)
+                            {
+                                padfRes[iCol] = dfNoData;
+                                pabyNoDataFound[iCol] = 1;
+                            }
+                        }
+                        else if (Comparator::compare(dfVal, padfRes[iCol]))
+                        {
+                            padfRes[iCol] = dfVal;
+                        }
                     }
-                }
-                else if (Comparator::compare(dfVal, dfRes))
-                {
-                    dfRes = dfVal;
-                }
-            }
+                });
+        }
 
-            if (!bPropagateNoData && std::isnan(dfRes))
+        if (!bPropagateNoData)
+        {
+            for (int iCol = 0; iCol < nXSize; ++iCol)
             {
-                dfRes = dfNoData;
+                if (std::isnan(padfRes[iCol]))
+                    padfRes[iCol] = dfNoData;
             }
-
-            GDALCopyWords(&dfRes, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
         }
+
+        SetDstLine(padfRes, pData, iLine, nXSize, eBufType, nPixelSpace,
+                   nLineSpace);
     }
 
     /* ---- Return success ---- */
@@ -1696,6 +1801,9 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
  *                      exponential interpolation
  * - "scale": Apply the RasterBand metadata values of "offset" and "scale"
  * - "nan": Convert incoming NoData values to IEEE 754 nan
+ * - "expression": evaluate the band-math expression passed in the
+ *                 ``expression`` argument, where sources are referenced as
+ *                 B1, B2, ... (e.g. ``(B2 - B1) / (B2 + B1)``)
  *
  * @see GDALAddDerivedBandPixelFunc
  *
@@ -1749,5 +1857,7 @@ CPLErr GDALRegisterDefaultPixelFunc()
                                         pszMinMaxFuncMetadataNodata);
     GDALAddDerivedBandPixelFuncWithArgs("max", MaxPixelFunc,
                                         pszMinMaxFuncMetadataNodata);
+    GDALAddDerivedBandPixelFuncWithArgs("expression", VRTExpressionPixelFunc,
+                                        VRT_EXPRESSION_PIXEL_FUNC_METADATA);
     return CE_None;
 }
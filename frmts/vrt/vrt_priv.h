@@ -57,6 +57,13 @@ CPLStringList VRTParseCategoryNames(const CPLXMLNode *psCategoryNames);
 std::unique_ptr<GDALColorTable>
 VRTParseColorTable(const CPLXMLNode *psColorTable);
 
+extern const char *const VRT_EXPRESSION_PIXEL_FUNC_METADATA;
+
+CPLErr VRTExpressionPixelFunc(void **papoSources, int nSources, void *pData,
+                              int nXSize, int nYSize, GDALDataType eSrcType,
+                              GDALDataType eBufType, int nPixelSpace,
+                              int nLineSpace, CSLConstList papszArgs);
+
 #endif
 
 #endif  // VRT_PRIV_H_INCLUDED
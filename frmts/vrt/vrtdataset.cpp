@@ -2352,13 +2352,75 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand *poBand =
             static_cast<VRTSourcedRasterBand *>(papoBands[nBands - 1]);
-        for (int iSource = 0; eErr == CE_None && iSource < poBand->nSources;
-             iSource++)
+
+        // Restrict to the sources intersecting the request window when
+        // there are many of them.
+        std::vector<int> anCandidateSources;
+        const bool bUseSourcesIndex = poBand->GetSourcesIntersecting(
+            nXOff, nYOff, nXSize, nYSize, psExtraArg, anCandidateSources);
+        const int nCandidateSources =
+            bUseSourcesIndex ? static_cast<int>(anCandidateSources.size())
+                             : poBand->nSources;
+
+        // Read the sources in parallel if asked to
+        const int nThreads =
+            nCandidateSources > 1
+                ? VRTSourcedRasterBand::GetNumThreadsForSources()
+                : 1;
+        if (nThreads > 1)
+        {
+            std::vector<VRTSourcedRasterBand::SourceJob> aoJobs;
+            bool bCanRunJobs = true;
+            for (int iCandidate = 0; iCandidate < nCandidateSources;
+                 iCandidate++)
+            {
+                const int iSource = bUseSourcesIndex
+                                        ? anCandidateSources[iCandidate]
+                                        : iCandidate;
+                VRTSourcedRasterBand::SourceJob oJob;
+                const int nRet = VRTSourcedRasterBand::InitSourceJob(
+                    poBand->papoSources[iSource], nXOff, nYOff, nXSize,
+                    nYSize, nBufXSize, nBufYSize, psExtraArg, pData, oJob);
+                if (nRet < 0)
+                {
+                    bCanRunJobs = false;
+                    break;
+                }
+                if (nRet == 0)
+                    continue;
+
+                VRTSimpleSource *poSource = cpl::down_cast<VRTSimpleSource *>(
+                    poBand->papoSources[iSource]);
+                const GDALDataType eVRTDataType = poBand->GetRasterDataType();
+                GDALRasterIOExtraArg sExtraArg;
+                GDALCopyRasterIOExtraArg(&sExtraArg, psExtraArg);
+                sExtraArg.pfnProgress = nullptr;
+                sExtraArg.pProgressData = nullptr;
+                oJob.fnRead = [=](VRTSource::WorkingState &) mutable
+                {
+                    return poSource->DatasetRasterIO(
+                        eVRTDataType, nXOff, nYOff, nXSize, nYSize, pData,
+                        nBufXSize, nBufYSize, eBufType, nBandCount, panBandMap,
+                        nPixelSpace, nLineSpace, nBandSpace, &sExtraArg);
+                };
+                aoJobs.push_back(std::move(oJob));
+            }
+            if (bCanRunJobs && aoJobs.size() > 1)
+            {
+                return VRTSourcedRasterBand::RunSourceJobs(
+                    aoJobs, nThreads, pfnProgressGlobal, pProgressDataGlobal);
+            }
+        }
+        for (int iCandidate = 0;
+             eErr == CE_None && iCandidate < nCandidateSources; iCandidate++)
         {
+            const int iSource = bUseSourcesIndex
+                                    ? anCandidateSources[iCandidate]
+                                    : iCandidate;
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData = GDALCreateScaledProgress(
-                1.0 * iSource / poBand->nSources,
-                1.0 * (iSource + 1) / poBand->nSources, pfnProgressGlobal,
+                1.0 * iCandidate / nCandidateSources,
+                1.0 * (iCandidate + 1) / nCandidateSources, pfnProgressGlobal,
                 pProgressDataGlobal);
 
             VRTSimpleSource *poSource =
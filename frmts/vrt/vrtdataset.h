@@ -35,6 +35,7 @@
 
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -662,6 +663,16 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     char **m_papszSourceList = nullptr;
     int m_nSkipBufferInitialization = -1;
 
+    // Spatial index over the destination windows of the sources, lazily
+    // built when there are many of them. m_nSourcesIndexed and
+    // m_papoSourcesIndexed record the state of papoSources at build time.
+    CPLQuadTree *m_hSourcesIndex = nullptr;
+    std::vector<int> m_anSourcesNotIndexed{};
+    int m_nSourcesIndexed = 0;
+    VRTSource **m_papoSourcesIndexed = nullptr;
+
+    void BuildSourcesIndex();
+
     bool CanUseSourcesMinMaxImplementations();
 
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
@@ -778,6 +789,40 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
         GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
         int nBufXSize, int nBufYSize, GDALRasterIOExtraArg *psExtraArg) const;
 
+    /** Read of a source, as scheduled by RunSourceJobs() */
+    struct SourceJob
+    {
+        //! Reads the source, with a working state private to the job.
+        std::function<CPLErr(VRTSource::WorkingState &)> fnRead{};
+        //! Buffer written by the job, and window of it in pixels.
+        const void *pDstBuffer = nullptr;
+        int nDstXOff = 0;
+        int nDstYOff = 0;
+        int nDstXSize = 0;
+        int nDstYSize = 0;
+        //! Jobs with the same key read the same dataset.
+        std::string osDatasetKey{};
+    };
+
+    static int GetNumThreadsForSources();
+    static int InitSourceJob(VRTSource *poSource, int nXOff, int nYOff,
+                             int nXSize, int nYSize, int nBufXSize,
+                             int nBufYSize,
+                             const GDALRasterIOExtraArg *psExtraArg,
+                             const void *pData, SourceJob &oJob);
+    static CPLErr RunSourceJobs(std::vector<SourceJob> &aoJobs, int nThreads,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressData);
+    static void DestroySourceJobThreadPool();
+
+    /** Minimum number of sources from which a spatial index is used */
+    static constexpr int SOURCES_INDEX_THRESHOLD = 64;
+
+    void InvalidateSourcesIndex();
+    bool GetSourcesIntersecting(int nXOff, int nYOff, int nXSize, int nYSize,
+                                const GDALRasterIOExtraArg *psExtraArg,
+                                std::vector<int> &anSources);
+
     virtual CPLErr IReadBlock(int, int, void *) override;
 
     virtual void GetFileList(char ***ppapszFileList, int *pnSize,
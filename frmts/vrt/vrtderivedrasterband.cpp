@@ -1123,22 +1123,77 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
                              nRasterYSize - nYOffExt);
     }
 
-    // Load values for sources into packed buffers.
+    // Load values for sources into packed buffers, in parallel if asked to.
+    // As each source has its own buffer, only sources reading the same
+    // dataset need to be read sequentially.
     CPLErr eErr = CE_None;
+    bool bSourcesRead = false;
+    const int nThreads = nBufferCount > 1 ? GetNumThreadsForSources() : 1;
+    if (nThreads > 1)
+    {
+        std::vector<SourceJob> aoJobs;
+        bool bCanRunJobs = true;
+        for (int iBuffer = 0; iBuffer < nBufferCount; iBuffer++)
+        {
+            VRTSource *poSource =
+                papoSources[anMapBufferIdxToSourceIdx[iBuffer]];
+            GByte *pabyBuffer =
+                static_cast<GByte *>(pBuffers[iBuffer]) +
+                (nYShiftInBuffer * nExtBufXSize + nXShiftInBuffer) *
+                    nSrcTypeSize;
+            SourceJob oJob;
+            const int nRet = InitSourceJob(
+                poSource, nXOffExt, nYOffExt, nXSizeExt, nYSizeExt,
+                nExtBufXSizeReq, nExtBufYSizeReq, &sExtraArg, pabyBuffer, oJob);
+            if (nRet < 0)
+            {
+                bCanRunJobs = false;
+                break;
+            }
+            if (nRet == 0)
+                continue;
+
+            GDALRasterIOExtraArg sJobExtraArg;
+            GDALCopyRasterIOExtraArg(&sJobExtraArg, &sExtraArg);
+            sJobExtraArg.pfnProgress = nullptr;
+            sJobExtraArg.pProgressData = nullptr;
+            oJob.fnRead = [=](VRTSource::WorkingState &oWorkingState) mutable
+            {
+                return poSource->RasterIO(
+                    eSrcType, nXOffExt, nYOffExt, nXSizeExt, nYSizeExt,
+                    pabyBuffer, nExtBufXSizeReq, nExtBufYSizeReq, eSrcType,
+                    nSrcTypeSize,
+                    static_cast<GSpacing>(nSrcTypeSize) * nExtBufXSize,
+                    &sJobExtraArg, oWorkingState);
+            };
+            aoJobs.push_back(std::move(oJob));
+        }
+        if (bCanRunJobs)
+        {
+            eErr = RunSourceJobs(aoJobs, nThreads, nullptr, nullptr);
+            bSourcesRead = true;
+        }
+    }
+
     VRTSource::WorkingState oWorkingState;
     for (int iBuffer = 0; iBuffer < nBufferCount && eErr == CE_None; iBuffer++)
     {
         const int iSource = anMapBufferIdxToSourceIdx[iBuffer];
         GByte *pabyBuffer = static_cast<GByte *>(pBuffers[iBuffer]);
-        eErr = static_cast<VRTSource *>(papoSources[iSource])
-                   ->RasterIO(
-                       eSrcType, nXOffExt, nYOffExt, nXSizeExt, nYSizeExt,
-                       pabyBuffer +
-                           (nYShiftInBuffer * nExtBufXSize + nXShiftInBuffer) *
-                               nSrcTypeSize,
-                       nExtBufXSizeReq, nExtBufYSizeReq, eSrcType, nSrcTypeSize,
-                       static_cast<GSpacing>(nSrcTypeSize) * nExtBufXSize,
-                       &sExtraArg, oWorkingState);
+        if (!bSourcesRead)
+        {
+            eErr = static_cast<VRTSource *>(papoSources[iSource])
+                       ->RasterIO(eSrcType, nXOffExt, nYOffExt, nXSizeExt,
+                                  nYSizeExt,
+                                  pabyBuffer + (nYShiftInBuffer * nExtBufXSize +
+                                                nXShiftInBuffer) *
+                                                   nSrcTypeSize,
+                                  nExtBufXSizeReq, nExtBufYSizeReq, eSrcType,
+                                  nSrcTypeSize,
+                                  static_cast<GSpacing>(nSrcTypeSize) *
+                                      nExtBufXSize,
+                                  &sExtraArg, oWorkingState);
+        }
 
         // Extend first lines
         for (int iY = 0; iY < nYShiftInBuffer; iY++)
@@ -59,6 +59,7 @@ VRTDriver::~VRTDriver()
 {
     CSLDestroy(papszSourceParsers);
     VRTDerivedRasterBand::Cleanup();
+    VRTSourcedRasterBand::DestroySourceJobThreadPool();
 #if 0
     if(  pDeserializerData )
     {
@@ -0,0 +1,1235 @@
+/******************************************************************************
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Band-math expressions compiled once and evaluated on chunks of
+ *           pixels, for the "expression" pixel function of derived bands.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "vrt_priv.h"
+#include "vrtdataset.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_mem_cache.h"
+#include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+/*! @cond Doxygen_Suppress */
+
+// Syntax of the expressions, by increasing precedence:
+//
+//   expr    := or ( '?' expr ':' expr )?
+//   or      := and ( '||' and )*
+//   and     := eq ( '&&' eq )*
+//   eq      := rel ( ( '==' | '!=' ) rel )*
+//   rel     := add ( ( '<' | '<=' | '>' | '>=' ) add )*
+//   add     := mul ( ( '+' | '-' ) mul )*
+//   mul     := unary ( ( '*' | '/' | '%' ) unary )*
+//   unary   := ( '-' | '+' | '!' ) unary | power
+//   power   := primary ( '^' unary )?
+//   primary := number | 'B' index | 'pi' | 'nan' | function '(' args ')'
+//              | '(' expr ')'
+//
+// Sources are referenced as B1, B2, ... in their declaration order.
+// Evaluation is done in double precision. A NaN value stands for nodata:
+// source pixels equal to the NoData value of the band are loaded as NaN,
+// NaN propagates through operators, comparisons and conditions, and a NaN
+// result is written as the NoData value of the band.
+
+namespace
+{
+
+// Number of pixels processed by each instruction at once.
+constexpr int CHUNK_SIZE = 256;
+
+enum class Op
+{
+    LoadSource,
+    LoadConst,
+
+    // Unary
+    Neg,
+    Not,
+    Abs,
+    Sqrt,
+    Exp,
+    Log,
+    Log10,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Floor,
+    Ceil,
+    Round,
+    IsNan,
+
+    // Binary
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Pow,
+    Atan2,
+    Min,
+    Max,
+    Lt,
+    Le,
+    Gt,
+    Ge,
+    Eq,
+    Ne,
+    And,
+    Or,
+
+    // Ternary
+    Select,
+};
+
+static bool IsUnary(Op eOp)
+{
+    return eOp >= Op::Neg && eOp <= Op::IsNan;
+}
+
+static bool IsBinary(Op eOp)
+{
+    return eOp >= Op::Add && eOp <= Op::Or;
+}
+
+/************************************************************************/
+/*                             Operators                                */
+/************************************************************************/
+
+// Operators are written as functors so that the same code is used for
+// constant folding and for the vectorized evaluation loops.
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+#define UNARY_OP(Name, expr)                                                   \
+    struct Name##Op                                                            \
+    {                                                                          \
+        static inline double eval(double a)                                    \
+        {                                                                      \
+            return expr;                                                       \
+        }                                                                      \
+    };
+
+#define BINARY_OP(Name, expr)                                                  \
+    struct Name##Op                                                            \
+    {                                                                          \
+        static inline double eval(double a, double b)                          \
+        {                                                                      \
+            return expr;                                                       \
+        }                                                                      \
+    };
+
+// Operators returning a boolean value propagate NaN (nodata) operands.
+#define BOOLEAN_BINARY_OP(Name, expr)                                          \
+    BINARY_OP(Name, (std::isnan(a) || std::isnan(b)) ? NaN                     \
+                                                     : ((expr) ? 1.0 : 0.0))
+
+UNARY_OP(Neg, -a)
+UNARY_OP(Not, std::isnan(a) ? NaN : (a == 0 ? 1.0 : 0.0))
+UNARY_OP(Abs, std::fabs(a))
+UNARY_OP(Sqrt, std::sqrt(a))
+UNARY_OP(Exp, std::exp(a))
+UNARY_OP(Log, std::log(a))
+UNARY_OP(Log10, std::log10(a))
+UNARY_OP(Sin, std::sin(a))
+UNARY_OP(Cos, std::cos(a))
+UNARY_OP(Tan, std::tan(a))
+UNARY_OP(Asin, std::asin(a))
+UNARY_OP(Acos, std::acos(a))
+UNARY_OP(Atan, std::atan(a))
+UNARY_OP(Floor, std::floor(a))
+UNARY_OP(Ceil, std::ceil(a))
+UNARY_OP(Round, std::round(a))
+UNARY_OP(IsNan, std::isnan(a) ? 1.0 : 0.0)
+
+BINARY_OP(Add, a + b)
+BINARY_OP(Sub, a - b)
+BINARY_OP(Mul, a * b)
+BINARY_OP(Div, a / b)
+BINARY_OP(Mod, std::fmod(a, b))
+BINARY_OP(Pow, std::pow(a, b))
+BINARY_OP(Atan2, std::atan2(a, b))
+BINARY_OP(Min, (std::isnan(a) || std::isnan(b)) ? NaN : (b < a ? b : a))
+BINARY_OP(Max, (std::isnan(a) || std::isnan(b)) ? NaN : (b > a ? b : a))
+BOOLEAN_BINARY_OP(Lt, a < b)
+BOOLEAN_BINARY_OP(Le, a <= b)
+BOOLEAN_BINARY_OP(Gt, a > b)
+BOOLEAN_BINARY_OP(Ge, a >= b)
+BOOLEAN_BINARY_OP(Eq, a == b)
+BOOLEAN_BINARY_OP(Ne, a != b)
+BOOLEAN_BINARY_OP(And, a != 0 && b != 0)
+BOOLEAN_BINARY_OP(Or, a != 0 || b != 0)
+
+#undef UNARY_OP
+#undef BINARY_OP
+#undef BOOLEAN_BINARY_OP
+
+static inline double SelectEval(double c, double a, double b)
+{
+    return std::isnan(c) ? NaN : (c != 0 ? a : b);
+}
+
+/** Calls f with the functor of a unary operator */
+template <class F> static void DispatchUnary(Op eOp, F &&f)
+{
+    switch (eOp)
+    {
+        case Op::Neg:
+            f(NegOp());
+            break;
+        case Op::Not:
+            f(NotOp());
+            break;
+        case Op::Abs:
+            f(AbsOp());
+            break;
+        case Op::Sqrt:
+            f(SqrtOp());
+            break;
+        case Op::Exp:
+            f(ExpOp());
+            break;
+        case Op::Log:
+            f(LogOp());
+            break;
+        case Op::Log10:
+            f(Log10Op());
+            break;
+        case Op::Sin:
+            f(SinOp());
+            break;
+        case Op::Cos:
+            f(CosOp());
+            break;
+        case Op::Tan:
+            f(TanOp());
+            break;
+        case Op::Asin:
+            f(AsinOp());
+            break;
+        case Op::Acos:
+            f(AcosOp());
+            break;
+        case Op::Atan:
+            f(AtanOp());
+            break;
+        case Op::Floor:
+            f(FloorOp());
+            break;
+        case Op::Ceil:
+            f(CeilOp());
+            break;
+        case Op::Round:
+            f(RoundOp());
+            break;
+        case Op::IsNan:
+            f(IsNanOp());
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/** Calls f with the functor of a binary operator */
+template <class F> static void DispatchBinary(Op eOp, F &&f)
+{
+    switch (eOp)
+    {
+        case Op::Add:
+            f(AddOp());
+            break;
+        case Op::Sub:
+            f(SubOp());
+            break;
+        case Op::Mul:
+            f(MulOp());
+            break;
+        case Op::Div:
+            f(DivOp());
+            break;
+        case Op::Mod:
+            f(ModOp());
+            break;
+        case Op::Pow:
+            f(PowOp());
+            break;
+        case Op::Atan2:
+            f(Atan2Op());
+            break;
+        case Op::Min:
+            f(MinOp());
+            break;
+        case Op::Max:
+            f(MaxOp());
+            break;
+        case Op::Lt:
+            f(LtOp());
+            break;
+        case Op::Le:
+            f(LeOp());
+            break;
+        case Op::Gt:
+            f(GtOp());
+            break;
+        case Op::Ge:
+            f(GeOp());
+            break;
+        case Op::Eq:
+            f(EqOp());
+            break;
+        case Op::Ne:
+            f(NeOp());
+            break;
+        case Op::And:
+            f(AndOp());
+            break;
+        case Op::Or:
+            f(OrOp());
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                          Parsed expression                           */
+/************************************************************************/
+
+struct ExprNode
+{
+    Op eOp = Op::LoadConst;
+    int nSource = 0;  // 0-based index, for Op::LoadSource
+    double dfConst = 0;
+    //! Depth of the tree rooted at this node
+    int nDepth = 1;
+    std::vector<std::unique_ptr<ExprNode>> apoChildren{};
+
+    static std::unique_ptr<ExprNode> Const(double dfVal)
+    {
+        auto poNode = std::make_unique<ExprNode>();
+        poNode->dfConst = dfVal;
+        return poNode;
+    }
+
+    static std::unique_ptr<ExprNode>
+    Make(Op eOpIn, std::unique_ptr<ExprNode> poA,
+         std::unique_ptr<ExprNode> poB = nullptr,
+         std::unique_ptr<ExprNode> poC = nullptr)
+    {
+        auto poNode = std::make_unique<ExprNode>();
+        poNode->eOp = eOpIn;
+        poNode->apoChildren.push_back(std::move(poA));
+        if (poB)
+            poNode->apoChildren.push_back(std::move(poB));
+        if (poC)
+            poNode->apoChildren.push_back(std::move(poC));
+        for (const auto &poChild : poNode->apoChildren)
+            poNode->nDepth = std::max(poNode->nDepth, poChild->nDepth + 1);
+        return poNode;
+    }
+};
+
+/************************************************************************/
+/*                           ExprParser                                 */
+/************************************************************************/
+
+class ExprParser
+{
+    //! Maximum length of an expression
+    static constexpr size_t MAX_EXPR_LENGTH = 100 * 1000;
+    //! Maximum nesting level of parenthesized expressions, function
+    //! arguments and unary operators, which bounds the recursion of the parser
+    static constexpr int MAX_NESTING_LEVEL = 256;
+    //! Maximum depth of the expression tree, which bounds the recursion of
+    //! ExprProgram::FoldConstants(), ExprProgram::Emit() and ~ExprNode()
+    static constexpr int MAX_TREE_DEPTH = 1000;
+
+    const char *const m_pszExpr;
+    const char *m_pszCur;
+    std::string m_osError{};
+    int m_nNestingLevel = 0;
+
+    /** Increments the nesting level during its lifetime */
+    struct NestingLevelIncrementer
+    {
+        ExprParser &m_oParser;
+
+        explicit NestingLevelIncrementer(ExprParser &oParser)
+            : m_oParser(oParser)
+        {
+            ++m_oParser.m_nNestingLevel;
+        }
+
+        ~NestingLevelIncrementer()
+        {
+            --m_oParser.m_nNestingLevel;
+        }
+
+        CPL_DISALLOW_COPY_ASSIGN(NestingLevelIncrementer)
+    };
+
+    void SkipSpaces()
+    {
+        while (isspace(static_cast<unsigned char>(*m_pszCur)))
+            ++m_pszCur;
+    }
+
+    bool Accept(const char *pszToken)
+    {
+        SkipSpaces();
+        const size_t nLen = strlen(pszToken);
+        if (strncmp(m_pszCur, pszToken, nLen) != 0)
+            return false;
+        // Do not take the prefix of a two-character operator
+        if (nLen == 1 && (*pszToken == '<' || *pszToken == '>' ||
+                          *pszToken == '!' || *pszToken == '=') &&
+            m_pszCur[1] == '=')
+            return false;
+        m_pszCur += nLen;
+        return true;
+    }
+
+    std::unique_ptr<ExprNode> Error(const std::string &osMsg)
+    {
+        if (m_osError.empty())
+        {
+            m_osError = CPLSPrintf("%s at offset %d of '%s'", osMsg.c_str(),
+                                   static_cast<int>(m_pszCur - m_pszExpr),
+                                   m_pszExpr);
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<ExprNode> MakeNode(Op eOp, std::unique_ptr<ExprNode> poA,
+                                       std::unique_ptr<ExprNode> poB = nullptr,
+                                       std::unique_ptr<ExprNode> poC = nullptr)
+    {
+        auto poNode = ExprNode::Make(eOp, std::move(poA), std::move(poB),
+                                     std::move(poC));
+        if (poNode->nDepth > MAX_TREE_DEPTH)
+            return Error("Too complex expression");
+        return poNode;
+    }
+
+    std::unique_ptr<ExprNode> ParseExpr();
+    std::unique_ptr<ExprNode> ParseOr();
+    std::unique_ptr<ExprNode> ParseAnd();
+    std::unique_ptr<ExprNode> ParseEquality();
+    std::unique_ptr<ExprNode> ParseRelational();
+    std::unique_ptr<ExprNode> ParseAdditive();
+    std::unique_ptr<ExprNode> ParseMultiplicative();
+    std::unique_ptr<ExprNode> ParseUnary();
+    std::unique_ptr<ExprNode> ParsePower();
+    std::unique_ptr<ExprNode> ParsePrimary();
+    std::unique_ptr<ExprNode> ParseFunction(const std::string &osName);
+
+    CPL_DISALLOW_COPY_ASSIGN(ExprParser)
+
+  public:
+    explicit ExprParser(const char *pszExpr)
+        : m_pszExpr(pszExpr), m_pszCur(pszExpr)
+    {
+    }
+
+    std::unique_ptr<ExprNode> Parse()
+    {
+        if (strlen(m_pszExpr) > MAX_EXPR_LENGTH)
+            return Error("Too long expression");
+        auto poNode = ParseExpr();
+        SkipSpaces();
+        if (poNode && *m_pszCur != '\0')
+            return Error("Unexpected character");
+        return poNode;
+    }
+
+    const std::string &GetError() const
+    {
+        return m_osError;
+    }
+};
+
+std::unique_ptr<ExprNode> ExprParser::ParseExpr()
+{
+    NestingLevelIncrementer oIncrementer(*this);
+    if (m_nNestingLevel > MAX_NESTING_LEVEL)
+        return Error("Too deeply nested expression");
+
+    auto poCond = ParseOr();
+    if (!poCond)
+        return nullptr;
+    if (!Accept("?"))
+        return poCond;
+    auto poA = ParseExpr();
+    if (!poA)
+        return nullptr;
+    if (!Accept(":"))
+        return Error("':' expected");
+    auto poB = ParseExpr();
+    if (!poB)
+        return nullptr;
+    return MakeNode(Op::Select, std::move(poCond), std::move(poA),
+                    std::move(poB));
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseOr()
+{
+    auto poNode = ParseAnd();
+    while (poNode && Accept("||"))
+    {
+        auto poRight = ParseAnd();
+        if (!poRight)
+            return nullptr;
+        poNode = MakeNode(Op::Or, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseAnd()
+{
+    auto poNode = ParseEquality();
+    while (poNode && Accept("&&"))
+    {
+        auto poRight = ParseEquality();
+        if (!poRight)
+            return nullptr;
+        poNode = MakeNode(Op::And, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseEquality()
+{
+    auto poNode = ParseRelational();
+    while (poNode)
+    {
+        Op eOp;
+        if (Accept("=="))
+            eOp = Op::Eq;
+        else if (Accept("!="))
+            eOp = Op::Ne;
+        else
+            break;
+        auto poRight = ParseRelational();
+        if (!poRight)
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseRelational()
+{
+    auto poNode = ParseAdditive();
+    while (poNode)
+    {
+        Op eOp;
+        if (Accept("<="))
+            eOp = Op::Le;
+        else if (Accept(">="))
+            eOp = Op::Ge;
+        else if (Accept("<"))
+            eOp = Op::Lt;
+        else if (Accept(">"))
+            eOp = Op::Gt;
+        else
+            break;
+        auto poRight = ParseAdditive();
+        if (!poRight)
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseAdditive()
+{
+    auto poNode = ParseMultiplicative();
+    while (poNode)
+    {
+        Op eOp;
+        if (Accept("+"))
+            eOp = Op::Add;
+        else if (Accept("-"))
+            eOp = Op::Sub;
+        else
+            break;
+        auto poRight = ParseMultiplicative();
+        if (!poRight)
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseMultiplicative()
+{
+    auto poNode = ParseUnary();
+    while (poNode)
+    {
+        Op eOp;
+        if (Accept("*"))
+            eOp = Op::Mul;
+        else if (Accept("/"))
+            eOp = Op::Div;
+        else if (Accept("%"))
+            eOp = Op::Mod;
+        else
+            break;
+        auto poRight = ParseUnary();
+        if (!poRight)
+            return nullptr;
+        poNode = MakeNode(eOp, std::move(poNode), std::move(poRight));
+    }
+    return poNode;
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseUnary()
+{
+    NestingLevelIncrementer oIncrementer(*this);
+    if (m_nNestingLevel > MAX_NESTING_LEVEL)
+        return Error("Too deeply nested expression");
+
+    if (Accept("-"))
+    {
+        auto poNode = ParseUnary();
+        if (!poNode)
+            return nullptr;
+        return MakeNode(Op::Neg, std::move(poNode));
+    }
+    if (Accept("+"))
+        return ParseUnary();
+    if (Accept("!"))
+    {
+        auto poNode = ParseUnary();
+        if (!poNode)
+            return nullptr;
+        return MakeNode(Op::Not, std::move(poNode));
+    }
+    return ParsePower();
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParsePower()
+{
+    auto poNode = ParsePrimary();
+    if (poNode && Accept("^"))
+    {
+        // Right associative, and binds tighter than a unary minus on its
+        // left: -2^2 == -4, 2^-1 == 0.5
+        auto poExponent = ParseUnary();
+        if (!poExponent)
+            return nullptr;
+        poNode = MakeNode(Op::Pow, std::move(poNode), std::move(poExponent));
+    }
+    return poNode;
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParsePrimary()
+{
+    SkipSpaces();
+    const char chFirst = *m_pszCur;
+
+    if (Accept("("))
+    {
+        auto poNode = ParseExpr();
+        if (!poNode)
+            return nullptr;
+        if (!Accept(")"))
+            return Error("')' expected");
+        return poNode;
+    }
+
+    if (isdigit(static_cast<unsigned char>(chFirst)) || chFirst == '.')
+    {
+        char *pszEnd = nullptr;
+        const double dfVal = CPLStrtod(m_pszCur, &pszEnd);
+        if (pszEnd == m_pszCur)
+            return Error("Invalid number");
+        m_pszCur = pszEnd;
+        return ExprNode::Const(dfVal);
+    }
+
+    if (isalpha(static_cast<unsigned char>(chFirst)) || chFirst == '_')
+    {
+        const char *pszStart = m_pszCur;
+        while (isalnum(static_cast<unsigned char>(*m_pszCur)) ||
+               *m_pszCur == '_')
+            ++m_pszCur;
+        const std::string osName(pszStart, m_pszCur - pszStart);
+
+        if ((osName[0] == 'B' || osName[0] == 'b') && osName.size() > 1 &&
+            std::all_of(osName.begin() + 1, osName.end(),
+                        [](char c)
+                        { return isdigit(static_cast<unsigned char>(c)); }))
+        {
+            const int nIdx = atoi(osName.c_str() + 1);
+            if (nIdx < 1 || osName.size() > 6)
+            {
+                m_pszCur = pszStart;
+                return Error("Invalid source index");
+            }
+            auto poNode = std::make_unique<ExprNode>();
+            poNode->eOp = Op::LoadSource;
+            poNode->nSource = nIdx - 1;
+            return poNode;
+        }
+        if (EQUAL(osName.c_str(), "pi"))
+            return ExprNode::Const(M_PI);
+        if (EQUAL(osName.c_str(), "nan"))
+            return ExprNode::Const(NaN);
+
+        if (!Accept("("))
+        {
+            m_pszCur = pszStart;
+            return Error("Unknown identifier");
+        }
+        return ParseFunction(osName);
+    }
+
+    if (chFirst == '\0')
+        return Error("Unexpected end of expression");
+    return Error("Unexpected character");
+}
+
+std::unique_ptr<ExprNode> ExprParser::ParseFunction(const std::string &osName)
+{
+    std::vector<std::unique_ptr<ExprNode>> apoArgs;
+    if (!Accept(")"))
+    {
+        do
+        {
+            auto poArg = ParseExpr();
+            if (!poArg)
+                return nullptr;
+            apoArgs.push_back(std::move(poArg));
+        } while (Accept(","));
+        if (!Accept(")"))
+            return Error("')' expected");
+    }
+
+    static const struct
+    {
+        const char *pszName;
+        Op eOp;
+    } asUnaryFunctions[] = {
+        {"abs", Op::Abs},     {"sqrt", Op::Sqrt},   {"exp", Op::Exp},
+        {"log", Op::Log},     {"log10", Op::Log10}, {"sin", Op::Sin},
+        {"cos", Op::Cos},     {"tan", Op::Tan},     {"asin", Op::Asin},
+        {"acos", Op::Acos},   {"atan", Op::Atan},   {"floor", Op::Floor},
+        {"ceil", Op::Ceil},   {"round", Op::Round}, {"isnan", Op::IsNan},
+        {"isnodata", Op::IsNan},
+    };
+    for (const auto &sFunc : asUnaryFunctions)
+    {
+        if (EQUAL(osName.c_str(), sFunc.pszName))
+        {
+            if (apoArgs.size() != 1)
+                return Error(osName + "() expects one argument");
+            return MakeNode(sFunc.eOp, std::move(apoArgs[0]));
+        }
+    }
+
+    if (EQUAL(osName.c_str(), "pow") || EQUAL(osName.c_str(), "atan2") ||
+        EQUAL(osName.c_str(), "fmod"))
+    {
+        if (apoArgs.size() != 2)
+            return Error(osName + "() expects two arguments");
+        const Op eOp = EQUAL(osName.c_str(), "pow")     ? Op::Pow
+                       : EQUAL(osName.c_str(), "atan2") ? Op::Atan2
+                                                        : Op::Mod;
+        return MakeNode(eOp, std::move(apoArgs[0]), std::move(apoArgs[1]));
+    }
+
+    if (EQUAL(osName.c_str(), "min") || EQUAL(osName.c_str(), "max"))
+    {
+        if (apoArgs.size() < 2)
+            return Error(osName + "() expects at least two arguments");
+        const Op eOp = EQUAL(osName.c_str(), "min") ? Op::Min : Op::Max;
+        auto poNode = std::move(apoArgs[0]);
+        for (size_t i = 1; poNode && i < apoArgs.size(); ++i)
+            poNode = MakeNode(eOp, std::move(poNode), std::move(apoArgs[i]));
+        return poNode;
+    }
+
+    if (EQUAL(osName.c_str(), "if"))
+    {
+        if (apoArgs.size() != 3)
+            return Error("if() expects three arguments");
+        return MakeNode(Op::Select, std::move(apoArgs[0]),
+                        std::move(apoArgs[1]), std::move(apoArgs[2]));
+    }
+
+    return Error("Unknown function " + osName + "()");
+}
+
+/************************************************************************/
+/*                          ExprProgram                                 */
+/************************************************************************/
+
+struct ExprInstr
+{
+    Op eOp = Op::LoadConst;
+    int nSource = 0;
+    double dfConst = 0;
+};
+
+/** Expression compiled to a sequence of stack instructions, each working
+ * on CHUNK_SIZE pixels at once. */
+struct ExprProgram
+{
+    std::vector<ExprInstr> aoInstrs{};
+    //! Sorted indices of the sources referenced by the expression.
+    std::vector<int> anSources{};
+    int nMaxStackDepth = 0;
+
+    static std::shared_ptr<const ExprProgram> Compile(const char *pszExpr,
+                                                      std::string &osError);
+
+  private:
+    static void FoldConstants(ExprNode &oNode);
+    void Emit(const ExprNode &oNode, int &nDepth);
+};
+
+/** Replace sub-expressions whose operands are all constants by their value */
+void ExprProgram::FoldConstants(ExprNode &oNode)
+{
+    bool bAllConst = !oNode.apoChildren.empty();
+    for (auto &poChild : oNode.apoChildren)
+    {
+        FoldConstants(*poChild);
+        if (poChild->eOp != Op::LoadConst)
+            bAllConst = false;
+    }
+    if (!bAllConst)
+        return;
+
+    const auto &apoC = oNode.apoChildren;
+    double dfVal = 0;
+    if (IsUnary(oNode.eOp))
+    {
+        DispatchUnary(oNode.eOp, [&dfVal, &apoC](auto op)
+                      { dfVal = decltype(op)::eval(apoC[0]->dfConst); });
+    }
+    else if (IsBinary(oNode.eOp))
+    {
+        DispatchBinary(oNode.eOp,
+                       [&dfVal, &apoC](auto op)
+                       {
+                           dfVal = decltype(op)::eval(apoC[0]->dfConst,
+                                                      apoC[1]->dfConst);
+                       });
+    }
+    else
+    {
+        CPLAssert(oNode.eOp == Op::Select);
+        dfVal = SelectEval(apoC[0]->dfConst, apoC[1]->dfConst,
+                           apoC[2]->dfConst);
+    }
+    oNode.eOp = Op::LoadConst;
+    oNode.dfConst = dfVal;
+    oNode.apoChildren.clear();
+}
+
+void ExprProgram::Emit(const ExprNode &oNode, int &nDepth)
+{
+    for (const auto &poChild : oNode.apoChildren)
+        Emit(*poChild, nDepth);
+
+    ExprInstr oInstr;
+    oInstr.eOp = oNode.eOp;
+    oInstr.nSource = oNode.nSource;
+    oInstr.dfConst = oNode.dfConst;
+    aoInstrs.push_back(oInstr);
+
+    if (oNode.eOp == Op::LoadSource || oNode.eOp == Op::LoadConst)
+    {
+        ++nDepth;
+        nMaxStackDepth = std::max(nMaxStackDepth, nDepth);
+        if (oNode.eOp == Op::LoadSource &&
+            std::find(anSources.begin(), anSources.end(), oNode.nSource) ==
+                anSources.end())
+        {
+            anSources.push_back(oNode.nSource);
+        }
+    }
+    else
+    {
+        // Pops all operands, pushes the result
+        nDepth -= static_cast<int>(oNode.apoChildren.size()) - 1;
+    }
+}
+
+std::shared_ptr<const ExprProgram> ExprProgram::Compile(const char *pszExpr,
+                                                        std::string &osError)
+{
+    ExprParser oParser(pszExpr);
+    auto poRoot = oParser.Parse();
+    if (!poRoot)
+    {
+        osError = oParser.GetError();
+        return nullptr;
+    }
+
+    FoldConstants(*poRoot);
+
+    auto poProgram = std::make_shared<ExprProgram>();
+    int nDepth = 0;
+    poProgram->Emit(*poRoot, nDepth);
+    CPLAssert(nDepth == 1);
+    std::sort(poProgram->anSources.begin(), poProgram->anSources.end());
+    return poProgram;
+}
+
+/************************************************************************/
+/*                       GetCompiledExpression()                        */
+/************************************************************************/
+
+/** Return the program of an expression, compiling it on first use. */
+static std::shared_ptr<const ExprProgram>
+GetCompiledExpression(const char *pszExpr)
+{
+    static std::mutex oMutex;
+    static lru11::Cache<std::string, std::shared_ptr<const ExprProgram>>
+        oCache;
+
+    std::shared_ptr<const ExprProgram> poProgram;
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        if (oCache.tryGet(pszExpr, poProgram))
+            return poProgram;
+    }
+
+    std::string osError;
+    poProgram = ExprProgram::Compile(pszExpr, osError);
+    if (!poProgram)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression pixel function: %s", osError.c_str());
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> oLock(oMutex);
+    oCache.insert(pszExpr, poProgram);
+    return poProgram;
+}
+
+/************************************************************************/
+/*                          ExprEvalContext                             */
+/************************************************************************/
+
+struct ExprEvalContext
+{
+    const ExprProgram *poProgram = nullptr;
+    void **papoSources = nullptr;
+    GDALDataType eSrcType = GDT_Unknown;
+    void *pData = nullptr;
+    int nXSize = 0;
+    GDALDataType eBufType = GDT_Unknown;
+    int nPixelSpace = 0;
+    int nLineSpace = 0;
+    bool bHasNoData = false;
+    double dfNoData = 0;
+};
+
+struct ExprEvalJob
+{
+    const ExprEvalContext *psContext = nullptr;
+    int nYStart = 0;
+    int nYEnd = 0;
+};
+
+/** Evaluate the expression on lines [nYStart, nYEnd[ */
+static void EvaluateLines(const ExprEvalContext &sContext, int nYStart,
+                          int nYEnd)
+{
+    const ExprProgram &oProgram = *sContext.poProgram;
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(sContext.eSrcType);
+    const int nSrcCount = static_cast<int>(oProgram.anSources.size());
+
+    // Sources converted to double for the current chunk, followed by the
+    // evaluation stack.
+    std::vector<double> adfWork(
+        static_cast<size_t>(nSrcCount + oProgram.nMaxStackDepth) * CHUNK_SIZE);
+    double *const padfSources = adfWork.data();
+    double *const padfStack =
+        adfWork.data() + static_cast<size_t>(nSrcCount) * CHUNK_SIZE;
+
+    // Position of each referenced source in padfSources
+    std::vector<int> anSourceSlot(oProgram.anSources.empty()
+                                      ? 0
+                                      : oProgram.anSources.back() + 1,
+                                  -1);
+    for (int i = 0; i < nSrcCount; ++i)
+        anSourceSlot[oProgram.anSources[i]] = i;
+
+    for (int iLine = nYStart; iLine < nYEnd; ++iLine)
+    {
+        for (int iCol = 0; iCol < sContext.nXSize; iCol += CHUNK_SIZE)
+        {
+            const int n = std::min(CHUNK_SIZE, sContext.nXSize - iCol);
+            const size_t nOffset =
+                static_cast<size_t>(iLine) * sContext.nXSize + iCol;
+
+            for (int i = 0; i < nSrcCount; ++i)
+            {
+                double *padfDst = padfSources + i * CHUNK_SIZE;
+                GDALCopyWords(
+                    static_cast<const GByte *>(
+                        sContext.papoSources[oProgram.anSources[i]]) +
+                        nOffset * nSrcTypeSize,
+                    sContext.eSrcType, nSrcTypeSize, padfDst, GDT_Float64,
+                    static_cast<int>(sizeof(double)), n);
+                if (sContext.bHasNoData)
+                {
+                    const double dfNoData = sContext.dfNoData;
+                    for (int k = 0; k < n; ++k)
+                    {
+                        if (padfDst[k] == dfNoData)
+                            padfDst[k] = NaN;
+                    }
+                }
+            }
+
+            // Slot(i) is the i-th element from the bottom of the stack
+            const auto Slot = [padfStack](int i)
+            { return padfStack + static_cast<size_t>(i) * CHUNK_SIZE; };
+
+            int nDepth = 0;
+            for (const auto &oInstr : oProgram.aoInstrs)
+            {
+                switch (oInstr.eOp)
+                {
+                    case Op::LoadSource:
+                        memcpy(Slot(nDepth),
+                               padfSources +
+                                   anSourceSlot[oInstr.nSource] * CHUNK_SIZE,
+                               n * sizeof(double));
+                        ++nDepth;
+                        break;
+
+                    case Op::LoadConst:
+                        std::fill_n(Slot(nDepth), n, oInstr.dfConst);
+                        ++nDepth;
+                        break;
+
+                    case Op::Select:
+                    {
+                        double *const c = Slot(nDepth - 3);
+                        const double *const a = Slot(nDepth - 2);
+                        const double *const b = Slot(nDepth - 1);
+                        for (int k = 0; k < n; ++k)
+                            c[k] = SelectEval(c[k], a[k], b[k]);
+                        nDepth -= 2;
+                        break;
+                    }
+
+                    default:
+                        if (IsUnary(oInstr.eOp))
+                        {
+                            double *const a = Slot(nDepth - 1);
+                            DispatchUnary(oInstr.eOp,
+                                          [a, n](auto op)
+                                          {
+                                              for (int k = 0; k < n; ++k)
+                                                  a[k] = decltype(op)::eval(
+                                                      a[k]);
+                                          });
+                        }
+                        else
+                        {
+                            double *const a = Slot(nDepth - 2);
+                            const double *const b = Slot(nDepth - 1);
+                            DispatchBinary(oInstr.eOp,
+                                           [a, b, n](auto op)
+                                           {
+                                               for (int k = 0; k < n; ++k)
+                                                   a[k] = decltype(op)::eval(
+                                                       a[k], b[k]);
+                                           });
+                            --nDepth;
+                        }
+                        break;
+                }
+            }
+            CPLAssert(nDepth == 1);
+
+            double *const padfResult = Slot(0);
+            if (sContext.bHasNoData)
+            {
+                const double dfNoData = sContext.dfNoData;
+                for (int k = 0; k < n; ++k)
+                {
+                    if (std::isnan(padfResult[k]))
+                        padfResult[k] = dfNoData;
+                }
+            }
+
+            GDALCopyWords(padfResult, GDT_Float64,
+                          static_cast<int>(sizeof(double)),
+                          static_cast<GByte *>(sContext.pData) +
+                              static_cast<GSpacing>(sContext.nLineSpace) *
+                                  iLine +
+                              static_cast<GSpacing>(sContext.nPixelSpace) *
+                                  iCol,
+                          sContext.eBufType, sContext.nPixelSpace, n);
+        }
+    }
+}
+
+static void EvaluateLinesJob(void *pData)
+{
+    const auto psJob = static_cast<const ExprEvalJob *>(pData);
+    EvaluateLines(*(psJob->psContext), psJob->nYStart, psJob->nYEnd);
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                       VRTExpressionPixelFunc()                       */
+/************************************************************************/
+
+const char *const VRT_EXPRESSION_PIXEL_FUNC_METADATA =
+    "<PixelFunctionArgumentsList>"
+    "   <Argument name='expression' description='Expression to evaluate' "
+    "type='string' />"
+    "   <Argument type='builtin' value='NoData' optional='true' />"
+    "</PixelFunctionArgumentsList>";
+
+/** Pixel function evaluating the expression passed in the "expression"
+ * argument. Lines are split between threads when GDAL_NUM_THREADS is set. */
+CPLErr VRTExpressionPixelFunc(void **papoSources, int nSources, void *pData,
+                              int nXSize, int nYSize, GDALDataType eSrcType,
+                              GDALDataType eBufType, int nPixelSpace,
+                              int nLineSpace, CSLConstList papszArgs)
+{
+    const char *pszExpr = CSLFetchNameValue(papszArgs, "expression");
+    if (pszExpr == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Missing pixel function argument: expression");
+        return CE_Failure;
+    }
+
+    if (GDALDataTypeIsComplex(eSrcType))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Complex data type not supported for expression().");
+        return CE_Failure;
+    }
+
+    const auto poProgram = GetCompiledExpression(pszExpr);
+    if (!poProgram)
+        return CE_Failure;
+
+    if (!poProgram->anSources.empty() &&
+        poProgram->anSources.back() >= nSources)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression pixel function: B%d is referenced, but there "
+                 "are only %d source(s)",
+                 poProgram->anSources.back() + 1, nSources);
+        return CE_Failure;
+    }
+
+    ExprEvalContext sContext;
+    sContext.poProgram = poProgram.get();
+    sContext.papoSources = papoSources;
+    sContext.eSrcType = eSrcType;
+    sContext.pData = pData;
+    sContext.nXSize = nXSize;
+    sContext.eBufType = eBufType;
+    sContext.nPixelSpace = nPixelSpace;
+    sContext.nLineSpace = nLineSpace;
+    const char *pszNoData = CSLFetchNameValue(papszArgs, "NoData");
+    if (pszNoData)
+    {
+        sContext.bHasNoData = true;
+        sContext.dfNoData = CPLAtof(pszNoData);
+    }
+
+    // Do not bother with threads for small requests. This is evaluated
+    // sequentially when the band is read from a VRT source job, as
+    // GetNumThreadsForSources() then returns 1, so that a job never waits
+    // for other jobs.
+    constexpr int MIN_PIXELS_PER_JOB = 65536;
+    const int nThreads =
+        static_cast<GIntBig>(nXSize) * nYSize >= 2 * MIN_PIXELS_PER_JOB
+            ? VRTSourcedRasterBand::GetNumThreadsForSources()
+            : 1;
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (poPool == nullptr)
+    {
+        EvaluateLines(sContext, 0, nYSize);
+        return CE_None;
+    }
+
+    const int nLinesPerJob = std::max(
+        1, std::max(MIN_PIXELS_PER_JOB / std::max(1, nXSize),
+                    (nYSize + nThreads - 1) / nThreads));
+    std::vector<ExprEvalJob> asJobs;
+    for (int nY = 0; nY < nYSize; nY += nLinesPerJob)
+    {
+        ExprEvalJob sJob;
+        sJob.psContext = &sContext;
+        sJob.nYStart = nY;
+        sJob.nYEnd = std::min(nYSize, nY + nLinesPerJob);
+        asJobs.push_back(sJob);
+    }
+
+    auto poQueue = poPool->CreateJobQueue();
+    for (auto &sJob : asJobs)
+    {
+        if (!poQueue->SubmitJob(EvaluateLinesJob, &sJob))
+        {
+            // Evaluate synchronously what could not be submitted.
+            EvaluateLinesJob(&sJob);
+        }
+    }
+    poQueue->WaitCompletion();
+
+    return CE_None;
+}
+
+/*! @endcond */
@@ -39,18 +39,22 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"  // CPLErrorHandlerAccumulatorStruct
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
 #include "cpl_progress.h"
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_thread_pool.h"
@@ -130,6 +134,7 @@ VRTSourcedRasterBand::~VRTSourcedRasterBand()
 {
     VRTSourcedRasterBand::CloseDependentDatasets();
     CSLDestroy(m_papszSourceList);
+    InvalidateSourcesIndex();
 }
 
 /************************************************************************/
@@ -239,6 +244,422 @@ bool VRTSourcedRasterBand::CanIRasterIOBeForwardedToEachSource(
     return true;
 }
 
+/************************************************************************/
+/*                       GetNumThreadsForSources()                      */
+/************************************************************************/
+
+// Whether the current thread is running a source job. Sources read by a
+// job, such as nested VRTs, are then read sequentially, as waiting for jobs
+// from a job could deadlock once all the threads are busy.
+static thread_local bool gbInSourceJob = false;
+
+/** Returns the number of threads with which sources may be read, from the
+ * GDAL_NUM_THREADS configuration option. This is 1 when called from a
+ * source job. */
+int VRTSourcedRasterBand::GetNumThreadsForSources()
+{
+    if (gbInSourceJob)
+        return 1;
+    const char *pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszValue == nullptr)
+        return 1;
+    const int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    // 1024 to please Coverity
+    return std::max(1, std::min(nThreads, 1024));
+}
+
+/************************************************************************/
+/*                            InitSourceJob()                           */
+/************************************************************************/
+
+/** Fills the window written by a source in a RasterIO() request, and the key
+ * of the dataset it reads.
+ *
+ * The source is opened if needed, so that this is not done concurrently by
+ * the jobs.
+ *
+ * @return 1 if the source contributes to the request, 0 if it does not, and
+ * -1 if it cannot be read by a job (in which case the request must be
+ * processed sequentially).
+ */
+int VRTSourcedRasterBand::InitSourceJob(VRTSource *poSource, int nXOff,
+                                        int nYOff, int nXSize, int nYSize,
+                                        int nBufXSize, int nBufYSize,
+                                        const GDALRasterIOExtraArg *psExtraArg,
+                                        const void *pData, SourceJob &oJob)
+{
+    if (!poSource->IsSimpleSource())
+        return -1;
+    auto poSimpleSource = cpl::down_cast<VRTSimpleSource *>(poSource);
+
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
+    double dfReqXOff = 0.0;
+    double dfReqYOff = 0.0;
+    double dfReqXSize = 0.0;
+    double dfReqYSize = 0.0;
+    int nReqXOff = 0;
+    int nReqYOff = 0;
+    int nReqXSize = 0;
+    int nReqYSize = 0;
+    bool bError = false;
+    if (!poSimpleSource->GetSrcDstWindow(
+            dfXOff, dfYOff, dfXSize, dfYSize, nBufXSize, nBufYSize, &dfReqXOff,
+            &dfReqYOff, &dfReqXSize, &dfReqYSize, &nReqXOff, &nReqYOff,
+            &nReqXSize, &nReqYSize, &oJob.nDstXOff, &oJob.nDstYOff,
+            &oJob.nDstXSize, &oJob.nDstYSize, bError))
+    {
+        // Let the sequential code path report the error
+        return bError ? -1 : 0;
+    }
+
+    GDALRasterBand *poSrcBand = poSimpleSource->m_bGetMaskBand
+                                    ? poSimpleSource->GetMaskBandMainBand()
+                                    : poSimpleSource->GetRasterBand();
+    GDALDataset *poSrcDS = poSrcBand ? poSrcBand->GetDataset() : nullptr;
+    if (poSrcDS == nullptr)
+        return -1;
+
+    // Sources opened through the proxy pool share their underlying dataset
+    // when they have the same name. For the MEM driver, use the dataset
+    // pointer.
+    auto poDriver = poSrcDS->GetDriver();
+    if (poDriver && EQUAL(poDriver->GetDescription(), "MEM"))
+        oJob.osDatasetKey = CPLSPrintf("%p", poSrcDS);
+    else
+        oJob.osDatasetKey = poSrcDS->GetDescription();
+    oJob.pDstBuffer = pData;
+    return 1;
+}
+
+/************************************************************************/
+/*                            RunSourceJobs()                           */
+/************************************************************************/
+
+namespace
+{
+struct VRTSourceJobContext
+{
+    std::mutex oMutex{};
+    bool bSuccess = true;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+
+struct VRTSourceJobData
+{
+    VRTSourcedRasterBand::SourceJob *poJob = nullptr;
+    VRTSourceJobContext *psContext = nullptr;
+};
+}  // namespace
+
+// Source jobs run in their own pool rather than in GDALGetGlobalThreadPool(),
+// as the drivers reading the sources may themselves submit jobs to the
+// global pool and wait for them.
+static std::mutex goMutexSourceJobThreadPool;
+static std::unique_ptr<CPLWorkerThreadPool> gpoSourceJobThreadPool;
+
+static CPLWorkerThreadPool *GetSourceJobThreadPool(int nThreads)
+{
+    std::lock_guard<std::mutex> oLock(goMutexSourceJobThreadPool);
+    if (!gpoSourceJobThreadPool)
+    {
+        auto poThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (poThreadPool->Setup(nThreads, nullptr, nullptr, false))
+            gpoSourceJobThreadPool = std::move(poThreadPool);
+    }
+    else if (nThreads > gpoSourceJobThreadPool->GetThreadCount())
+    {
+        gpoSourceJobThreadPool->Setup(nThreads, nullptr, nullptr, false);
+    }
+    return gpoSourceJobThreadPool.get();
+}
+
+/** Destroys the thread pool in which sources are read. */
+void VRTSourcedRasterBand::DestroySourceJobThreadPool()
+{
+    std::lock_guard<std::mutex> oLock(goMutexSourceJobThreadPool);
+    gpoSourceJobThreadPool.reset();
+}
+
+static void CPL_STDCALL VRTSourceJobErrorHandler(CPLErr eErr,
+                                                 CPLErrorNum eErrorNum,
+                                                 const char *pszMsg)
+{
+    auto psContext =
+        static_cast<VRTSourceJobContext *>(CPLGetErrorHandlerUserData());
+    std::lock_guard<std::mutex> oLock(psContext->oMutex);
+    psContext->aoErrors.emplace_back(eErr, eErrorNum, pszMsg);
+}
+
+static void VRTSourceJobFunc(void *pData)
+{
+    auto psData = static_cast<VRTSourceJobData *>(pData);
+    auto psContext = psData->psContext;
+    {
+        std::lock_guard<std::mutex> oLock(psContext->oMutex);
+        if (!psContext->bSuccess)
+            return;
+    }
+
+    CPLErrorHandlerPusher oErrorHandler(VRTSourceJobErrorHandler, psContext);
+    CPLSetCurrentErrorHandlerCatchDebug(false);
+
+    // The job may run in the calling thread, which may itself be in a job
+    const bool bWasInSourceJob = gbInSourceJob;
+    gbInSourceJob = true;
+    VRTSource::WorkingState oWorkingState;
+    const CPLErr eErr = psData->poJob->fnRead(oWorkingState);
+    gbInSourceJob = bWasInSourceJob;
+    if (eErr != CE_None)
+    {
+        std::lock_guard<std::mutex> oLock(psContext->oMutex);
+        psContext->bSuccess = false;
+    }
+}
+
+/** Runs the reads of sources, in parallel when possible.
+ *
+ * The result is the same as running the jobs sequentially in order: a job
+ * only starts once all the previous jobs that write an overlapping window of
+ * the same buffer are completed. Jobs reading the same dataset are never run
+ * concurrently either, as a dataset handle cannot be used by several
+ * threads.
+ */
+CPLErr VRTSourcedRasterBand::RunSourceJobs(std::vector<SourceJob> &aoJobs,
+                                           int nThreads,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressData)
+{
+    // Assign each job to a "wave": jobs of the same wave are independent,
+    // and a job is in a later wave than all the previous jobs it conflicts
+    // with.
+    const size_t nJobs = aoJobs.size();
+    std::map<std::string, int> oMapKeyToId;
+    std::vector<int> anKeyId(nJobs);
+    std::vector<int> anWave(nJobs, 0);
+    int nWaves = 0;
+    for (size_t j = 0; j < nJobs; ++j)
+    {
+        const auto &oJob = aoJobs[j];
+        const auto oIter = oMapKeyToId.find(oJob.osDatasetKey);
+        if (oIter == oMapKeyToId.end())
+        {
+            anKeyId[j] = static_cast<int>(oMapKeyToId.size());
+            oMapKeyToId[oJob.osDatasetKey] = anKeyId[j];
+        }
+        else
+        {
+            anKeyId[j] = oIter->second;
+        }
+        for (size_t i = 0; i < j; ++i)
+        {
+            const auto &oPrev = aoJobs[i];
+            if (anWave[i] < anWave[j])
+                continue;
+            if (anKeyId[i] == anKeyId[j] ||
+                (oPrev.pDstBuffer == oJob.pDstBuffer &&
+                 oPrev.nDstXOff < oJob.nDstXOff + oJob.nDstXSize &&
+                 oJob.nDstXOff < oPrev.nDstXOff + oPrev.nDstXSize &&
+                 oPrev.nDstYOff < oJob.nDstYOff + oJob.nDstYSize &&
+                 oJob.nDstYOff < oPrev.nDstYOff + oPrev.nDstYSize))
+            {
+                anWave[j] = anWave[i] + 1;
+            }
+        }
+        nWaves = std::max(nWaves, anWave[j] + 1);
+    }
+
+    CPLWorkerThreadPool *poThreadPool =
+        nWaves < static_cast<int>(nJobs) ? GetSourceJobThreadPool(nThreads)
+                                         : nullptr;
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    VRTSourceJobContext sContext;
+    std::vector<VRTSourceJobData> asJobData(nJobs);
+    size_t nDone = 0;
+    for (int iWave = 0; iWave < nWaves && sContext.bSuccess; ++iWave)
+    {
+        for (size_t j = 0; j < nJobs; ++j)
+        {
+            if (anWave[j] != iWave)
+                continue;
+            asJobData[j].poJob = &aoJobs[j];
+            asJobData[j].psContext = &sContext;
+            if (!poQueue || !poQueue->SubmitJob(VRTSourceJobFunc,
+                                                &asJobData[j]))
+            {
+                VRTSourceJobFunc(&asJobData[j]);
+            }
+            ++nDone;
+        }
+        if (poQueue)
+            poQueue->WaitCompletion();
+
+        if (sContext.bSuccess && pfnProgress &&
+            !pfnProgress(static_cast<double>(nDone) / nJobs, "",
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            sContext.bSuccess = false;
+        }
+    }
+
+    // Re-emit errors caught in threads
+    for (const auto &oError : sContext.aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+
+    return sContext.bSuccess ? CE_None : CE_Failure;
+}
+
+/************************************************************************/
+/*                        InvalidateSourcesIndex()                      */
+/************************************************************************/
+
+/** Discard the spatial index of the sources.
+ *
+ * Must be called when sources are modified in place. Additions and removals
+ * of sources are otherwise detected at the next lookup.
+ */
+void VRTSourcedRasterBand::InvalidateSourcesIndex()
+{
+    if (m_hSourcesIndex)
+    {
+        CPLQuadTreeDestroy(m_hSourcesIndex);
+        m_hSourcesIndex = nullptr;
+    }
+    m_anSourcesNotIndexed.clear();
+    m_nSourcesIndexed = 0;
+    m_papoSourcesIndexed = nullptr;
+}
+
+/************************************************************************/
+/*                          BuildSourcesIndex()                         */
+/************************************************************************/
+
+void VRTSourcedRasterBand::BuildSourcesIndex()
+{
+    InvalidateSourcesIndex();
+
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = 0;
+    sGlobalBounds.miny = 0;
+    sGlobalBounds.maxx = nRasterXSize;
+    sGlobalBounds.maxy = nRasterYSize;
+    m_hSourcesIndex = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+
+    for (int i = 0; i < nSources; ++i)
+    {
+        if (papoSources[i]->IsSimpleSource())
+        {
+            const auto poSS =
+                cpl::down_cast<VRTSimpleSource *>(papoSources[i]);
+            const bool bDstWinSet =
+                poSS->m_dfDstXOff != -1 || poSS->m_dfDstXSize != -1 ||
+                poSS->m_dfDstYOff != -1 || poSS->m_dfDstYSize != -1;
+            if (bDstWinSet && std::isfinite(poSS->m_dfDstXOff) &&
+                std::isfinite(poSS->m_dfDstYOff) &&
+                std::isfinite(poSS->m_dfDstXSize) &&
+                std::isfinite(poSS->m_dfDstYSize) &&
+                poSS->m_dfDstXSize >= 0 && poSS->m_dfDstYSize >= 0)
+            {
+                // Sources with an empty destination window never contribute.
+                if (poSS->m_dfDstXSize == 0 || poSS->m_dfDstYSize == 0)
+                    continue;
+
+                CPLRectObj sBounds;
+                sBounds.minx = poSS->m_dfDstXOff;
+                sBounds.miny = poSS->m_dfDstYOff;
+                sBounds.maxx = poSS->m_dfDstXOff + poSS->m_dfDstXSize;
+                sBounds.maxy = poSS->m_dfDstYOff + poSS->m_dfDstYSize;
+                CPLQuadTreeInsertWithBounds(
+                    m_hSourcesIndex,
+                    reinterpret_cast<void *>(static_cast<uintptr_t>(i)),
+                    &sBounds);
+                continue;
+            }
+        }
+
+        // Sources whose footprint is not known are always considered.
+        m_anSourcesNotIndexed.push_back(i);
+    }
+
+    m_nSourcesIndexed = nSources;
+    m_papoSourcesIndexed = papoSources;
+}
+
+/************************************************************************/
+/*                        GetSourcesIntersecting()                      */
+/************************************************************************/
+
+/** Return the indices of the sources that may intersect a request window.
+ *
+ * When the band has at least SOURCES_INDEX_THRESHOLD sources, a spatial
+ * index of their destination windows is built on first call, and
+ * anSources is filled with the indices, in increasing order, of the
+ * sources that may contribute to the window. Otherwise false is returned
+ * and all sources should be considered.
+ */
+bool VRTSourcedRasterBand::GetSourcesIntersecting(
+    int nXOff, int nYOff, int nXSize, int nYSize,
+    const GDALRasterIOExtraArg *psExtraArg, std::vector<int> &anSources)
+{
+    anSources.clear();
+    if (nSources < SOURCES_INDEX_THRESHOLD)
+        return false;
+
+    if (m_hSourcesIndex == nullptr || m_nSourcesIndexed != nSources ||
+        m_papoSourcesIndexed != papoSources)
+    {
+        BuildSourcesIndex();
+    }
+
+    CPLRectObj sRequest;
+    if (psExtraArg && psExtraArg->bFloatingPointWindowValidity)
+    {
+        sRequest.minx = psExtraArg->dfXOff;
+        sRequest.miny = psExtraArg->dfYOff;
+        sRequest.maxx = psExtraArg->dfXOff + psExtraArg->dfXSize;
+        sRequest.maxy = psExtraArg->dfYOff + psExtraArg->dfYSize;
+    }
+    else
+    {
+        sRequest.minx = nXOff;
+        sRequest.miny = nYOff;
+        sRequest.maxx = static_cast<double>(nXOff) + nXSize;
+        sRequest.maxy = static_cast<double>(nYOff) + nYSize;
+    }
+
+    int nFeatureCount = 0;
+    void **pahRet =
+        CPLQuadTreeSearch(m_hSourcesIndex, &sRequest, &nFeatureCount);
+    anSources.reserve(nFeatureCount + m_anSourcesNotIndexed.size());
+    for (int i = 0; i < nFeatureCount; ++i)
+    {
+        anSources.push_back(
+            static_cast<int>(reinterpret_cast<uintptr_t>(pahRet[i])));
+    }
+    CPLFree(pahRet);
+    anSources.insert(anSources.end(), m_anSourcesNotIndexed.begin(),
+                     m_anSourcesNotIndexed.end());
+
+    // Sources must be composited in their declaration order.
+    std::sort(anSources.begin(), anSources.end());
+    return true;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -354,17 +775,78 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
     GDALProgressFunc const pfnProgressGlobal = psExtraArg->pfnProgress;
     void *const pProgressDataGlobal = psExtraArg->pProgressData;
 
+    /* -------------------------------------------------------------------- */
+    /*      Restrict to the sources intersecting the request window when    */
+    /*      there are many of them.                                         */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anCandidateSources;
+    const bool bUseSourcesIndex = GetSourcesIntersecting(
+        nXOff, nYOff, nXSize, nYSize, psExtraArg, anCandidateSources);
+    const int nCandidateSources =
+        bUseSourcesIndex ? static_cast<int>(anCandidateSources.size())
+                         : nSources;
+
+    /* -------------------------------------------------------------------- */
+    /*      Read the sources in parallel if asked to.                       */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = nCandidateSources > 1 ? GetNumThreadsForSources() : 1;
+    if (nThreads > 1)
+    {
+        std::vector<SourceJob> aoJobs;
+        bool bCanRunJobs = true;
+        for (int iCandidate = 0; iCandidate < nCandidateSources; iCandidate++)
+        {
+            const int iSource =
+                bUseSourcesIndex ? anCandidateSources[iCandidate] : iCandidate;
+            SourceJob oJob;
+            const int nRet = InitSourceJob(
+                papoSources[iSource], nXOff, nYOff, nXSize, nYSize, nBufXSize,
+                nBufYSize, psExtraArg, pData, oJob);
+            if (nRet < 0)
+            {
+                bCanRunJobs = false;
+                break;
+            }
+            if (nRet == 0)
+                continue;
+
+            VRTSource *poSource = papoSources[iSource];
+            const GDALDataType eVRTDataType = eDataType;
+            GDALRasterIOExtraArg sExtraArg;
+            GDALCopyRasterIOExtraArg(&sExtraArg, psExtraArg);
+            sExtraArg.pfnProgress = nullptr;
+            sExtraArg.pProgressData = nullptr;
+            oJob.fnRead = [=](VRTSource::WorkingState &oWorkingState) mutable
+            {
+                return poSource->RasterIO(eVRTDataType, nXOff, nYOff, nXSize,
+                                          nYSize, pData, nBufXSize, nBufYSize,
+                                          eBufType, nPixelSpace, nLineSpace,
+                                          &sExtraArg, oWorkingState);
+            };
+            aoJobs.push_back(std::move(oJob));
+        }
+        if (bCanRunJobs && aoJobs.size() > 1)
+        {
+            return RunSourceJobs(aoJobs, nThreads, pfnProgressGlobal,
+                                 pProgressDataGlobal);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Overlay each source in turn over top this.                      */
     /* -------------------------------------------------------------------- */
     CPLErr eErr = CE_None;
     VRTSource::WorkingState oWorkingState;
-    for (int iSource = 0; eErr == CE_None && iSource < nSources; iSource++)
+    for (int iCandidate = 0; eErr == CE_None && iCandidate < nCandidateSources;
+         iCandidate++)
     {
+        const int iSource =
+            bUseSourcesIndex ? anCandidateSources[iCandidate] : iCandidate;
         psExtraArg->pfnProgress = GDALScaledProgress;
         psExtraArg->pProgressData = GDALCreateScaledProgress(
-            1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
-            pfnProgressGlobal, pProgressDataGlobal);
+            1.0 * iCandidate / nCandidateSources,
+            1.0 * (iCandidate + 1) / nCandidateSources, pfnProgressGlobal,
+            pProgressDataGlobal);
         if (psExtraArg->pProgressData == nullptr)
             psExtraArg->pfnProgress = nullptr;
 
@@ -1768,6 +2250,7 @@ CPLErr VRTSourcedRasterBand::AddSource(VRTSource *poNewSource)
     papoSources = static_cast<VRTSource **>(
         CPLRealloc(papoSources, sizeof(void *) * nSources));
     papoSources[nSources - 1] = poNewSource;
+    InvalidateSourcesIndex();
 
     static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 
@@ -2553,6 +3036,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem(const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourcesIndex();
             static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
             return CE_None;
         }
@@ -2584,6 +3068,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata(char **papszNewMD,
             CPLFree(papoSources);
             papoSources = nullptr;
             nSources = 0;
+            InvalidateSourcesIndex();
         }
 
         for (int i = 0; i < CSLCount(papszNewMD); i++)
@@ -2644,6 +3129,8 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
 {
     int ret = VRTRasterBand::CloseDependentDatasets();
 
+    InvalidateSourcesIndex();
+
     if (nSources == 0)
         return ret;
 
@@ -2847,6 +3334,7 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
             papoSources[iDst++] = papoSources[iSrc];
     }
     nSources = iDst;
+    InvalidateSourcesIndex();
 
     CPLQuadTreeDestroy(hTree);
 #endif
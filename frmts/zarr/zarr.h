@@ -30,7 +30,10 @@
 #define ZARR_H
 
 #include "cpl_compressor.h"
+#include "cpl_error_internal.h"
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
 #include "memmultidim.h"
@@ -740,6 +743,10 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
     mutable bool m_bCachedTiledValid = false;
     mutable bool m_bCachedTiledEmpty = false;
     mutable bool m_bDirtyTile = false;
+    // Identifier of this array in GDALMDArrayChunkCache
+    uint64_t m_nChunkCacheOwnerId = 0;
+    bool m_bUseChunkCache = false;
+    mutable bool m_bChunkCacheUsed = false;
     bool m_bUseOptimizedCodePaths = true;
     mutable ZarrAttributeGroup m_oAttrGroup;
     mutable std::shared_ptr<OGRSpatialReference> m_poSRS{};
@@ -768,6 +775,21 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
     };
     mutable std::map<uint64_t, CachedTile> m_oMapTileIndexToCachedTile{};
 
+    // Job queue to encode and write dirty tiles in worker threads, when
+    // GDAL_NUM_THREADS is set
+    mutable std::unique_ptr<CPLJobQueue> m_poTileWriteJobQueue{};
+    // Indices of the tiles being written by m_poTileWriteJobQueue
+    // (protected by m_oMutex)
+    mutable std::set<std::vector<uint64_t>> m_oSetTilesBeingWritten{};
+    // Errors emitted by the tile write jobs (protected by m_oMutex)
+    mutable std::vector<CPLErrorHandlerAccumulatorStruct>
+        m_aoTileWriteErrors{};
+    // Whether all the tile write jobs succeeded (protected by m_oMutex)
+    mutable bool m_bTileWritesOK = true;
+
+    struct TileWriteJob;
+    static void TileWriteJobFunc(void *pData);
+
     static uint64_t
     ComputeTileCount(const std::string &osName,
                      const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -788,6 +810,12 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
 
     virtual bool AllocateWorkingBuffers() const = 0;
 
+    bool GetTileDataFromChunkCache(const std::vector<uint64_t> &tileIndices,
+                                   bool &bEmptyTile) const;
+
+    void PutTileDataIntoChunkCache(const std::vector<uint64_t> &tileIndices,
+                                   bool bEmptyTile) const;
+
     void SerializeNumericNoData(CPLJSONObject &oRoot) const;
 
     void DeallocateDecodedTileData();
@@ -797,7 +825,29 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
     virtual CPLStringList
     GetTileIndicesFromFilename(const char *pszFilename) const = 0;
 
-    virtual bool FlushDirtyTile() const = 0;
+    // Whether tiles are inner chunks of shards, in which case several tiles
+    // are stored in the same file.
+    virtual bool IsSharded() const
+    {
+        return false;
+    }
+
+    virtual bool FlushDirtyTile() const;
+
+    virtual bool
+    EncodeAndWriteTile(const std::string &osFilename,
+                       ZarrByteVectorQuickResize &abyRawTileData,
+                       const ZarrByteVectorQuickResize &abyDecodedTileData,
+                       bool bUseMutex) const = 0;
+
+    bool WaitTileWrites() const;
+
+    bool ReadWithParallelDecoding(const GUInt64 *arrayStartIdx,
+                                  const size_t *count,
+                                  const GInt64 *arrayStep,
+                                  const GPtrDiff_t *bufferStride,
+                                  const GDALExtendedDataType &bufferDataType,
+                                  void *pDstBuffer, bool &bDone) const;
 
     std::shared_ptr<GDALMDArray> OpenTilePresenceCache(bool bCanCreate) const;
 
@@ -1101,7 +1151,10 @@ class ZarrV2Array final : public ZarrArray
     CPLStringList
     GetTileIndicesFromFilename(const char *pszFilename) const override;
 
-    bool FlushDirtyTile() const override;
+    bool EncodeAndWriteTile(const std::string &osFilename,
+                            ZarrByteVectorQuickResize &abyRawTileData,
+                            const ZarrByteVectorQuickResize &abyDecodedTileData,
+                            bool bUseMutex) const override;
 
     std::string BuildTileFilename(const uint64_t *tileIndices) const override;
 
@@ -1378,6 +1431,92 @@ class ZarrV3CodecTranspose final : public ZarrV3Codec
                 ZarrByteVectorQuickResize &abyDst) const override;
 };
 
+/************************************************************************/
+/*                      ZarrV3CodecShardingIndexed                      */
+/************************************************************************/
+
+class ZarrV3CodecSequence;
+
+// Implements https://zarr-specs.readthedocs.io/en/latest/v3/codecs/sharding-indexed/v1.0.html
+// Shards are not decoded or encoded as a whole: ZarrV3Array reads and writes
+// their inner chunks individually, using the shard index.
+class ZarrV3CodecShardingIndexed final : public ZarrV3Codec
+{
+    // Shape of the inner chunks
+    std::vector<size_t> m_anInnerBlockSize{};
+
+    // Codecs applied to each inner chunk
+    std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
+
+    bool m_bIndexLocationAtEnd = true;
+    bool m_bIndexHasCRC32C = false;
+
+    ZarrV3CodecShardingIndexed(const ZarrV3CodecShardingIndexed &) = delete;
+    ZarrV3CodecShardingIndexed &
+    operator=(const ZarrV3CodecShardingIndexed &) = delete;
+
+  public:
+    static constexpr const char *NAME = "sharding_indexed";
+
+    // Value of the offset and size in the index of a missing inner chunk
+    static constexpr uint64_t MISSING_CHUNK = ~static_cast<uint64_t>(0);
+
+    ZarrV3CodecShardingIndexed();
+    ~ZarrV3CodecShardingIndexed() override;
+
+    IOType GetInputType() const override
+    {
+        return IOType::ARRAY;
+    }
+    IOType GetOutputType() const override
+    {
+        return IOType::BYTES;
+    }
+
+    static CPLJSONObject
+    GetConfiguration(const std::vector<GUInt64> &anInnerBlockSize,
+                     const CPLJSONArray &oCodecs);
+
+    bool
+    InitFromConfiguration(const CPLJSONObject &configuration,
+                          const ZarrArrayMetadata &oInputArrayMetadata,
+                          ZarrArrayMetadata &oOutputArrayMetadata) override;
+
+    std::unique_ptr<ZarrV3Codec> Clone() const override;
+
+    bool Encode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+    bool Decode(const ZarrByteVectorQuickResize &abySrc,
+                ZarrByteVectorQuickResize &abyDst) const override;
+
+    const std::vector<size_t> &GetShardSize() const
+    {
+        return m_oInputArrayMetadata.anBlockSizes;
+    }
+
+    const std::vector<size_t> &GetInnerBlockSize() const
+    {
+        return m_anInnerBlockSize;
+    }
+
+    size_t GetInnerChunkCount() const;
+
+    bool IsIndexAtEnd() const
+    {
+        return m_bIndexLocationAtEnd;
+    }
+
+    size_t GetIndexSize() const;
+
+    bool DecodeIndex(const GByte *pabyIndex,
+                     std::vector<uint64_t> &anIndex) const;
+    void EncodeIndex(const std::vector<uint64_t> &anIndex,
+                     std::vector<GByte> &abyIndex) const;
+
+    bool EncodeInnerChunk(ZarrByteVectorQuickResize &abyBuffer) const;
+    bool DecodeInnerChunk(ZarrByteVectorQuickResize &abyBuffer) const;
+};
+
 /************************************************************************/
 /*                          ZarrV3CodecSequence                         */
 /************************************************************************/
@@ -1407,6 +1546,9 @@ class ZarrV3CodecSequence
         return m_oCodecArray;
     }
 
+    // Returns the sharding_indexed codec, if it is the codec of the sequence
+    ZarrV3CodecShardingIndexed *GetShardingIndexedCodec() const;
+
     bool Encode(ZarrByteVectorQuickResize &abyBuffer);
     bool Decode(ZarrByteVectorQuickResize &abyBuffer);
 };
@@ -1420,6 +1562,29 @@ class ZarrV3Array final : public ZarrArray
     bool m_bV2ChunkKeyEncoding = false;
     std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
 
+    // Set when the array uses the sharding_indexed codec. Tiles of the array
+    // (m_anBlockSize) are then the inner chunks of the shards.
+    ZarrV3CodecShardingIndexed *m_poShardingCodec = nullptr;
+
+    // Shard indices, keyed by shard filename (protected by m_oMutex).
+    // An empty index is cached for missing shards.
+    mutable lru11::Cache<std::string, std::shared_ptr<std::vector<uint64_t>>>
+        m_oCacheShardIndex{256};
+
+    struct PendingShard
+    {
+        // Number of inner chunks of the shard that intersect the array
+        size_t nExpectedChunks = 0;
+        // Encoded inner chunks, keyed by their index in the shard. An empty
+        // vector stands for an inner chunk with only the fill value.
+        std::map<size_t, std::vector<GByte>> oMapChunks{};
+    };
+
+    // Shards some inner chunks of which have not been written yet, keyed by
+    // shard indices.
+    mutable std::map<std::vector<uint64_t>, PendingShard>
+        m_oMapPendingShards{};
+
     ZarrV3Array(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
                 const std::string &osParentName, const std::string &osName,
                 const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -1441,6 +1606,24 @@ class ZarrV3Array final : public ZarrArray
                       ZarrByteVectorQuickResize &abyDecodedTileData,
                       bool &bMissingTileOut) const;
 
+    void GetShardIndices(const uint64_t *tileIndices,
+                         std::vector<uint64_t> &anShardIndices,
+                         size_t &nInnerChunkIdx) const;
+
+    bool ReadShardIndex(VSILFILE *fp, const std::string &osFilename,
+                        const ZarrV3CodecShardingIndexed *poShardingCodec,
+                        std::vector<uint64_t> &anIndex) const;
+
+    bool LoadInnerChunkData(const uint64_t *tileIndices, bool bUseMutex,
+                            const ZarrV3CodecShardingIndexed *poShardingCodec,
+                            ZarrByteVectorQuickResize &abyRawTileData,
+                            bool &bMissingTileOut) const;
+
+    bool WriteShard(const std::vector<uint64_t> &anShardIndices,
+                    const PendingShard &oPendingShard) const;
+
+    bool FlushPendingShards() const;
+
   public:
     ~ZarrV3Array() override;
 
@@ -1460,6 +1643,8 @@ class ZarrV3Array final : public ZarrArray
     void SetCodecs(std::unique_ptr<ZarrV3CodecSequence> &&poCodecs)
     {
         m_poCodecs = std::move(poCodecs);
+        m_poShardingCodec =
+            m_poCodecs ? m_poCodecs->GetShardingIndexedCodec() : nullptr;
     }
 
     void Flush() override;
@@ -1472,8 +1657,18 @@ class ZarrV3Array final : public ZarrArray
 
     bool AllocateWorkingBuffers() const override;
 
+    bool IsSharded() const override
+    {
+        return m_poShardingCodec != nullptr;
+    }
+
     bool FlushDirtyTile() const override;
 
+    bool EncodeAndWriteTile(const std::string &osFilename,
+                            ZarrByteVectorQuickResize &abyRawTileData,
+                            const ZarrByteVectorQuickResize &abyDecodedTileData,
+                            bool bUseMutex) const override;
+
     std::string BuildTileFilename(const uint64_t *tileIndices) const override;
 
     bool LoadTileData(const uint64_t *tileIndices,
@@ -30,6 +30,8 @@
 #include "ucs4_utf8.hpp"
 
 #include "cpl_float.h"
+#include "gdal_thread_pool.h"
+#include "gdalmultidim_chunkcache.h"
 
 #include "netcdf_cf_constants.h"  // for CF_UNITS, etc
 
@@ -197,6 +199,12 @@ ZarrArray::ZarrArray(
 
     m_bUseOptimizedCodePaths = CPLTestBool(
         CPLGetConfigOption("GDAL_ZARR_USE_OPTIMIZED_CODE_PATHS", "YES"));
+
+    // Decoded tiles of data types with dynamic memory (strings) hold
+    // pointers that are owned by the tile buffer, so they cannot be shared.
+    m_bUseChunkCache = !m_oType.NeedsFreeDynamicMemory();
+    if (m_bUseChunkCache)
+        m_nChunkCacheOwnerId = GDALMDArrayChunkCache::GetNewOwnerId();
 }
 
 /************************************************************************/
@@ -212,6 +220,9 @@ ZarrArray::~ZarrArray()
     }
 
     DeallocateDecodedTileData();
+
+    if (m_bChunkCacheUsed)
+        GDALMDArrayChunkCache::GetSingleton().RemoveOwner(m_nChunkCacheOwnerId);
 }
 
 /************************************************************************/
@@ -390,6 +401,57 @@ void ZarrArray::DeallocateDecodedTileData()
     }
 }
 
+/************************************************************************/
+/*                 ZarrArray::GetTileDataFromChunkCache()               */
+/************************************************************************/
+
+// Fill m_abyDecodedTileData (or m_abyRawTileData if no decoding is needed)
+// from the process-wide chunk cache. Returns false on a cache miss.
+bool ZarrArray::GetTileDataFromChunkCache(
+    const std::vector<uint64_t> &tileIndices, bool &bEmptyTile) const
+{
+    if (!m_bUseChunkCache)
+        return false;
+    const auto poChunk = GDALMDArrayChunkCache::GetSingleton().Get(
+        m_nChunkCacheOwnerId, tileIndices);
+    if (!poChunk || !AllocateWorkingBuffers())
+        return false;
+    // An empty cached chunk records a missing tile
+    bEmptyTile = poChunk->empty();
+    if (bEmptyTile)
+        return true;
+    auto &abyTile = m_abyDecodedTileData.empty() ? m_abyRawTileData
+                                                 : m_abyDecodedTileData;
+    if (poChunk->size() != abyTile.size())
+        return false;
+    memcpy(&abyTile[0], poChunk->data(), abyTile.size());
+    return true;
+}
+
+/************************************************************************/
+/*                 ZarrArray::PutTileDataIntoChunkCache()               */
+/************************************************************************/
+
+void ZarrArray::PutTileDataIntoChunkCache(
+    const std::vector<uint64_t> &tileIndices, bool bEmptyTile) const
+{
+    if (!m_bUseChunkCache)
+        return;
+    auto poChunk = std::make_shared<std::vector<GByte>>();
+    if (!bEmptyTile)
+    {
+        const auto &abyTile = m_abyDecodedTileData.empty()
+                                  ? m_abyRawTileData
+                                  : m_abyDecodedTileData;
+        poChunk->assign(abyTile.data(), abyTile.data() + abyTile.size());
+    }
+    if (GDALMDArrayChunkCache::GetSingleton().Insert(
+            m_nChunkCacheOwnerId, tileIndices, std::move(poChunk)))
+    {
+        m_bChunkCacheUsed = true;
+    }
+}
+
 /************************************************************************/
 /*                             EncodeElt()                              */
 /************************************************************************/
@@ -891,6 +953,9 @@ bool ZarrArray::IAdviseReadCommon(const GUInt64 *arrayStartIdx,
     if (!CheckValidAndErrorOutIfNot())
         return false;
 
+    if (!WaitTileWrites())
+        return false;
+
     const size_t nDims = m_aoDims.size();
     anIndicesCur.resize(nDims);
     std::vector<uint64_t> anIndicesMin(nDims);
@@ -1027,6 +1092,120 @@ lbl_next_depth:
     return true;
 }
 
+/************************************************************************/
+/*                        GetNumThreadsFromConfig()                     */
+/************************************************************************/
+
+static int GetNumThreadsFromConfig()
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::min(1024, std::max(1, nThreads));
+}
+
+/************************************************************************/
+/*                 ZarrArray::ReadWithParallelDecoding()                */
+/************************************************************************/
+
+// Process a read request by slabs along the first dimension: the tiles of
+// each slab are decoded in parallel by IAdviseRead(), and then assembled
+// by IRead(). bDone is set to false if the request is not eligible.
+bool ZarrArray::ReadWithParallelDecoding(
+    const GUInt64 *arrayStartIdx, const size_t *count, const GInt64 *arrayStep,
+    const GPtrDiff_t *bufferStride, const GDALExtendedDataType &bufferDataType,
+    void *pDstBuffer, bool &bDone) const
+{
+    bDone = false;
+
+    const size_t nDims = m_aoDims.size();
+    if (nDims == 0)
+        return true;
+
+    const int nThreads = GetNumThreadsFromConfig();
+    if (nThreads <= 1)
+        return true;
+
+    // Only consider requests without subsampling, so that all the tiles
+    // intersecting the request are actually needed.
+    size_t nTilesOtherDims = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (count[i] > 1 && arrayStep[i] != 1)
+            return true;
+        if (i > 0)
+        {
+            // Overflow on number of tiles already checked in Create()
+            nTilesOtherDims *= static_cast<size_t>(
+                (arrayStartIdx[i] + count[i] - 1) / m_anBlockSize[i] -
+                arrayStartIdx[i] / m_anBlockSize[i] + 1);
+        }
+    }
+    const uint64_t nFirstTileDim0 = arrayStartIdx[0] / m_anBlockSize[0];
+    const uint64_t nLastTileDim0 =
+        (arrayStartIdx[0] + count[0] - 1) / m_anBlockSize[0];
+    if (nFirstTileDim0 == nLastTileDim0 && nTilesOtherDims == 1)
+        return true;
+
+    // Use at most half of the remaining block cache to hold the decoded tiles
+    // of a slab, as IAdviseRead() does by default.
+    const uint64_t nCacheSize = static_cast<uint64_t>(
+        std::max<GIntBig>(0, GDALGetCacheMax64() - GDALGetCacheUsed64()) / 2);
+    const uint64_t nTilesPerSlab =
+        std::min(nCacheSize / std::max(m_nTileSize, nDims) / nTilesOtherDims,
+                 nLastTileDim0 - nFirstTileDim0 + 1);
+    if (nTilesPerSlab == 0)
+    {
+        CPLDebugOnly(ZARR_DEBUG_KEY,
+                     "Not enough cache for parallel decoding of tiles");
+        return true;
+    }
+
+    if (!FlushDirtyTile())
+        return false;
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("NUM_THREADS", CPLSPrintf("%d", nThreads));
+    aosOptions.SetNameValue(
+        "CACHE_SIZE",
+        CPLSPrintf(CPL_FRMT_GUIB, static_cast<GUIntBig>(nCacheSize)));
+
+    std::vector<GUInt64> anSlabStartIdx(arrayStartIdx, arrayStartIdx + nDims);
+    std::vector<size_t> anSlabCount(count, count + nDims);
+    const auto nBufferDTSize =
+        static_cast<GPtrDiff_t>(bufferDataType.GetSize());
+    for (uint64_t nTile = nFirstTileDim0; nTile <= nLastTileDim0;
+         nTile += nTilesPerSlab)
+    {
+        const uint64_t nSlabStart =
+            std::max<uint64_t>(arrayStartIdx[0], nTile * m_anBlockSize[0]);
+        const uint64_t nSlabEnd =
+            std::min<uint64_t>(arrayStartIdx[0] + count[0],
+                               (nTile + nTilesPerSlab) * m_anBlockSize[0]);
+        anSlabStartIdx[0] = nSlabStart;
+        anSlabCount[0] = static_cast<size_t>(nSlabEnd - nSlabStart);
+        void *pSlabDstBuffer =
+            static_cast<GByte *>(pDstBuffer) +
+            static_cast<GPtrDiff_t>(nSlabStart - arrayStartIdx[0]) *
+                bufferStride[0] * nBufferDTSize;
+
+        // As m_oMapTileIndexToCachedTile is filled by IAdviseRead(), IRead()
+        // will not recurse into this method.
+        const bool bOK =
+            IAdviseRead(anSlabStartIdx.data(), anSlabCount.data(),
+                        aosOptions.List()) &&
+            IRead(anSlabStartIdx.data(), anSlabCount.data(), arrayStep,
+                  bufferStride, bufferDataType, pSlabDstBuffer);
+        m_oMapTileIndexToCachedTile.clear();
+        if (!bOK)
+            return false;
+    }
+
+    bDone = true;
+    return true;
+}
+
 /************************************************************************/
 /*                           ZarrArray::IRead()                         */
 /************************************************************************/
@@ -1039,6 +1218,9 @@ bool ZarrArray::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
     if (!CheckValidAndErrorOutIfNot())
         return false;
 
+    if (!WaitTileWrites())
+        return false;
+
     if (!AllocateWorkingBuffers())
         return false;
 
@@ -1092,6 +1274,21 @@ bool ZarrArray::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
         bufferStride = bufferStrideMod.data();
     }
 
+    // Unless the caller has already called AdviseRead(), decode the tiles
+    // intersecting the request in parallel, if GDAL_NUM_THREADS is set.
+    if (m_oMapTileIndexToCachedTile.empty())
+    {
+        bool bDone = false;
+        if (!ReadWithParallelDecoding(arrayStartIdx, count, arrayStep,
+                                      bufferStride, bufferDataType, pDstBuffer,
+                                      bDone))
+        {
+            return false;
+        }
+        if (bDone)
+            return true;
+    }
+
     std::vector<uint64_t> indicesOuterLoop(nDims + 1);
     std::vector<GByte *> dstPtrStackOuterLoop(nDims + 1);
 
@@ -1182,15 +1379,23 @@ lbl_next_depth:
             }
             else
             {
-                if (!FlushDirtyTile())
+                if (!FlushDirtyTile() || !WaitTileWrites())
                     return false;
 
                 m_anCachedTiledIndices = tileIndices;
-                m_bCachedTiledValid =
-                    LoadTileData(tileIndices.data(), bEmptyTile);
-                if (!m_bCachedTiledValid)
+                if (GetTileDataFromChunkCache(tileIndices, bEmptyTile))
                 {
-                    return false;
+                    m_bCachedTiledValid = true;
+                }
+                else
+                {
+                    m_bCachedTiledValid =
+                        LoadTileData(tileIndices.data(), bEmptyTile);
+                    if (!m_bCachedTiledValid)
+                    {
+                        return false;
+                    }
+                    PutTileDataIntoChunkCache(tileIndices, bEmptyTile);
                 }
                 m_bCachedTiledEmpty = bEmptyTile;
             }
@@ -1693,6 +1898,8 @@ lbl_next_depth:
             {
                 // If we don't write the whole tile, we need to fetch a
                 // potentially existing one.
+                if (!WaitTileWrites())
+                    return false;
                 bool bEmptyTile = false;
                 m_bCachedTiledValid =
                     LoadTileData(tileIndices.data(), bEmptyTile);
@@ -1734,6 +1941,11 @@ lbl_next_depth:
                 }
             }
         }
+        if (!m_bDirtyTile && m_bChunkCacheUsed)
+        {
+            GDALMDArrayChunkCache::GetSingleton().Remove(m_nChunkCacheOwnerId,
+                                                         tileIndices);
+        }
         m_bDirtyTile = true;
         m_bCachedTiledEmpty = false;
         if (nDims)
@@ -1990,6 +2202,190 @@ lbl_next_depth:
     return true;
 }
 
+/************************************************************************/
+/*                       ZarrArray::TileWriteJob                        */
+/************************************************************************/
+
+struct ZarrArray::TileWriteJob
+{
+    const ZarrArray *poArray = nullptr;
+    std::string osFilename{};
+    std::vector<uint64_t> anTileIndices{};
+    ZarrByteVectorQuickResize abyRawTileData{};
+    ZarrByteVectorQuickResize abyDecodedTileData{};
+};
+
+/************************************************************************/
+/*                    ZarrArray::TileWriteJobFunc()                     */
+/************************************************************************/
+
+void ZarrArray::TileWriteJobFunc(void *pData)
+{
+    std::unique_ptr<TileWriteJob> psJob(static_cast<TileWriteJob *>(pData));
+    const auto poArray = psJob->poArray;
+
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    CPLInstallErrorHandlerAccumulator(aoErrors);
+    const bool bOK = poArray->EncodeAndWriteTile(
+        psJob->osFilename, psJob->abyRawTileData, psJob->abyDecodedTileData,
+        /* bUseMutex = */ true);
+    CPLUninstallErrorHandlerAccumulator();
+
+    std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+    poArray->m_aoTileWriteErrors.insert(poArray->m_aoTileWriteErrors.end(),
+                                        aoErrors.begin(), aoErrors.end());
+    if (!bOK)
+        poArray->m_bTileWritesOK = false;
+    poArray->m_oSetTilesBeingWritten.erase(psJob->anTileIndices);
+}
+
+/************************************************************************/
+/*                     ZarrArray::FlushDirtyTile()                      */
+/************************************************************************/
+
+bool ZarrArray::FlushDirtyTile() const
+{
+    if (!m_bDirtyTile)
+        return true;
+    m_bDirtyTile = false;
+
+    // Make sure that a previous version of the tile is not still being
+    // written
+    bool bTileBeingWritten;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        bTileBeingWritten =
+            m_oSetTilesBeingWritten.find(m_anCachedTiledIndices) !=
+            m_oSetTilesBeingWritten.end();
+    }
+    if (bTileBeingWritten && !WaitTileWrites())
+        return false;
+
+    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
+
+    const auto &abyTile =
+        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
+
+    if (IsEmptyTile(abyTile))
+    {
+        m_bCachedTiledEmpty = true;
+
+        VSIStatBufL sStat;
+        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        {
+            CPLDebugOnly(ZARR_DEBUG_KEY,
+                         "Deleting tile %s that has now empty content",
+                         osFilename.c_str());
+            return VSIUnlink(osFilename.c_str()) == 0;
+        }
+        return true;
+    }
+
+    // Done in this thread, as concurrent creations of the same directory
+    // could fail.
+    if (m_osDimSeparator == "/")
+    {
+        std::string osDir = CPLGetDirname(osFilename.c_str());
+        VSIStatBufL sStat;
+        if (VSIStatL(osDir.c_str(), &sStat) != 0)
+        {
+            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot create directory %s", osDir.c_str());
+                return false;
+            }
+        }
+    }
+
+    const int nThreads = GetNumThreadsFromConfig();
+    if (nThreads > 1 && !m_poTileWriteJobQueue)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            m_poTileWriteJobQueue = poThreadPool->CreateJobQueue();
+    }
+    if (nThreads <= 1 || !m_poTileWriteJobQueue)
+    {
+        return EncodeAndWriteTile(osFilename, m_abyRawTileData,
+                                  m_abyDecodedTileData,
+                                  /* bUseMutex = */ false);
+    }
+
+    // Limit the memory used by the copies of the pending tiles
+    m_poTileWriteJobQueue->WaitCompletion(2 * nThreads);
+
+    // Encode and write a copy of the tile in a worker thread, so that the
+    // caller can go on with the next tile.
+    auto psJob = std::make_unique<TileWriteJob>();
+    psJob->poArray = this;
+    psJob->osFilename = std::move(osFilename);
+    psJob->anTileIndices = m_anCachedTiledIndices;
+    try
+    {
+        psJob->abyRawTileData.resize(m_abyRawTileData.size());
+        if (!m_abyDecodedTileData.empty())
+            psJob->abyDecodedTileData.resize(m_abyDecodedTileData.size());
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    if (!m_abyDecodedTileData.empty())
+    {
+        memcpy(&psJob->abyDecodedTileData[0], m_abyDecodedTileData.data(),
+               m_abyDecodedTileData.size());
+    }
+    else
+    {
+        memcpy(&psJob->abyRawTileData[0], m_abyRawTileData.data(),
+               m_abyRawTileData.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oSetTilesBeingWritten.insert(psJob->anTileIndices);
+    }
+    const auto anTileIndices = psJob->anTileIndices;
+    if (!m_poTileWriteJobQueue->SubmitJob(TileWriteJobFunc, psJob.get()))
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oSetTilesBeingWritten.erase(anTileIndices);
+        return false;
+    }
+    psJob.release();
+    return true;
+}
+
+/************************************************************************/
+/*                     ZarrArray::WaitTileWrites()                      */
+/************************************************************************/
+
+// Wait for the completion of the tile write jobs, emit their errors, and
+// return whether they all succeeded.
+bool ZarrArray::WaitTileWrites() const
+{
+    if (!m_poTileWriteJobQueue)
+        return true;
+
+    m_poTileWriteJobQueue->WaitCompletion();
+
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    bool bOK;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        std::swap(aoErrors, m_aoTileWriteErrors);
+        bOK = m_bTileWritesOK;
+        m_bTileWritesOK = true;
+    }
+    for (const auto &oError : aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+    return bOK;
+}
+
 /************************************************************************/
 /*                   ZarrArray::IsEmptyTile()                           */
 /************************************************************************/
@@ -2049,7 +2445,7 @@ ZarrArray::OpenTilePresenceCache(bool bCanCreate) const
         return m_poCacheTilePresenceArray;
     m_bHasTriedCacheTilePresenceArray = true;
 
-    if (m_nTotalTileCount == 1)
+    if (m_nTotalTileCount == 1 || IsSharded())
         return nullptr;
 
     std::string osCacheFilename;
@@ -2161,6 +2557,16 @@ bool ZarrArray::CacheTilePresence()
     if (m_nTotalTileCount == 1)
         return true;
 
+    if (IsSharded())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "CacheTilePresence() not supported on sharded arrays");
+        return false;
+    }
+
+    if (!FlushDirtyTile() || !WaitTileWrites())
+        return false;
+
     const std::string osDirectoryName = GetDataDirectory();
 
     struct DirCloser
@@ -2670,6 +3076,10 @@ bool ZarrArray::Rename(const std::string &osNewName)
         return false;
     }
 
+    // Tiles must be written to the current directory before renaming it
+    if (!WaitTileWrites())
+        return false;
+
     auto poParent = m_poGroupWeak.lock();
     if (poParent)
     {
@@ -2714,6 +3124,9 @@ bool ZarrArray::Rename(const std::string &osNewName)
 
 void ZarrArray::NotifyChildrenOfDeletion()
 {
+    // Tile write jobs must not outlive the array
+    WaitTileWrites();
+
     m_oAttrGroup.ParentDeleted();
 }
 
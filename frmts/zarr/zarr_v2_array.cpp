@@ -97,7 +97,8 @@ void ZarrV2Array::Flush()
     if (!m_bValid)
         return;
 
-    ZarrV2Array::FlushDirtyTile();
+    FlushDirtyTile();
+    WaitTileWrites();
 
     if (m_bDefinitionModified)
     {
@@ -806,73 +807,79 @@ bool ZarrV2Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
 }
 
 /************************************************************************/
-/*                    ZarrV2Array::FlushDirtyTile()                     */
+/*                  ZarrV2Array::EncodeAndWriteTile()                   */
 /************************************************************************/
 
-bool ZarrV2Array::FlushDirtyTile() const
+bool ZarrV2Array::EncodeAndWriteTile(
+    const std::string &osFilename, ZarrByteVectorQuickResize &abyRawTileData,
+    const ZarrByteVectorQuickResize &abyDecodedTileData, bool bUseMutex) const
 {
-    if (!m_bDirtyTile)
-        return true;
-    m_bDirtyTile = false;
-
-    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
+    // When bUseMutex is set, this method is called from a worker thread, and
+    // should NOT modify any ZarrArray member.
 
     const size_t nSourceSize =
         m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
-    const auto &abyTile =
-        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
 
-    if (IsEmptyTile(abyTile))
+    if (!abyDecodedTileData.empty())
     {
-        m_bCachedTiledEmpty = true;
-
-        VSIStatBufL sStat;
-        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        const size_t nDTSize = m_oType.GetSize();
+        const size_t nValues = abyDecodedTileData.size() / nDTSize;
+        GByte *pDst = &abyRawTileData[0];
+        const GByte *pSrc = abyDecodedTileData.data();
+        for (size_t i = 0; i < nValues;
+             i++, pDst += nSourceSize, pSrc += nDTSize)
         {
-            CPLDebugOnly(ZARR_DEBUG_KEY,
-                         "Deleting tile %s that has now empty content",
-                         osFilename.c_str());
-            return VSIUnlink(osFilename.c_str()) == 0;
+            EncodeElt(m_aoDtypeElts, pSrc, pDst);
         }
-        return true;
     }
 
-    if (!m_abyDecodedTileData.empty())
+    ZarrByteVectorQuickResize abyLocalTmpRawTileData;
+    if (bUseMutex && (m_bFortranOrder || m_oFiltersArray.Size() != 0))
     {
-        const size_t nDTSize = m_oType.GetSize();
-        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
-        GByte *pDst = &m_abyRawTileData[0];
-        const GByte *pSrc = m_abyDecodedTileData.data();
-        for (size_t i = 0; i < nValues;
-             i++, pDst += nSourceSize, pSrc += nDTSize)
+        try
         {
-            EncodeElt(m_aoDtypeElts, pSrc, pDst);
+            abyLocalTmpRawTileData.resize(m_abyTmpRawTileData.size());
+        }
+        catch (const std::bad_alloc &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            return false;
         }
     }
+    auto &abyTmpRawTileData =
+        bUseMutex ? abyLocalTmpRawTileData : m_abyTmpRawTileData;
 
     if (m_bFortranOrder && !m_aoDims.empty())
     {
-        BlockTranspose(m_abyRawTileData, m_abyTmpRawTileData, false);
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        BlockTranspose(abyRawTileData, abyTmpRawTileData, false);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
-    size_t nRawDataSize = m_abyRawTileData.size();
-    for (const auto &oFilter : m_oFiltersArray)
+    size_t nRawDataSize = abyRawTileData.size();
+    for (int iFilter = 0; iFilter < m_oFiltersArray.Size(); ++iFilter)
     {
-        const auto osFilterId = oFilter["id"].ToString();
-        const auto psFilterCompressor = CPLGetCompressor(osFilterId.c_str());
-        CPLAssert(psFilterCompressor);
-
+        std::string osFilterId;
         CPLStringList aosOptions;
-        for (const auto &obj : oFilter.GetChildren())
         {
-            aosOptions.SetNameValue(obj.GetName().c_str(),
-                                    obj.ToString().c_str());
+            // Accessing the JSON objects is not thread-safe
+            std::unique_lock<std::mutex> oLock(m_oMutex, std::defer_lock);
+            if (bUseMutex)
+                oLock.lock();
+            const auto oFilter = m_oFiltersArray[iFilter];
+            osFilterId = oFilter["id"].ToString();
+            for (const auto &obj : oFilter.GetChildren())
+            {
+                aosOptions.SetNameValue(obj.GetName().c_str(),
+                                        obj.ToString().c_str());
+            }
         }
-        void *out_buffer = &m_abyTmpRawTileData[0];
-        size_t nOutSize = m_abyTmpRawTileData.size();
+        const auto psFilterCompressor = CPLGetCompressor(osFilterId.c_str());
+        CPLAssert(psFilterCompressor);
+
+        void *out_buffer = &abyTmpRawTileData[0];
+        size_t nOutSize = abyTmpRawTileData.size();
         if (!psFilterCompressor->pfnFunc(
-                m_abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
+                abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
                 aosOptions.List(), psFilterCompressor->user_data))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -882,22 +889,7 @@ bool ZarrV2Array::FlushDirtyTile() const
         }
 
         nRawDataSize = nOutSize;
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
-    }
-
-    if (m_osDimSeparator == "/")
-    {
-        std::string osDir = CPLGetDirname(osFilename.c_str());
-        VSIStatBufL sStat;
-        if (VSIStatL(osDir.c_str(), &sStat) != 0)
-        {
-            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Cannot create directory %s", osDir.c_str());
-                return false;
-            }
-        }
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
     VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
@@ -911,7 +903,7 @@ bool ZarrV2Array::FlushDirtyTile() const
     bool bRet = true;
     if (m_psCompressor == nullptr)
     {
-        if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+        if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
             nRawDataSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -940,11 +932,17 @@ bool ZarrV2Array::FlushDirtyTile() const
             void *out_buffer = &abyCompressedData[0];
             size_t out_size = abyCompressedData.size();
             CPLStringList aosOptions;
-            const auto &compressorConfig = m_oCompressorJSon;
-            for (const auto &obj : compressorConfig.GetChildren())
             {
-                aosOptions.SetNameValue(obj.GetName().c_str(),
-                                        obj.ToString().c_str());
+                // Accessing the JSON objects is not thread-safe
+                std::unique_lock<std::mutex> oLock(m_oMutex, std::defer_lock);
+                if (bUseMutex)
+                    oLock.lock();
+                const auto &compressorConfig = m_oCompressorJSon;
+                for (const auto &obj : compressorConfig.GetChildren())
+                {
+                    aosOptions.SetNameValue(obj.GetName().c_str(),
+                                            obj.ToString().c_str());
+                }
             }
             if (EQUAL(m_psCompressor->pszId, "blosc") &&
                 m_oType.GetClass() == GEDTC_NUMERIC)
@@ -957,7 +955,7 @@ bool ZarrV2Array::FlushDirtyTile() const
             }
 
             if (!m_psCompressor->pfnFunc(
-                    m_abyRawTileData.data(), nRawDataSize, &out_buffer,
+                    abyRawTileData.data(), nRawDataSize, &out_buffer,
                     &out_size, aosOptions.List(), m_psCompressor->user_data))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
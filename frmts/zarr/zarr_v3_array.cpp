@@ -93,7 +93,9 @@ void ZarrV3Array::Flush()
     if (!m_bValid)
         return;
 
-    ZarrV3Array::FlushDirtyTile();
+    FlushDirtyTile();
+    WaitTileWrites();
+    FlushPendingShards();
 
     if (!m_aoDims.empty())
     {
@@ -159,9 +161,20 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         CPLJSONObject oConfiguration;
         oChunkGrid.Add("configuration", oConfiguration);
         CPLJSONArray oChunks;
-        for (const auto nBlockSize : m_anBlockSize)
+        if (m_poShardingCodec)
         {
-            oChunks.Add(static_cast<GInt64>(nBlockSize));
+            // The chunks of the grid are the shards
+            for (const auto nShardSize : m_poShardingCodec->GetShardSize())
+            {
+                oChunks.Add(static_cast<GInt64>(nShardSize));
+            }
+        }
+        else
+        {
+            for (const auto nBlockSize : m_anBlockSize)
+            {
+                oChunks.Add(static_cast<GInt64>(nBlockSize));
+            }
         }
         oConfiguration.Add("chunk_shape", oChunks);
     }
@@ -433,105 +446,122 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
     if (bUseMutex)
         m_oMutex.unlock();
 
-    VSILFILE *fp = nullptr;
-    // This is the number of files returned in a S3 directory listing operation
-    constexpr uint64_t MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING = 1000;
-    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
-                                           nullptr};
-    if ((m_osDimSeparator == "/" && !m_anBlockSize.empty() &&
-         m_anBlockSize.back() > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING) ||
-        (m_osDimSeparator != "/" &&
-         m_nTotalTileCount > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING))
+    if (const auto poShardingCodec =
+            poCodecs ? poCodecs->GetShardingIndexedCodec() : nullptr)
     {
-        // Avoid issuing ReadDir() when a lot of files are expected
-        CPLConfigOptionSetter optionSetter("GDAL_DISABLE_READDIR_ON_OPEN",
-                                           "YES", true);
-        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+        if (!LoadInnerChunkData(tileIndices, bUseMutex, poShardingCodec,
+                                abyRawTileData, bMissingTileOut))
+        {
+            return false;
+        }
+        if (bMissingTileOut)
+            return true;
     }
     else
     {
-        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
-    }
-    if (fp == nullptr)
-    {
-        // Missing files are OK and indicate nodata_value
-        CPLDebugOnly(ZARR_DEBUG_KEY, "Tile %s missing (=nodata)",
-                     osFilename.c_str());
-        bMissingTileOut = true;
-        return true;
-    }
+        VSILFILE *fp = nullptr;
+        // This is the number of files returned in a S3 directory listing
+        // operation
+        constexpr uint64_t MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING = 1000;
+        const char *const apszOpenOptions[] = {
+            "IGNORE_FILENAME_RESTRICTIONS=YES", nullptr};
+        if ((m_osDimSeparator == "/" && !m_anBlockSize.empty() &&
+             m_anBlockSize.back() > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING) ||
+            (m_osDimSeparator != "/" &&
+             m_nTotalTileCount > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING))
+        {
+            // Avoid issuing ReadDir() when a lot of files are expected
+            CPLConfigOptionSetter optionSetter("GDAL_DISABLE_READDIR_ON_OPEN",
+                                               "YES", true);
+            fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+        }
+        else
+        {
+            fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+        }
+        if (fp == nullptr)
+        {
+            // Missing files are OK and indicate nodata_value
+            CPLDebugOnly(ZARR_DEBUG_KEY, "Tile %s missing (=nodata)",
+                         osFilename.c_str());
+            bMissingTileOut = true;
+            return true;
+        }
 
-    bMissingTileOut = false;
+        bMissingTileOut = false;
 
-    CPLAssert(abyRawTileData.capacity() >= m_nTileSize);
-    // should not fail
-    abyRawTileData.resize(m_nTileSize);
+        CPLAssert(abyRawTileData.capacity() >= m_nTileSize);
+        // should not fail
+        abyRawTileData.resize(m_nTileSize);
 
-    bool bRet = true;
-    size_t nRawDataSize = abyRawTileData.size();
-    if (poCodecs == nullptr)
-    {
-        nRawDataSize = VSIFReadL(&abyRawTileData[0], 1, nRawDataSize, fp);
-    }
-    else
-    {
-        VSIFSeekL(fp, 0, SEEK_END);
-        const auto nSize = VSIFTellL(fp);
-        VSIFSeekL(fp, 0, SEEK_SET);
-        if (nSize > static_cast<vsi_l_offset>(std::numeric_limits<int>::max()))
+        bool bRet = true;
+        size_t nRawDataSize = abyRawTileData.size();
+        if (poCodecs == nullptr)
         {
-            CPLError(CE_Failure, CPLE_AppDefined, "Too large tile %s",
-                     osFilename.c_str());
-            bRet = false;
+            nRawDataSize = VSIFReadL(&abyRawTileData[0], 1, nRawDataSize, fp);
         }
         else
         {
-            try
+            VSIFSeekL(fp, 0, SEEK_END);
+            const auto nSize = VSIFTellL(fp);
+            VSIFSeekL(fp, 0, SEEK_SET);
+            if (nSize >
+                static_cast<vsi_l_offset>(std::numeric_limits<int>::max()))
             {
-                abyRawTileData.resize(static_cast<size_t>(nSize));
-            }
-            catch (const std::exception &)
-            {
-                CPLError(CE_Failure, CPLE_OutOfMemory,
-                         "Cannot allocate memory for tile %s",
-                         osFilename.c_str());
-                bRet = false;
-            }
-
-            if (bRet && (abyRawTileData.empty() ||
-                         VSIFReadL(&abyRawTileData[0], 1, abyRawTileData.size(),
-                                   fp) != abyRawTileData.size()))
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Could not read tile %s correctly",
+                CPLError(CE_Failure, CPLE_AppDefined, "Too large tile %s",
                          osFilename.c_str());
                 bRet = false;
             }
             else
             {
-                if (!poCodecs->Decode(abyRawTileData))
+                try
+                {
+                    abyRawTileData.resize(static_cast<size_t>(nSize));
+                }
+                catch (const std::exception &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate memory for tile %s",
+                             osFilename.c_str());
+                    bRet = false;
+                }
+
+                if (bRet &&
+                    (abyRawTileData.empty() ||
+                     VSIFReadL(&abyRawTileData[0], 1, abyRawTileData.size(),
+                               fp) != abyRawTileData.size()))
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
-                             "Decompression of tile %s failed",
+                             "Could not read tile %s correctly",
                              osFilename.c_str());
                     bRet = false;
                 }
+                else
+                {
+                    if (!poCodecs->Decode(abyRawTileData))
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "Decompression of tile %s failed",
+                                 osFilename.c_str());
+                        bRet = false;
+                    }
+                }
             }
         }
-    }
-    VSIFCloseL(fp);
-    if (!bRet)
-        return false;
+        VSIFCloseL(fp);
+        if (!bRet)
+            return false;
 
-    if (nRawDataSize != abyRawTileData.size())
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Decompressed tile %s has not expected size. "
-                 "Got %u instead of %u",
-                 osFilename.c_str(),
-                 static_cast<unsigned>(abyRawTileData.size()),
-                 static_cast<unsigned>(nRawDataSize));
-        return false;
+        if (nRawDataSize != abyRawTileData.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompressed tile %s has not expected size. "
+                     "Got %u instead of %u",
+                     osFilename.c_str(),
+                     static_cast<unsigned>(abyRawTileData.size()),
+                     static_cast<unsigned>(nRawDataSize));
+            return false;
+        }
     }
 
     if (!abyDecodedTileData.empty())
@@ -557,6 +587,240 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 #undef m_poCodecs
 }
 
+/************************************************************************/
+/*                    ZarrV3Array::GetShardIndices()                    */
+/************************************************************************/
+
+// Computes the indices of the shard that contains the tile (inner chunk) of
+// indices tileIndices, and the index of the inner chunk within the shard.
+void ZarrV3Array::GetShardIndices(const uint64_t *tileIndices,
+                                  std::vector<uint64_t> &anShardIndices,
+                                  size_t &nInnerChunkIdx) const
+{
+    CPLAssert(m_poShardingCodec);
+    const auto &anShardSize = m_poShardingCodec->GetShardSize();
+    anShardIndices.resize(m_aoDims.size());
+    nInnerChunkIdx = 0;
+    for (size_t i = 0; i < m_aoDims.size(); ++i)
+    {
+        const uint64_t nChunksPerShard = anShardSize[i] / m_anBlockSize[i];
+        anShardIndices[i] = tileIndices[i] / nChunksPerShard;
+        nInnerChunkIdx = nInnerChunkIdx * static_cast<size_t>(nChunksPerShard) +
+                         static_cast<size_t>(tileIndices[i] % nChunksPerShard);
+    }
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::ReadShardIndex()                    */
+/************************************************************************/
+
+bool ZarrV3Array::ReadShardIndex(
+    VSILFILE *fp, const std::string &osFilename,
+    const ZarrV3CodecShardingIndexed *poShardingCodec,
+    std::vector<uint64_t> &anIndex) const
+{
+    const size_t nIndexSize = poShardingCodec->GetIndexSize();
+    vsi_l_offset nIndexOffset = 0;
+    if (poShardingCodec->IsIndexAtEnd())
+    {
+        VSIFSeekL(fp, 0, SEEK_END);
+        const auto nFileSize = VSIFTellL(fp);
+        if (nFileSize < nIndexSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Shard %s is too small",
+                     osFilename.c_str());
+            return false;
+        }
+        nIndexOffset = nFileSize - nIndexSize;
+    }
+
+    std::vector<GByte> abyIndex;
+    try
+    {
+        abyIndex.resize(nIndexSize);
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    if (VSIFSeekL(fp, nIndexOffset, SEEK_SET) != 0 ||
+        VSIFReadL(abyIndex.data(), 1, nIndexSize, fp) != nIndexSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not read index of shard %s", osFilename.c_str());
+        return false;
+    }
+    return poShardingCodec->DecodeIndex(abyIndex.data(), anIndex);
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::LoadInnerChunkData()                   */
+/************************************************************************/
+
+// Loads and decodes the inner chunk of a shard corresponding to a tile.
+// Only the shard index (once per shard, thanks to m_oCacheShardIndex) and
+// the bytes of the inner chunk are read.
+bool ZarrV3Array::LoadInnerChunkData(
+    const uint64_t *tileIndices, bool bUseMutex,
+    const ZarrV3CodecShardingIndexed *poShardingCodec,
+    ZarrByteVectorQuickResize &abyRawTileData, bool &bMissingTileOut) const
+{
+    // This method should NOT modify any ZarrArray member, except the shard
+    // index cache under m_oMutex, as it is going to be called concurrently
+    // from several threads.
+
+    bMissingTileOut = false;
+
+    std::vector<uint64_t> anShardIndices;
+    size_t nInnerChunkIdx = 0;
+    GetShardIndices(tileIndices, anShardIndices, nInnerChunkIdx);
+    const std::string osFilename = BuildTileFilename(tileIndices);
+
+    const auto DecodeInnerChunk =
+        [this, poShardingCodec, &osFilename, &abyRawTileData]()
+    {
+        if (!poShardingCodec->DecodeInnerChunk(abyRawTileData))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompression of inner chunk of shard %s failed",
+                     osFilename.c_str());
+            return false;
+        }
+        if (abyRawTileData.size() != m_nTileSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompressed inner chunk of shard %s has not expected "
+                     "size. Got %u instead of %u",
+                     osFilename.c_str(),
+                     static_cast<unsigned>(abyRawTileData.size()),
+                     static_cast<unsigned>(m_nTileSize));
+            return false;
+        }
+        return true;
+    };
+
+    // Inner chunks not yet written to their shard. Pending shards are
+    // written by IAdviseRead() before tiles are loaded from worker threads.
+    if (!bUseMutex)
+    {
+        const auto oIterShard = m_oMapPendingShards.find(anShardIndices);
+        if (oIterShard != m_oMapPendingShards.end())
+        {
+            const auto &oMapChunks = oIterShard->second.oMapChunks;
+            const auto oIterChunk = oMapChunks.find(nInnerChunkIdx);
+            if (oIterChunk != oMapChunks.end())
+            {
+                const auto &abyChunk = oIterChunk->second;
+                if (abyChunk.empty())
+                {
+                    bMissingTileOut = true;
+                    return true;
+                }
+                try
+                {
+                    abyRawTileData.resize(abyChunk.size());
+                }
+                catch (const std::bad_alloc &e)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+                    return false;
+                }
+                memcpy(&abyRawTileData[0], abyChunk.data(), abyChunk.size());
+                return DecodeInnerChunk();
+            }
+        }
+    }
+
+    std::shared_ptr<std::vector<uint64_t>> poIndex;
+    bool bIndexInCache;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        bIndexInCache = m_oCacheShardIndex.tryGet(osFilename, poIndex);
+    }
+    if (bIndexInCache && poIndex->empty())
+    {
+        CPLDebugOnly(ZARR_DEBUG_KEY, "Shard %s missing (=nodata)",
+                     osFilename.c_str());
+        bMissingTileOut = true;
+        return true;
+    }
+
+    // Do not use the streaming filename, as we need to seek in the shard
+    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
+                                           nullptr};
+    VSILFILE *fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+    if (fp == nullptr)
+    {
+        // Missing files are OK and indicate nodata_value
+        CPLDebugOnly(ZARR_DEBUG_KEY, "Shard %s missing (=nodata)",
+                     osFilename.c_str());
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oCacheShardIndex.insert(osFilename,
+                                  std::make_shared<std::vector<uint64_t>>());
+        bMissingTileOut = true;
+        return true;
+    }
+
+    if (!bIndexInCache)
+    {
+        poIndex = std::make_shared<std::vector<uint64_t>>();
+        if (!ReadShardIndex(fp, osFilename, poShardingCodec, *poIndex))
+        {
+            VSIFCloseL(fp);
+            return false;
+        }
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oCacheShardIndex.insert(osFilename, poIndex);
+    }
+
+    const uint64_t nOffset = (*poIndex)[2 * nInnerChunkIdx];
+    const uint64_t nSize = (*poIndex)[2 * nInnerChunkIdx + 1];
+    if (nOffset == ZarrV3CodecShardingIndexed::MISSING_CHUNK &&
+        nSize == ZarrV3CodecShardingIndexed::MISSING_CHUNK)
+    {
+        VSIFCloseL(fp);
+        bMissingTileOut = true;
+        return true;
+    }
+
+    bool bRet = true;
+    if (nSize == 0 ||
+        nSize > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid size for inner chunk in shard %s",
+                 osFilename.c_str());
+        bRet = false;
+    }
+    else
+    {
+        try
+        {
+            abyRawTileData.resize(static_cast<size_t>(nSize));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for inner chunk of shard %s",
+                     osFilename.c_str());
+            bRet = false;
+        }
+        if (bRet && (VSIFSeekL(fp, nOffset, SEEK_SET) != 0 ||
+                     VSIFReadL(&abyRawTileData[0], 1, abyRawTileData.size(),
+                               fp) != abyRawTileData.size()))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Could not read inner chunk of shard %s correctly",
+                     osFilename.c_str());
+            bRet = false;
+        }
+    }
+    VSIFCloseL(fp);
+
+    return bRet && DecodeInnerChunk();
+}
+
 /************************************************************************/
 /*                      ZarrV3Array::IAdviseRead()                      */
 /************************************************************************/
@@ -564,6 +828,11 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
                               CSLConstList papszOptions) const
 {
+    // Inner chunks not yet written to their shard are not visible from
+    // worker threads
+    if (!FlushPendingShards())
+        return false;
+
     std::vector<uint64_t> anIndicesCur;
     int nThreadsMax = 0;
     std::vector<uint64_t> anReqTilesIndices;
@@ -725,61 +994,299 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
     return bGlobalStatus;
 }
 
+/************************************************************************/
+/*                  ZarrV3Array::EncodeAndWriteTile()                   */
+/************************************************************************/
+
+bool ZarrV3Array::EncodeAndWriteTile(
+    const std::string &osFilename, ZarrByteVectorQuickResize &abyRawTileData,
+    const ZarrByteVectorQuickResize &abyDecodedTileData, bool bUseMutex) const
+{
+    // When bUseMutex is set, this method is called from a worker thread, and
+    // should NOT modify any ZarrArray member.
+
+    const size_t nSourceSize =
+        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
+
+    if (!abyDecodedTileData.empty())
+    {
+        const size_t nDTSize = m_oType.GetSize();
+        const size_t nValues = abyDecodedTileData.size() / nDTSize;
+        GByte *pDst = &abyRawTileData[0];
+        const GByte *pSrc = abyDecodedTileData.data();
+        for (size_t i = 0; i < nValues;
+             i++, pDst += nSourceSize, pSrc += nDTSize)
+        {
+            EncodeElt(m_aoDtypeElts, pSrc, pDst);
+        }
+    }
+
+    const size_t nSizeBefore = abyRawTileData.size();
+    if (m_poCodecs)
+    {
+        std::unique_ptr<ZarrV3CodecSequence> poLocalCodecs;
+        if (bUseMutex)
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            poLocalCodecs = m_poCodecs->Clone();
+        }
+        auto poCodecs = bUseMutex ? poLocalCodecs.get() : m_poCodecs.get();
+        if (!poCodecs->Encode(abyRawTileData))
+        {
+            abyRawTileData.resize(nSizeBefore);
+            return false;
+        }
+    }
+
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create tile %s",
+                 osFilename.c_str());
+        abyRawTileData.resize(nSizeBefore);
+        return false;
+    }
+
+    bool bRet = true;
+    const size_t nRawDataSize = abyRawTileData.size();
+    if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
+        nRawDataSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not write tile %s correctly", osFilename.c_str());
+        bRet = false;
+    }
+    VSIFCloseL(fp);
+
+    abyRawTileData.resize(nSizeBefore);
+
+    return bRet;
+}
+
 /************************************************************************/
 /*                    ZarrV3Array::FlushDirtyTile()                     */
 /************************************************************************/
 
 bool ZarrV3Array::FlushDirtyTile() const
 {
+    if (!m_poShardingCodec)
+        return ZarrArray::FlushDirtyTile();
+
     if (!m_bDirtyTile)
         return true;
     m_bDirtyTile = false;
 
-    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
-
-    const size_t nSourceSize =
-        m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
+    // Encode the inner chunk, and keep it in memory until all the inner
+    // chunks of its shard have been written, or until Flush(), so that
+    // shards are not rewritten for each of their inner chunks.
     const auto &abyTile =
         m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
-
+    std::vector<GByte> abyEncodedChunk;
     if (IsEmptyTile(abyTile))
     {
         m_bCachedTiledEmpty = true;
+    }
+    else
+    {
+        if (!m_abyDecodedTileData.empty())
+        {
+            const size_t nSourceSize = m_aoDtypeElts.back().nativeOffset +
+                                       m_aoDtypeElts.back().nativeSize;
+            const size_t nDTSize = m_oType.GetSize();
+            const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
+            GByte *pDst = &m_abyRawTileData[0];
+            const GByte *pSrc = m_abyDecodedTileData.data();
+            for (size_t i = 0; i < nValues;
+                 i++, pDst += nSourceSize, pSrc += nDTSize)
+            {
+                EncodeElt(m_aoDtypeElts, pSrc, pDst);
+            }
+        }
 
-        VSIStatBufL sStat;
-        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        ZarrByteVectorQuickResize abyChunk;
+        try
         {
-            CPLDebugOnly(ZARR_DEBUG_KEY,
-                         "Deleting tile %s that has now empty content",
-                         osFilename.c_str());
-            return VSIUnlink(osFilename.c_str()) == 0;
+            abyChunk.resize(m_abyRawTileData.size());
         }
-        return true;
+        catch (const std::bad_alloc &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            return false;
+        }
+        memcpy(&abyChunk[0], m_abyRawTileData.data(), m_abyRawTileData.size());
+        if (!m_poShardingCodec->EncodeInnerChunk(abyChunk))
+            return false;
+        abyEncodedChunk.assign(abyChunk.data(),
+                               abyChunk.data() + abyChunk.size());
     }
 
-    if (!m_abyDecodedTileData.empty())
+    std::vector<uint64_t> anShardIndices;
+    size_t nInnerChunkIdx = 0;
+    GetShardIndices(m_anCachedTiledIndices.data(), anShardIndices,
+                    nInnerChunkIdx);
+
+    auto oIter = m_oMapPendingShards.find(anShardIndices);
+    if (oIter == m_oMapPendingShards.end())
     {
-        const size_t nDTSize = m_oType.GetSize();
-        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
-        GByte *pDst = &m_abyRawTileData[0];
-        const GByte *pSrc = m_abyDecodedTileData.data();
-        for (size_t i = 0; i < nValues;
-             i++, pDst += nSourceSize, pSrc += nDTSize)
+        PendingShard oPendingShard;
+        oPendingShard.nExpectedChunks = 1;
+        const auto &anShardSize = m_poShardingCodec->GetShardSize();
+        for (size_t i = 0; i < m_aoDims.size(); ++i)
         {
-            EncodeElt(m_aoDtypeElts, pSrc, pDst);
+            const uint64_t nChunksPerShard = anShardSize[i] / m_anBlockSize[i];
+            const uint64_t nTileCount =
+                DIV_ROUND_UP(m_aoDims[i]->GetSize(), m_anBlockSize[i]);
+            const uint64_t nFirstTile = anShardIndices[i] * nChunksPerShard;
+            oPendingShard.nExpectedChunks *= static_cast<size_t>(
+                std::min(nFirstTile + nChunksPerShard, nTileCount) -
+                nFirstTile);
         }
+        oIter = m_oMapPendingShards
+                    .emplace(anShardIndices, std::move(oPendingShard))
+                    .first;
     }
+    oIter->second.oMapChunks[nInnerChunkIdx] = std::move(abyEncodedChunk);
 
-    const size_t nSizeBefore = m_abyRawTileData.size();
-    if (m_poCodecs)
+    if (oIter->second.oMapChunks.size() == oIter->second.nExpectedChunks)
     {
-        if (!m_poCodecs->Encode(m_abyRawTileData))
+        const bool bRet = WriteShard(anShardIndices, oIter->second);
+        m_oMapPendingShards.erase(oIter);
+        return bRet;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                      ZarrV3Array::WriteShard()                       */
+/************************************************************************/
+
+// Writes a shard made of the inner chunks of oPendingShard, and of the other
+// inner chunks of the existing shard, if any.
+bool ZarrV3Array::WriteShard(const std::vector<uint64_t> &anShardIndices,
+                             const PendingShard &oPendingShard) const
+{
+    const auto &anShardSize = m_poShardingCodec->GetShardSize();
+    std::vector<uint64_t> anTileIndices(m_aoDims.size());
+    for (size_t i = 0; i < m_aoDims.size(); ++i)
+    {
+        anTileIndices[i] =
+            anShardIndices[i] * (anShardSize[i] / m_anBlockSize[i]);
+    }
+    const std::string osFilename = BuildTileFilename(anTileIndices.data());
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oCacheShardIndex.remove(osFilename);
+    }
+
+    const size_t nChunkCount = m_poShardingCodec->GetInnerChunkCount();
+    VSILFILE *fpOld = nullptr;
+    std::vector<uint64_t> anOldIndex;
+    if (oPendingShard.oMapChunks.size() < nChunkCount)
+    {
+        fpOld = VSIFOpenL(osFilename.c_str(), "rb");
+        if (fpOld &&
+            !ReadShardIndex(fpOld, osFilename, m_poShardingCodec, anOldIndex))
         {
-            m_abyRawTileData.resize(nSizeBefore);
+            VSIFCloseL(fpOld);
             return false;
         }
     }
 
+    constexpr uint64_t MISSING_CHUNK =
+        ZarrV3CodecShardingIndexed::MISSING_CHUNK;
+    const bool bIndexAtEnd = m_poShardingCodec->IsIndexAtEnd();
+    const size_t nIndexSize = m_poShardingCodec->GetIndexSize();
+    std::vector<uint64_t> anIndex;
+    std::vector<GByte> abyShard;
+    bool bRet = true;
+    bool bHasChunks = false;
+    try
+    {
+        anIndex.resize(2 * nChunkCount, MISSING_CHUNK);
+        if (!bIndexAtEnd)
+            abyShard.resize(nIndexSize);
+        for (size_t iChunk = 0; bRet && iChunk < nChunkCount; ++iChunk)
+        {
+            const auto oIter = oPendingShard.oMapChunks.find(iChunk);
+            if (oIter != oPendingShard.oMapChunks.end())
+            {
+                const auto &abyChunk = oIter->second;
+                if (!abyChunk.empty())
+                {
+                    anIndex[2 * iChunk] = abyShard.size();
+                    anIndex[2 * iChunk + 1] = abyChunk.size();
+                    abyShard.insert(abyShard.end(), abyChunk.begin(),
+                                    abyChunk.end());
+                    bHasChunks = true;
+                }
+            }
+            else if (fpOld && !(anOldIndex[2 * iChunk] == MISSING_CHUNK &&
+                                anOldIndex[2 * iChunk + 1] == MISSING_CHUNK))
+            {
+                const uint64_t nOldOffset = anOldIndex[2 * iChunk];
+                const uint64_t nOldSize = anOldIndex[2 * iChunk + 1];
+                const size_t nOffset = abyShard.size();
+                if (nOldSize > static_cast<uint64_t>(
+                                   std::numeric_limits<int>::max()))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Invalid size for inner chunk in shard %s",
+                             osFilename.c_str());
+                    bRet = false;
+                    break;
+                }
+                abyShard.resize(nOffset + static_cast<size_t>(nOldSize));
+                if (VSIFSeekL(fpOld, nOldOffset, SEEK_SET) != 0 ||
+                    VSIFReadL(abyShard.data() + nOffset, 1,
+                              static_cast<size_t>(nOldSize),
+                              fpOld) != nOldSize)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Could not read inner chunk of shard %s correctly",
+                             osFilename.c_str());
+                    bRet = false;
+                    break;
+                }
+                anIndex[2 * iChunk] = nOffset;
+                anIndex[2 * iChunk + 1] = nOldSize;
+                bHasChunks = true;
+            }
+        }
+        if (bRet && bHasChunks)
+        {
+            std::vector<GByte> abyIndex;
+            m_poShardingCodec->EncodeIndex(anIndex, abyIndex);
+            if (bIndexAtEnd)
+                abyShard.insert(abyShard.end(), abyIndex.begin(),
+                                abyIndex.end());
+            else
+                memcpy(abyShard.data(), abyIndex.data(), nIndexSize);
+        }
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        bRet = false;
+    }
+    if (fpOld)
+        VSIFCloseL(fpOld);
+    if (!bRet)
+        return false;
+
+    if (!bHasChunks)
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        {
+            CPLDebugOnly(ZARR_DEBUG_KEY,
+                         "Deleting shard %s that has now empty content",
+                         osFilename.c_str());
+            return VSIUnlink(osFilename.c_str()) == 0;
+        }
+        return true;
+    }
+
     if (m_osDimSeparator == "/")
     {
         std::string osDir = CPLGetDirname(osFilename.c_str());
@@ -790,7 +1297,6 @@ bool ZarrV3Array::FlushDirtyTile() const
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot create directory %s", osDir.c_str());
-                m_abyRawTileData.resize(nSizeBefore);
                 return false;
             }
         }
@@ -799,25 +1305,34 @@ bool ZarrV3Array::FlushDirtyTile() const
     VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
     if (fp == nullptr)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create tile %s",
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create shard %s",
                  osFilename.c_str());
-        m_abyRawTileData.resize(nSizeBefore);
         return false;
     }
-
-    bool bRet = true;
-    const size_t nRawDataSize = m_abyRawTileData.size();
-    if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
-        nRawDataSize)
+    if (VSIFWriteL(abyShard.data(), 1, abyShard.size(), fp) != abyShard.size())
     {
         CPLError(CE_Failure, CPLE_AppDefined,
-                 "Could not write tile %s correctly", osFilename.c_str());
+                 "Could not write shard %s correctly", osFilename.c_str());
         bRet = false;
     }
     VSIFCloseL(fp);
 
-    m_abyRawTileData.resize(nSizeBefore);
+    return bRet;
+}
+
+/************************************************************************/
+/*                  ZarrV3Array::FlushPendingShards()                   */
+/************************************************************************/
 
+bool ZarrV3Array::FlushPendingShards() const
+{
+    bool bRet = true;
+    for (const auto &oIter : m_oMapPendingShards)
+    {
+        if (!WriteShard(oIter.first, oIter.second))
+            bRet = false;
+    }
+    m_oMapPendingShards.clear();
     return bRet;
 }
 
@@ -834,6 +1349,15 @@ std::string ZarrV3Array::BuildTileFilename(const uint64_t *tileIndices) const
     }
     else
     {
+        // With sharding, tiles are inner chunks, stored in the shard file
+        std::vector<uint64_t> anShardIndices;
+        if (m_poShardingCodec)
+        {
+            size_t nInnerChunkIdx = 0;
+            GetShardIndices(tileIndices, anShardIndices, nInnerChunkIdx);
+            tileIndices = anShardIndices.data();
+        }
+
         std::string osFilename(CPLGetDirname(m_osFilename.c_str()));
         osFilename += '/';
         if (!m_bV2ChunkKeyEncoding)
@@ -1599,6 +2123,14 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
         poCodecs = std::make_unique<ZarrV3CodecSequence>(oInputArrayMetadata);
         if (!poCodecs->InitFromJson(oCodecs))
             return nullptr;
+
+        // With sharding, the tiles of the array are the inner chunks
+        if (const auto poShardingCodec = poCodecs->GetShardingIndexedCodec())
+        {
+            const auto &anInnerBlockSize = poShardingCodec->GetInnerBlockSize();
+            for (size_t i = 0; i < anBlockSize.size(); ++i)
+                anBlockSize[i] = anInnerBlockSize[i];
+        }
     }
 
     auto poArray =
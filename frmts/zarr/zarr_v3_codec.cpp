@@ -916,6 +916,382 @@ bool ZarrV3CodecTranspose::Decode(const ZarrByteVectorQuickResize &abySrc,
     return Transpose(abySrc, abyDst, false);
 }
 
+/************************************************************************/
+/*                   ZarrV3CodecShardingIndexed()                       */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed::ZarrV3CodecShardingIndexed() : ZarrV3Codec(NAME)
+{
+}
+
+/************************************************************************/
+/*                  ~ZarrV3CodecShardingIndexed()                       */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed::~ZarrV3CodecShardingIndexed() = default;
+
+/************************************************************************/
+/*             ZarrV3CodecShardingIndexed::GetConfiguration()           */
+/************************************************************************/
+
+/* static */ CPLJSONObject ZarrV3CodecShardingIndexed::GetConfiguration(
+    const std::vector<GUInt64> &anInnerBlockSize, const CPLJSONArray &oCodecs)
+{
+    CPLJSONObject oConfig;
+    CPLJSONArray oChunkShape;
+    for (const auto nSize : anInnerBlockSize)
+        oChunkShape.Add(static_cast<GInt64>(nSize));
+    oConfig.Add("chunk_shape", oChunkShape);
+    oConfig.Add("codecs", oCodecs);
+
+    CPLJSONArray oIndexCodecs;
+    {
+        CPLJSONObject oCodec;
+        oCodec.Add("name", "endian");
+        oCodec.Add("configuration", ZarrV3CodecEndian::GetConfiguration(true));
+        oIndexCodecs.Add(oCodec);
+    }
+    {
+        CPLJSONObject oCodec;
+        oCodec.Add("name", "crc32c");
+        oIndexCodecs.Add(oCodec);
+    }
+    oConfig.Add("index_codecs", oIndexCodecs);
+    oConfig.Add("index_location", "end");
+    return oConfig;
+}
+
+/************************************************************************/
+/*          ZarrV3CodecShardingIndexed::InitFromConfiguration()         */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::InitFromConfiguration(
+    const CPLJSONObject &configuration,
+    const ZarrArrayMetadata &oInputArrayMetadata,
+    ZarrArrayMetadata &oOutputArrayMetadata)
+{
+    m_oConfiguration = configuration.Clone();
+    m_oInputArrayMetadata = oInputArrayMetadata;
+    oOutputArrayMetadata = oInputArrayMetadata;
+
+    if (!configuration.IsValid() ||
+        configuration.GetType() != CPLJSONObject::Type::Object)
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "Codec sharding_indexed: configuration missing or not an object");
+        return false;
+    }
+
+    for (const auto &oChild : configuration.GetChildren())
+    {
+        const auto osName = oChild.GetName();
+        if (osName != "chunk_shape" && osName != "codecs" &&
+            osName != "index_codecs" && osName != "index_location")
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: configuration contains a "
+                     "unhandled member: %s",
+                     osName.c_str());
+            return false;
+        }
+    }
+
+    // Parse chunk_shape
+    const auto oChunkShape = configuration.GetArray("chunk_shape");
+    const size_t nDims = oInputArrayMetadata.anBlockSizes.size();
+    if (!oChunkShape.IsValid() ||
+        static_cast<size_t>(oChunkShape.Size()) != nDims)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: chunk_shape missing or not an "
+                 "array of the expected number of elements");
+        return false;
+    }
+    m_anInnerBlockSize.clear();
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const auto nSize = oChunkShape[static_cast<int>(i)].ToLong();
+        const size_t nShardSize = oInputArrayMetadata.anBlockSizes[i];
+        if (nSize <= 0 || static_cast<uint64_t>(nSize) > nShardSize ||
+            (nShardSize % static_cast<size_t>(nSize)) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: chunk_shape[%d] is not a "
+                     "divisor of the shard shape",
+                     static_cast<int>(i));
+            return false;
+        }
+        m_anInnerBlockSize.push_back(static_cast<size_t>(nSize));
+    }
+
+    // Bound the number of inner chunks, and thus the size of the shard index
+    // that must be read and held in memory for each shard.
+    constexpr size_t MAX_INDEX_SIZE = 256 * 1024 * 1024;
+    constexpr size_t MAX_INNER_CHUNK_COUNT =
+        MAX_INDEX_SIZE / (2 * sizeof(uint64_t));
+    size_t nInnerChunkCount = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const size_t nChunksInDim =
+            oInputArrayMetadata.anBlockSizes[i] / m_anInnerBlockSize[i];
+        if (nChunksInDim > MAX_INNER_CHUNK_COUNT / nInnerChunkCount)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Codec sharding_indexed: too many inner chunks per "
+                     "shard. At most %u are supported",
+                     static_cast<unsigned>(MAX_INNER_CHUNK_COUNT));
+            return false;
+        }
+        nInnerChunkCount *= nChunksInDim;
+    }
+
+    // Parse codecs
+    const auto oCodecs = configuration.GetArray("codecs");
+    if (!oCodecs.IsValid())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: codecs missing or not an array");
+        return false;
+    }
+    for (const auto &oCodec : oCodecs)
+    {
+        if (oCodec["name"].ToString() == NAME)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Codec sharding_indexed: nested sharding not supported");
+            return false;
+        }
+    }
+    ZarrArrayMetadata oInnerArrayMetadata;
+    oInnerArrayMetadata.anBlockSizes = m_anInnerBlockSize;
+    oInnerArrayMetadata.oElt = oInputArrayMetadata.oElt;
+    m_poCodecs = std::make_unique<ZarrV3CodecSequence>(oInnerArrayMetadata);
+    if (!m_poCodecs->InitFromJson(oCodecs))
+        return false;
+
+    // Parse index_codecs. Only a little-endian encoding of the index,
+    // optionally followed by a CRC32C checksum, is supported.
+    m_bIndexHasCRC32C = false;
+    const auto oIndexCodecs = configuration.GetArray("index_codecs");
+    if (oIndexCodecs.IsValid())
+    {
+        int i = 0;
+        for (const auto &oCodec : oIndexCodecs)
+        {
+            const auto osName = oCodec["name"].ToString();
+            if (i == 0 && (osName == "endian" || osName == "bytes"))
+            {
+                const auto oEndian = oCodec["configuration"]["endian"];
+                if (oEndian.IsValid() && oEndian.ToString() != "little")
+                {
+                    CPLError(CE_Failure, CPLE_NotSupported,
+                             "Codec sharding_indexed: only little-endian "
+                             "index is supported");
+                    return false;
+                }
+            }
+            else if (i == 1 && osName == "crc32c")
+            {
+                m_bIndexHasCRC32C = true;
+            }
+            else
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Codec sharding_indexed: unsupported index codec: %s",
+                         osName.c_str());
+                return false;
+            }
+            ++i;
+        }
+    }
+
+    // Parse index_location
+    const auto osIndexLocation =
+        configuration.GetString("index_location", "end");
+    if (osIndexLocation != "end" && osIndexLocation != "start")
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Codec sharding_indexed: invalid value for index_location");
+        return false;
+    }
+    m_bIndexLocationAtEnd = osIndexLocation == "end";
+
+    return true;
+}
+
+/************************************************************************/
+/*                ZarrV3CodecShardingIndexed::Clone()                   */
+/************************************************************************/
+
+std::unique_ptr<ZarrV3Codec> ZarrV3CodecShardingIndexed::Clone() const
+{
+    auto psClone = std::make_unique<ZarrV3CodecShardingIndexed>();
+    ZarrArrayMetadata oOutputArrayMetadata;
+    psClone->InitFromConfiguration(m_oConfiguration, m_oInputArrayMetadata,
+                                   oOutputArrayMetadata);
+    return psClone;
+}
+
+/************************************************************************/
+/*                ZarrV3CodecShardingIndexed::Encode()                  */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::Encode(const ZarrByteVectorQuickResize &,
+                                        ZarrByteVectorQuickResize &) const
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "Codec sharding_indexed: encoding of a whole shard not supported");
+    return false;
+}
+
+/************************************************************************/
+/*                ZarrV3CodecShardingIndexed::Decode()                  */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::Decode(const ZarrByteVectorQuickResize &,
+                                        ZarrByteVectorQuickResize &) const
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "Codec sharding_indexed: decoding of a whole shard not supported");
+    return false;
+}
+
+/************************************************************************/
+/*          ZarrV3CodecShardingIndexed::GetInnerChunkCount()            */
+/************************************************************************/
+
+// Returns the number of inner chunks in a shard
+size_t ZarrV3CodecShardingIndexed::GetInnerChunkCount() const
+{
+    size_t nCount = 1;
+    for (size_t i = 0; i < m_anInnerBlockSize.size(); ++i)
+        nCount *= GetShardSize()[i] / m_anInnerBlockSize[i];
+    return nCount;
+}
+
+/************************************************************************/
+/*             ZarrV3CodecShardingIndexed::GetIndexSize()               */
+/************************************************************************/
+
+// Returns the size in bytes of the encoded shard index
+size_t ZarrV3CodecShardingIndexed::GetIndexSize() const
+{
+    return GetInnerChunkCount() * 2 * sizeof(uint64_t) +
+           (m_bIndexHasCRC32C ? sizeof(uint32_t) : 0);
+}
+
+/************************************************************************/
+/*                          ComputeCRC32C()                             */
+/************************************************************************/
+
+// CRC-32C (Castagnoli polynomial), as used by the crc32c codec
+static uint32_t ComputeCRC32C(const GByte *pabyData, size_t nSize)
+{
+    static const std::array<uint32_t, 256> anTable = []()
+    {
+        std::array<uint32_t, 256> anTableTmp;
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t nVal = i;
+            for (int j = 0; j < 8; ++j)
+                nVal = (nVal & 1) ? (nVal >> 1) ^ 0x82F63B78U : (nVal >> 1);
+            anTableTmp[i] = nVal;
+        }
+        return anTableTmp;
+    }();
+
+    uint32_t nCRC = 0xFFFFFFFFU;
+    for (size_t i = 0; i < nSize; ++i)
+        nCRC = anTable[(nCRC ^ pabyData[i]) & 0xFF] ^ (nCRC >> 8);
+    return nCRC ^ 0xFFFFFFFFU;
+}
+
+/************************************************************************/
+/*              ZarrV3CodecShardingIndexed::DecodeIndex()               */
+/************************************************************************/
+
+// Decode the GetIndexSize() bytes pointed by pabyIndex into a vector of
+// (offset, size) pairs for each inner chunk.
+bool ZarrV3CodecShardingIndexed::DecodeIndex(
+    const GByte *pabyIndex, std::vector<uint64_t> &anIndex) const
+{
+    const size_t nValues = 2 * GetInnerChunkCount();
+    if (m_bIndexHasCRC32C)
+    {
+        uint32_t nExpectedCRC;
+        memcpy(&nExpectedCRC, pabyIndex + nValues * sizeof(uint64_t),
+               sizeof(nExpectedCRC));
+        CPL_LSBPTR32(&nExpectedCRC);
+        if (ComputeCRC32C(pabyIndex, nValues * sizeof(uint64_t)) !=
+            nExpectedCRC)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Codec sharding_indexed: CRC32C checksum of shard index "
+                     "does not match");
+            return false;
+        }
+    }
+    try
+    {
+        anIndex.resize(nValues);
+    }
+    catch (const std::bad_alloc &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return false;
+    }
+    memcpy(anIndex.data(), pabyIndex, nValues * sizeof(uint64_t));
+#if !CPL_IS_LSB
+    for (auto &nVal : anIndex)
+        CPL_SWAP64PTR(&nVal);
+#endif
+    return true;
+}
+
+/************************************************************************/
+/*              ZarrV3CodecShardingIndexed::EncodeIndex()               */
+/************************************************************************/
+
+void ZarrV3CodecShardingIndexed::EncodeIndex(
+    const std::vector<uint64_t> &anIndex, std::vector<GByte> &abyIndex) const
+{
+    CPLAssert(anIndex.size() == 2 * GetInnerChunkCount());
+    const size_t nIndexBytes = anIndex.size() * sizeof(uint64_t);
+    abyIndex.resize(GetIndexSize());
+    memcpy(abyIndex.data(), anIndex.data(), nIndexBytes);
+#if !CPL_IS_LSB
+    for (size_t i = 0; i < anIndex.size(); ++i)
+        CPL_SWAP64PTR(abyIndex.data() + i * sizeof(uint64_t));
+#endif
+    if (m_bIndexHasCRC32C)
+    {
+        uint32_t nCRC = ComputeCRC32C(abyIndex.data(), nIndexBytes);
+        CPL_LSBPTR32(&nCRC);
+        memcpy(abyIndex.data() + nIndexBytes, &nCRC, sizeof(nCRC));
+    }
+}
+
+/************************************************************************/
+/*            ZarrV3CodecShardingIndexed::EncodeInnerChunk()            */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::EncodeInnerChunk(
+    ZarrByteVectorQuickResize &abyBuffer) const
+{
+    return m_poCodecs->Encode(abyBuffer);
+}
+
+/************************************************************************/
+/*            ZarrV3CodecShardingIndexed::DecodeInnerChunk()            */
+/************************************************************************/
+
+bool ZarrV3CodecShardingIndexed::DecodeInnerChunk(
+    ZarrByteVectorQuickResize &abyBuffer) const
+{
+    return m_poCodecs->Decode(abyBuffer);
+}
+
 /************************************************************************/
 /*                    ZarrV3CodecSequence::Clone()                      */
 /************************************************************************/
@@ -984,6 +1360,17 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
             poCodec = std::make_unique<ZarrV3CodecEndian>();
         else if (osName == "transpose")
             poCodec = std::make_unique<ZarrV3CodecTranspose>();
+        else if (osName == ZarrV3CodecShardingIndexed::NAME)
+        {
+            if (oCodecsArray.Size() != 1)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Codec sharding_indexed is only supported as the "
+                         "single codec of an array");
+                return false;
+            }
+            poCodec = std::make_unique<ZarrV3CodecShardingIndexed>();
+        }
         else
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unsupported codec: %s",
@@ -1031,6 +1418,20 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
     return true;
 }
 
+/************************************************************************/
+/*           ZarrV3CodecSequence::GetShardingIndexedCodec()             */
+/************************************************************************/
+
+ZarrV3CodecShardingIndexed *ZarrV3CodecSequence::GetShardingIndexedCodec() const
+{
+    if (m_apoCodecs.size() == 1 &&
+        m_apoCodecs[0]->GetName() == ZarrV3CodecShardingIndexed::NAME)
+    {
+        return static_cast<ZarrV3CodecShardingIndexed *>(m_apoCodecs[0].get());
+    }
+    return nullptr;
+}
+
 /************************************************************************/
 /*                  ZarrV3CodecEndian::AllocateBuffer()                 */
 /************************************************************************/
@@ -551,6 +551,41 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
                                   papszOptions))
         return nullptr;
 
+    // Shard size, when using the sharding_indexed codec. anBlockSize is then
+    // the size of the inner chunks.
+    std::vector<GUInt64> anShardSize;
+    const char *pszShardBlockSize =
+        CSLFetchNameValue(papszOptions, "SHARD_BLOCKSIZE");
+    if (pszShardBlockSize)
+    {
+        const CPLStringList aosTokens(
+            CSLTokenizeString2(pszShardBlockSize, ",", 0));
+        if (static_cast<size_t>(aosTokens.size()) != aoDimensions.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid number of values in SHARD_BLOCKSIZE");
+            return nullptr;
+        }
+        for (size_t i = 0; i < aoDimensions.size(); ++i)
+        {
+            anShardSize.push_back(
+                static_cast<GUInt64>(CPLAtoGIntBig(aosTokens[i])));
+            if (anShardSize[i] == 0 || (anShardSize[i] % anBlockSize[i]) != 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Values in SHARD_BLOCKSIZE should be multiple of "
+                         "the ones of BLOCKSIZE");
+                return nullptr;
+            }
+            if (anShardSize[i] > std::numeric_limits<uint32_t>::max())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Too large values in SHARD_BLOCKSIZE");
+                return nullptr;
+            }
+        }
+    }
+
     const char *pszDimSeparator =
         CSLFetchNameValueDef(papszOptions, "DIM_SEPARATOR", "/");
 
@@ -668,13 +703,25 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
         return nullptr;
     }
 
+    if (!anShardSize.empty())
+    {
+        // The above codecs are applied to each inner chunk of the shards
+        CPLJSONObject oCodec;
+        oCodec.Add("name", ZarrV3CodecShardingIndexed::NAME);
+        oCodec.Add("configuration",
+                   ZarrV3CodecShardingIndexed::GetConfiguration(anBlockSize,
+                                                                oCodecs));
+        oCodecs = CPLJSONArray();
+        oCodecs.Add(oCodec);
+    }
+
     if (oCodecs.Size() > 0)
     {
         // Byte swapping will be done by the codec chain
         aoDtypeElts.back().needByteSwapping = false;
 
         ZarrArrayMetadata oInputArrayMetadata;
-        for (auto &nSize : anBlockSize)
+        for (auto &nSize : anShardSize.empty() ? anBlockSize : anShardSize)
             oInputArrayMetadata.anBlockSizes.push_back(
                 static_cast<size_t>(nSize));
         oInputArrayMetadata.oElt = aoDtypeElts.back();
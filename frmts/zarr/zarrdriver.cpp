@@ -732,6 +732,16 @@ void ZarrDriver::InitMetadata()
             psBlockSizeNode, "description",
             "Comma separated list of chunk size along each dimension");
 
+        auto psShardBlockSizeNode =
+            CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psShardBlockSizeNode, "name",
+                                   "SHARD_BLOCKSIZE");
+        CPLAddXMLAttributeAndValue(psShardBlockSizeNode, "type", "string");
+        CPLAddXMLAttributeAndValue(
+            psShardBlockSizeNode, "description",
+            "Comma separated list of shard size along each dimension "
+            "(only for ZARR_V3)");
+
         auto psChunkMemoryLayout =
             CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
         CPLAddXMLAttributeAndValue(psChunkMemoryLayout, "name",
@@ -202,6 +202,9 @@ class CPL_DLL GDALProxyRasterBand : public GDALRasterBand
     CPLVirtualMem *GetVirtualMemAuto(GDALRWFlag eRWFlag, int *pnPixelSpace,
                                      GIntBig *pnLineSpace,
                                      char **papszOptions) override;
+    CPLVirtualMem *GetBlockVirtualMem(int nXBlockOff, int nYBlockOff,
+                                      int *pnPixelSpace, GIntBig *pnLineSpace,
+                                      CSLConstList papszOptions) override;
 
   private:
     CPL_DISALLOW_COPY_ASSIGN(GDALProxyRasterBand)
@@ -230,6 +233,7 @@ class CPL_DLL GDALProxyPoolDataset : public GDALProxyDataset
     GDAL_GCP *pasGCPList = nullptr;
     CPLHashSet *metadataSet = nullptr;
     CPLHashSet *metadataItemSet = nullptr;
+    bool m_bMetadataModified = false;
 
     mutable GDALProxyPoolCacheEntry *cacheEntry = nullptr;
     char *m_pszOwner = nullptr;
@@ -288,7 +292,13 @@ class CPL_DLL GDALProxyPoolDataset : public GDALProxyDataset
     // Special behavior for the following methods : they return a pointer
     // data type, that must be cached by the proxy, so it doesn't become invalid
     // when the underlying object get closed.
+    // For read-only datasets, the cached values are also returned without
+    // re-opening the underlying dataset when it has been evicted from the
+    // pool, unless metadata has been set through the proxy.
     char **GetMetadata(const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
     const char *GetMetadataItem(const char *pszName,
                                 const char *pszDomain) override;
 
@@ -313,6 +323,7 @@ class CPL_DLL GDALProxyPoolRasterBand : public GDALProxyRasterBand
   private:
     CPLHashSet *metadataSet = nullptr;
     CPLHashSet *metadataItemSet = nullptr;
+    bool m_bMetadataModified = false;
     char *pszUnitType = nullptr;
     char **papszCategoryNames = nullptr;
     GDALColorTable *poColorTable = nullptr;
@@ -346,7 +357,13 @@ class CPL_DLL GDALProxyPoolRasterBand : public GDALProxyRasterBand
     // Special behavior for the following methods : they return a pointer
     // data type, that must be cached by the proxy, so it doesn't become invalid
     // when the underlying object get closed.
+    // For read-only datasets, the cached values are also returned without
+    // re-opening the underlying dataset when it has been evicted from the
+    // pool, unless metadata has been set through the proxy.
     char **GetMetadata(const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
     const char *GetMetadataItem(const char *pszName,
                                 const char *pszDomain) override;
     char **GetCategoryNames() override;
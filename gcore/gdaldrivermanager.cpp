@@ -49,6 +49,7 @@
 #include "gdal_pam.h"
 #include "gdal_version_full/gdal_version.h"
 #include "gdal_thread_pool.h"
+#include "gdalmultidim_chunkcache.h"
 #include "ogr_srs_api.h"
 #include "ograpispy.h"
 #ifdef HAVE_XERCES
@@ -237,6 +238,8 @@ GDALDriverManager::~GDALDriverManager()
 
     GDALDestroyGlobalThreadPool();
 
+    GDALMDArrayChunkCache::GetSingleton().Clear();
+
     /* -------------------------------------------------------------------- */
     /*      Cleanup local memory.                                           */
     /* -------------------------------------------------------------------- */
@@ -46,6 +46,7 @@
 #include "memmultidim.h"
 #include "ogrsf_frmts.h"
 #include "gdalmultidim_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__clang__) || defined(_MSC_VER)
 #define COMPILER_WARNS_ABOUT_ABSTRACT_VBASE_INIT
@@ -3754,6 +3755,17 @@ bool GDALMDArray::CopyFromAllExceptValues(const GDALMDArray *poSrcArray,
 /************************************************************************/
 
 /** Copy the content of an array into a new (generally empty) array.
+ *
+ * The copy is done by chunks whose size is a multiple of the block size of
+ * the destination array, and bounded by the GDAL_SWATH_SIZE configuration
+ * option (defaults to a quarter of GDAL_CACHEMAX).
+ *
+ * Starting with GDAL 3.9, when the GDAL_MDARRAY_COPY_PIPELINED configuration
+ * option is set to YES, the next chunk is read from the source array by a
+ * worker thread while the current one is written to this array. Two chunk
+ * buffers are then used, within the GDAL_SWATH_SIZE budget. The source and
+ * destination arrays are then accessed concurrently, so this must only be
+ * enabled when their drivers do not share a library that is not thread-safe.
  *
  * @param poSrcDS    Source dataset. Might be nullptr (but for correct behavior
  *                   of some output drivers this is not recommended)
@@ -3821,6 +3833,123 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
             GUInt64 nTotalBytesThisArray = 0;
             bool bStop = false;
 
+            // Used when GDAL_MDARRAY_COPY_PIPELINED=YES: the next chunk is
+            // read from the source array by a worker thread, while the current
+            // one is written to the destination array by the calling thread.
+            std::unique_ptr<CPLJobQueue> poJobQueue{};
+            std::string osNumThreads{};
+            GDALAbstractMDArray *poSrcArray = nullptr;
+            std::vector<GByte> abyTmpRead{};
+            std::vector<GUInt64> anReadStartIdx{};
+            std::vector<size_t> anReadCount{};
+            GUInt64 iReadChunk = 0;
+            GUInt64 nReadChunkCount = 0;
+            bool bReadPending = false;
+            bool bReadOK = false;
+            std::vector<CPLErrorHandlerAccumulatorStruct> aoReadErrors{};
+
+            static void ReadJob(void *pUserData)
+            {
+                auto data = static_cast<CopyFunc *>(pUserData);
+                // Drivers may use GDAL_NUM_THREADS, which could have been
+                // set as a thread-local option by the caller.
+                CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS",
+                                              data->osNumThreads.c_str(),
+                                              false);
+                CPLInstallErrorHandlerAccumulator(data->aoReadErrors);
+                data->bReadOK = data->poSrcArray->Read(
+                    data->anReadStartIdx.data(), data->anReadCount.data(),
+                    nullptr, nullptr, data->poSrcArray->GetDataType(),
+                    &data->abyTmpRead[0]);
+                CPLUninstallErrorHandlerAccumulator();
+            }
+
+            // Wait for the pending read, and re-emit its errors in the
+            // calling thread.
+            bool WaitRead()
+            {
+                if (!bReadPending)
+                    return true;
+                poJobQueue->WaitCompletion();
+                bReadPending = false;
+                for (const auto &oError : aoReadErrors)
+                {
+                    CPLError(oError.type, oError.no, "%s",
+                             oError.msg.c_str());
+                }
+                aoReadErrors.clear();
+                return bReadOK;
+            }
+
+            // Write the chunk read by the last job, whose content is
+            // in abyTmp after WaitRead() and the swap of buffers.
+            bool WriteReadChunk()
+            {
+                if (!poDstArray->Write(anReadStartIdx.data(),
+                                       anReadCount.data(), nullptr, nullptr,
+                                       poSrcArray->GetDataType(), &abyTmp[0]))
+                {
+                    return false;
+                }
+                return Progress(iReadChunk, nReadChunkCount);
+            }
+
+            bool Progress(GUInt64 iCurChunk, GUInt64 nChunkCount)
+            {
+                double dfCurCost =
+                    double(nCurCost) +
+                    double(iCurChunk) / nChunkCount * nTotalBytesThisArray;
+                if (!pfnProgress(dfCurCost / nTotalCost, "", pProgressData))
+                {
+                    bStop = true;
+                    return false;
+                }
+                return true;
+            }
+
+            static bool fPipelined(GDALAbstractMDArray *l_poSrcArray,
+                                   const GUInt64 *chunkArrayStartIdx,
+                                   const size_t *chunkCount, GUInt64 iCurChunk,
+                                   GUInt64 nChunkCount, void *pUserData)
+            {
+                auto data = static_cast<CopyFunc *>(pUserData);
+                const bool bHasPreviousChunk = data->bReadPending;
+                if (!data->WaitRead())
+                    return false;
+                std::swap(data->abyTmp, data->abyTmpRead);
+                std::vector<GUInt64> anPrevStartIdx(
+                    std::move(data->anReadStartIdx));
+                std::vector<size_t> anPrevCount(std::move(data->anReadCount));
+                const GUInt64 iPrevChunk = data->iReadChunk;
+
+                // Start reading this chunk
+                const size_t nDims = l_poSrcArray->GetDimensionCount();
+                data->anReadStartIdx.assign(chunkArrayStartIdx,
+                                            chunkArrayStartIdx + nDims);
+                data->anReadCount.assign(chunkCount, chunkCount + nDims);
+                data->iReadChunk = iCurChunk;
+                data->nReadChunkCount = nChunkCount;
+                data->bReadOK = false;
+                if (!data->poJobQueue->SubmitJob(ReadJob, data))
+                    return false;
+                data->bReadPending = true;
+
+                // And write the previous one meanwhile
+                if (bHasPreviousChunk)
+                {
+                    if (!data->poDstArray->Write(anPrevStartIdx.data(),
+                                                 anPrevCount.data(), nullptr,
+                                                 nullptr,
+                                                 l_poSrcArray->GetDataType(),
+                                                 &data->abyTmp[0]))
+                    {
+                        return false;
+                    }
+                    return data->Progress(iPrevChunk, nChunkCount);
+                }
+                return true;
+            }
+
             static bool f(GDALAbstractMDArray *l_poSrcArray,
                           const GUInt64 *chunkArrayStartIdx,
                           const size_t *chunkCount, GUInt64 iCurChunk,
@@ -3858,17 +3987,7 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
                     return false;
                 }
 
-                double dfCurCost =
-                    double(data->nCurCost) + double(iCurChunk) / nChunkCount *
-                                                 data->nTotalBytesThisArray;
-                if (!data->pfnProgress(dfCurCost / data->nTotalCost, "",
-                                       data->pProgressData))
-                {
-                    data->bStop = true;
-                    return false;
-                }
-
-                return true;
+                return data->Progress(iCurChunk, nChunkCount);
             }
         };
 
@@ -3881,7 +4000,7 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
         copyFunc.pProgressData = pProgressData;
         const char *pszSwathSize =
             CPLGetConfigOption("GDAL_SWATH_SIZE", nullptr);
-        const size_t nMaxChunkSize =
+        size_t nMaxChunkSize =
             pszSwathSize
                 ? static_cast<size_t>(
                       std::min(GIntBig(std::numeric_limits<size_t>::max() / 2),
@@ -3889,6 +4008,34 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
                 : static_cast<size_t>(
                       std::min(GIntBig(std::numeric_limits<size_t>::max() / 2),
                                GDALGetCacheMax64() / 4));
+
+        // Overlap reading from the source and writing to the destination.
+        // Each array is accessed by a single thread at a time, but the source
+        // array is read while the destination one is written. This is unsafe
+        // if both drivers use the same non thread-safe library (e.g. HDF5 to
+        // netCDF-4) under different locks, hence this must be explicitly
+        // requested by the caller, which knows both drivers.
+        const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nThreads =
+            std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                          ? CPLGetNumCPUs()
+                                          : atoi(pszThreads)));
+        if (CPLTestBool(
+                CPLGetConfigOption("GDAL_MDARRAY_COPY_PIPELINED", "NO")) &&
+            !GetDataType().NeedsFreeDynamicMemory() &&
+            copyFunc.nTotalBytesThisArray > nMaxChunkSize / 2)
+        {
+            auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+            if (poThreadPool)
+            {
+                copyFunc.poJobQueue = poThreadPool->CreateJobQueue();
+                copyFunc.osNumThreads = pszThreads;
+                copyFunc.poSrcArray = const_cast<GDALMDArray *>(poSrcArray);
+                // Two buffers must fit in the swath size
+                nMaxChunkSize /= 2;
+            }
+        }
+
         const auto anChunkSizes(GetProcessingChunkSize(nMaxChunkSize));
         size_t nRealChunkSize = nDTSize;
         for (const auto &nChunkSize : anChunkSizes)
@@ -3898,6 +4045,8 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
         try
         {
             copyFunc.abyTmp.resize(nRealChunkSize);
+            if (copyFunc.poJobQueue)
+                copyFunc.abyTmpRead.resize(nRealChunkSize);
         }
         catch (const std::exception &)
         {
@@ -3906,12 +4055,29 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
             nCurCost += copyFunc.nTotalBytesThisArray;
             return false;
         }
-        if (copyFunc.nTotalBytesThisArray != 0 &&
-            !const_cast<GDALMDArray *>(poSrcArray)
-                 ->ProcessPerChunk(arrayStartIdx.data(), count.data(),
-                                   anChunkSizes.data(), CopyFunc::f,
-                                   &copyFunc) &&
-            (bStrict || copyFunc.bStop))
+        bool bRet = copyFunc.nTotalBytesThisArray == 0 ||
+                    const_cast<GDALMDArray *>(poSrcArray)
+                        ->ProcessPerChunk(arrayStartIdx.data(), count.data(),
+                                          anChunkSizes.data(),
+                                          copyFunc.poJobQueue
+                                              ? CopyFunc::fPipelined
+                                              : CopyFunc::f,
+                                          &copyFunc);
+        if (copyFunc.poJobQueue)
+        {
+            // Wait for the read of the last chunk, and write it.
+            const bool bHasLastChunk = copyFunc.bReadPending;
+            if (!copyFunc.WaitRead())
+            {
+                bRet = false;
+            }
+            else if (bRet && bHasLastChunk)
+            {
+                std::swap(copyFunc.abyTmp, copyFunc.abyTmpRead);
+                bRet = copyFunc.WriteReadChunk();
+            }
+        }
+        if (!bRet && (bStrict || copyFunc.bStop))
         {
             nCurCost += copyFunc.nTotalBytesThisArray;
             return false;
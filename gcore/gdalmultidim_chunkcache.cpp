@@ -0,0 +1,301 @@
+/**********************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Process-wide cache of decoded GDALMDArray chunks
+ *
+ **********************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdalmultidim_chunkcache.h"
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "gdal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+/************************************************************************/
+/*                       GetDefaultMaxSize()                            */
+/************************************************************************/
+
+// Parse GDAL_MDARRAY_CHUNK_CACHEMAX with the same syntax as GDAL_CACHEMAX:
+// a percentage of usable physical RAM, a value in MB if lower than 100000,
+// or a value in bytes otherwise. Defaults to a quarter of GDAL_CACHEMAX.
+static size_t GetDefaultMaxSize()
+{
+    const char *pszCacheMax =
+        CPLGetConfigOption("GDAL_MDARRAY_CHUNK_CACHEMAX", nullptr);
+    GIntBig nCacheMax = GDALGetCacheMax64() / 4;
+    if (pszCacheMax)
+    {
+        if (strchr(pszCacheMax, '%') != nullptr)
+        {
+            const GIntBig nUsablePhysicalRAM = CPLGetUsablePhysicalRAM();
+            const double dfCacheMax = static_cast<double>(nUsablePhysicalRAM) *
+                                      CPLAtof(pszCacheMax) / 100.0;
+            if (nUsablePhysicalRAM > 0 && dfCacheMax >= 0 && dfCacheMax < 1e15)
+                nCacheMax = static_cast<GIntBig>(dfCacheMax);
+            else
+                CPLDebug("GDAL", "Cannot determine usable physical RAM.");
+        }
+        else
+        {
+            const GIntBig nVal = CPLAtoGIntBig(pszCacheMax);
+            if (nVal < 0)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Invalid value for GDAL_MDARRAY_CHUNK_CACHEMAX. "
+                         "Using default value.");
+            }
+            else if (nVal < 100000)
+            {
+                nCacheMax = nVal * 1024 * 1024;
+            }
+            else
+            {
+                nCacheMax = nVal;
+            }
+        }
+    }
+    if (static_cast<uint64_t>(nCacheMax) > std::numeric_limits<size_t>::max())
+        return std::numeric_limits<size_t>::max();
+    return static_cast<size_t>(nCacheMax);
+}
+
+/************************************************************************/
+/*                       GDALMDArrayChunkCache()                        */
+/************************************************************************/
+
+GDALMDArrayChunkCache::GDALMDArrayChunkCache() : m_nMaxSize(GetDefaultMaxSize())
+{
+    CPLDebug("GDAL", "GDAL_MDARRAY_CHUNK_CACHEMAX = " CPL_FRMT_GUIB " MB",
+             static_cast<GUIntBig>(m_nMaxSize / (1024 * 1024)));
+}
+
+/************************************************************************/
+/*                            GetSingleton()                            */
+/************************************************************************/
+
+/** Return the process-wide instance. */
+GDALMDArrayChunkCache &GDALMDArrayChunkCache::GetSingleton()
+{
+    static GDALMDArrayChunkCache goCache;
+    return goCache;
+}
+
+/************************************************************************/
+/*                           GetNewOwnerId()                            */
+/************************************************************************/
+
+/** Return a unique identifier that a caller uses to key its chunks. */
+uint64_t GDALMDArrayChunkCache::GetNewOwnerId()
+{
+    static std::atomic<uint64_t> gnLastOwnerId{0};
+    return ++gnLastOwnerId;
+}
+
+/************************************************************************/
+/*                                 Get()                                */
+/************************************************************************/
+
+/** Return a cached chunk, or nullptr if it is not in the cache. */
+GDALMDArrayChunkCache::ChunkPtr
+GDALMDArrayChunkCache::Get(uint64_t nOwnerId,
+                           const std::vector<uint64_t> &anIndices)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    const auto oIter = m_oMap.find(Key(nOwnerId, anIndices));
+    if (oIter == m_oMap.end())
+    {
+        ++m_oStats.nMisses;
+        return nullptr;
+    }
+    ++m_oStats.nHits;
+    // Move to front of the LRU list
+    m_oList.splice(m_oList.begin(), m_oList, oIter->second);
+    return oIter->second->poChunk;
+}
+
+/************************************************************************/
+/*                               Insert()                               */
+/************************************************************************/
+
+/** Insert (or replace) a chunk.
+ *
+ * @return false if the chunk is too large to fit in the cache, or if the
+ * cache is disabled.
+ */
+bool GDALMDArrayChunkCache::Insert(uint64_t nOwnerId,
+                                   const std::vector<uint64_t> &anIndices,
+                                   const ChunkPtr &poChunk)
+{
+    if (!poChunk)
+        return false;
+    // Account for the bookkeeping of the entry, so that a flood of tiny
+    // chunks is also bounded.
+    const size_t nSize = poChunk->size() + sizeof(Entry) +
+                         2 * anIndices.size() * sizeof(uint64_t) + 64;
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    if (nSize > m_nMaxSize)
+        return false;
+
+    Key oKey(nOwnerId, anIndices);
+    const auto oIter = m_oMap.find(oKey);
+    if (oIter != m_oMap.end())
+        EraseLocked(oIter->second);
+
+    Entry oEntry;
+    oEntry.oKey = oKey;
+    oEntry.poChunk = poChunk;
+    oEntry.nSize = nSize;
+    m_oList.emplace_front(std::move(oEntry));
+    m_oMap[std::move(oKey)] = m_oList.begin();
+    m_nCurrentSize += nSize;
+    ++m_oStats.nInsertions;
+    EvictLocked();
+    return true;
+}
+
+/************************************************************************/
+/*                               Remove()                               */
+/************************************************************************/
+
+/** Remove a chunk, typically when it has been modified. */
+void GDALMDArrayChunkCache::Remove(uint64_t nOwnerId,
+                                   const std::vector<uint64_t> &anIndices)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    const auto oIter = m_oMap.find(Key(nOwnerId, anIndices));
+    if (oIter != m_oMap.end())
+        EraseLocked(oIter->second);
+}
+
+/************************************************************************/
+/*                             RemoveOwner()                            */
+/************************************************************************/
+
+/** Remove all chunks of an owner, typically when it is destroyed. */
+void GDALMDArrayChunkCache::RemoveOwner(uint64_t nOwnerId)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    // Keys are sorted by owner first, so entries of an owner are contiguous
+    auto oIter = m_oMap.lower_bound(Key(nOwnerId, std::vector<uint64_t>()));
+    while (oIter != m_oMap.end() && oIter->first.first == nOwnerId)
+    {
+        auto oIterNext = std::next(oIter);
+        EraseLocked(oIter->second);
+        oIter = oIterNext;
+    }
+}
+
+/************************************************************************/
+/*                                Clear()                               */
+/************************************************************************/
+
+/** Remove all chunks. */
+void GDALMDArrayChunkCache::Clear()
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_oMap.clear();
+    m_oList.clear();
+    m_nCurrentSize = 0;
+}
+
+/************************************************************************/
+/*                              GetMaxSize()                            */
+/************************************************************************/
+
+/** Return the maximum size of the cache, in bytes. */
+size_t GDALMDArrayChunkCache::GetMaxSize() const
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    return m_nMaxSize;
+}
+
+/************************************************************************/
+/*                              SetMaxSize()                            */
+/************************************************************************/
+
+/** Set the maximum size of the cache, in bytes. 0 disables the cache.
+ *
+ * Entries are evicted if needed.
+ */
+void GDALMDArrayChunkCache::SetMaxSize(size_t nMaxSize)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_nMaxSize = nMaxSize;
+    EvictLocked();
+}
+
+/************************************************************************/
+/*                            GetStatistics()                           */
+/************************************************************************/
+
+/** Return a snapshot of the cache statistics. */
+GDALMDArrayChunkCache::Statistics GDALMDArrayChunkCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    Statistics oStats(m_oStats);
+    oStats.nEntryCount = m_oMap.size();
+    oStats.nCurrentSize = m_nCurrentSize;
+    oStats.nMaxSize = m_nMaxSize;
+    return oStats;
+}
+
+/************************************************************************/
+/*                           ResetStatistics()                          */
+/************************************************************************/
+
+/** Reset the hit, miss, insertion and eviction counters. */
+void GDALMDArrayChunkCache::ResetStatistics()
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_oStats = Statistics();
+}
+
+/************************************************************************/
+/*                             EraseLocked()                            */
+/************************************************************************/
+
+void GDALMDArrayChunkCache::EraseLocked(std::list<Entry>::iterator oIter)
+{
+    m_nCurrentSize -= oIter->nSize;
+    m_oMap.erase(oIter->oKey);
+    m_oList.erase(oIter);
+}
+
+/************************************************************************/
+/*                             EvictLocked()                            */
+/************************************************************************/
+
+void GDALMDArrayChunkCache::EvictLocked()
+{
+    while (m_nCurrentSize > m_nMaxSize && !m_oList.empty())
+    {
+        EraseLocked(std::prev(m_oList.end()));
+        ++m_oStats.nEvictions;
+    }
+}
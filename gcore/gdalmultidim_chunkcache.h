@@ -0,0 +1,124 @@
+/**********************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Process-wide cache of decoded GDALMDArray chunks
+ *
+ **********************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef GDALMULTIDIM_CHUNKCACHE_H
+#define GDALMULTIDIM_CHUNKCACHE_H
+
+#ifndef DOXYGEN_SKIP
+
+#include "cpl_port.h"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/************************************************************************/
+/*                       GDALMDArrayChunkCache                          */
+/************************************************************************/
+
+/** Process-wide, size-bounded and thread-safe cache of decoded chunks of
+ * multidimensional arrays.
+ *
+ * Drivers opt into it by requesting an owner identifier with GetNewOwnerId(),
+ * and keying their chunks by (owner identifier, chunk indices). Entries are
+ * evicted in least-recently-used order when the cumulated size exceeds the
+ * budget set by the GDAL_MDARRAY_CHUNK_CACHEMAX configuration option.
+ */
+class CPL_DLL GDALMDArrayChunkCache
+{
+  public:
+    /** Immutable decoded chunk content. */
+    typedef std::shared_ptr<const std::vector<GByte>> ChunkPtr;
+
+    /** Cache statistics. */
+    struct Statistics
+    {
+        uint64_t nHits = 0;
+        uint64_t nMisses = 0;
+        uint64_t nInsertions = 0;
+        uint64_t nEvictions = 0;
+        size_t nEntryCount = 0;
+        size_t nCurrentSize = 0;
+        size_t nMaxSize = 0;
+    };
+
+    static GDALMDArrayChunkCache &GetSingleton();
+
+    static uint64_t GetNewOwnerId();
+
+    ChunkPtr Get(uint64_t nOwnerId, const std::vector<uint64_t> &anIndices);
+
+    bool Insert(uint64_t nOwnerId, const std::vector<uint64_t> &anIndices,
+                const ChunkPtr &poChunk);
+
+    void Remove(uint64_t nOwnerId, const std::vector<uint64_t> &anIndices);
+
+    void RemoveOwner(uint64_t nOwnerId);
+
+    void Clear();
+
+    size_t GetMaxSize() const;
+
+    void SetMaxSize(size_t nMaxSize);
+
+    Statistics GetStatistics() const;
+
+    void ResetStatistics();
+
+  private:
+    typedef std::pair<uint64_t, std::vector<uint64_t>> Key;
+
+    struct Entry
+    {
+        Key oKey{};
+        ChunkPtr poChunk{};
+        size_t nSize = 0;
+    };
+
+    mutable std::mutex m_oMutex{};
+    //! Most recently used entries first
+    std::list<Entry> m_oList{};
+    std::map<Key, std::list<Entry>::iterator> m_oMap{};
+    size_t m_nCurrentSize = 0;
+    size_t m_nMaxSize = 0;
+    Statistics m_oStats{};
+
+    GDALMDArrayChunkCache();
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALMDArrayChunkCache)
+
+    void EraseLocked(std::list<Entry>::iterator oIter);
+    void EvictLocked();
+};
+
+#endif  // DOXYGEN_SKIP
+
+#endif  // GDALMULTIDIM_CHUNKCACHE_H
@@ -494,6 +494,11 @@ RB_PROXY_METHOD_WITH_RET(CPLVirtualMem *, nullptr, GetVirtualMemAuto,
                          (GDALRWFlag eRWFlag, int *pnPixelSpace,
                           GIntBig *pnLineSpace, char **papszOptions),
                          (eRWFlag, pnPixelSpace, pnLineSpace, papszOptions))
+RB_PROXY_METHOD_WITH_RET(CPLVirtualMem *, nullptr, GetBlockVirtualMem,
+                         (int nXBlockOff, int nYBlockOff, int *pnPixelSpace,
+                          GIntBig *pnLineSpace, CSLConstList papszOptions),
+                         (nXBlockOff, nYBlockOff, pnPixelSpace, pnLineSpace,
+                          papszOptions))
 
 /************************************************************************/
 /*                 UnrefUnderlyingRasterBand()                        */
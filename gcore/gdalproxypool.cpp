@@ -31,9 +31,15 @@
 #include "gdal_proxy.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -45,10 +51,14 @@
 
 //! @cond Doxygen_Suppress
 
-/* We *must* share the same mutex as the gdaldataset.cpp file, as we are */
-/* doing GDALOpen() calls that can indirectly call GDALOpenShared() on */
-/* an auxiliary dataset ... */
-/* Then we could get dead-locks in multi-threaded use case */
+/* The lifetime of the pool singleton (Ref(), Unref(), PreventDestroy(), */
+/* ForceDestroy()) is protected by the same mutex as the gdaldataset.cpp */
+/* file. */
+/* The pool content itself is protected by a dedicated mutex, that is never */
+/* held while an underlying dataset is opened or closed: those operations */
+/* can indirectly call GDALOpenShared() on an auxiliary dataset, or create */
+/* other GDALProxyPoolDataset, and several threads can thus open or close */
+/* different datasets at the same time without dead-locks. */
 
 /* ******************************************************************** */
 /*                         GDALDatasetPool                              */
@@ -65,6 +75,10 @@ void GDALNullifyProxyPoolSingleton()
     singleton = nullptr;
 }
 
+/* Incremented by a thread while it opens or closes a cached dataset. See */
+/* GDALDatasetPool::refCountOfDisableRefCount */
+static thread_local int nPoolOpenCloseDepthInCurrentThread = 0;
+
 struct _GDALProxyPoolCacheEntry
 {
     GIntBig responsiblePID;
@@ -76,6 +90,10 @@ struct _GDALProxyPoolCacheEntry
     /* Ref count of the cached dataset */
     int refCount;
 
+    /* Set while poDS is being opened (outside of the pool mutex) */
+    bool bOpening;
+    GIntBig nOpeningThreadId;
+
     GDALProxyPoolCacheEntry *prev;
     GDALProxyPoolCacheEntry *next;
 };
@@ -100,12 +118,23 @@ class GDALDatasetPool
     GDALProxyPoolCacheEntry *firstEntry = nullptr;
     GDALProxyPoolCacheEntry *lastEntry = nullptr;
 
+    /* Index of the entries by filename and open options */
+    std::unordered_multimap<std::string, GDALProxyPoolCacheEntry *>
+        oMapEntries{};
+
+    /* Protects the entries, their links and the above index */
+    std::mutex oMutex{};
+    /* Signaled when an entry has finished opening its dataset */
+    std::condition_variable oCondOpened{};
+
     /* This variable prevents a dataset that is going to be opened in
      * GDALDatasetPool::_RefDataset */
     /* from increasing refCount if, during its opening, it creates a
      * GDALProxyPoolDataset */
-    /* We increment it before opening or closing a cached dataset and decrement
-     * it afterwards */
+    /* nPoolOpenCloseDepthInCurrentThread is incremented before opening or
+     * closing a cached dataset and decremented afterwards. Because opening
+     * and closing happen outside of the pool mutex, this is tracked per
+     * thread, whereas this variable is only used by PreventDestroy() */
     /* The typical use case is a VRT made of simple sources that are VRT */
     /* We don't want the "inner" VRT to take a reference on the pool, otherwise
      * there is */
@@ -113,6 +142,13 @@ class GDALDatasetPool
      * ghost */
     int refCountOfDisableRefCount = 0;
 
+    /* Dataset detached from its entry, to be closed outside of the mutex */
+    struct PendingClose
+    {
+        GDALDataset *poDS;
+        GIntBig responsiblePID;
+    };
+
     /* Caution : to be sure that we don't run out of entries, size must be at */
     /* least greater or equal than the maximum number of threads */
     explicit GDALDatasetPool(int maxSize, int64_t nMaxRAMUsage);
@@ -126,6 +162,19 @@ class GDALDatasetPool
                                      CSLConstList papszOpenOptions,
                                      GDALAccess eAccess, const char *pszOwner);
 
+    void MoveToFront(GDALProxyPoolCacheEntry *cur);
+    void DetachEntry(GDALProxyPoolCacheEntry *cur,
+                     std::vector<PendingClose> &aoPendingClose);
+    bool EvictEntryWithZeroRefCount(bool evictEntryWithOpenedDataset,
+                                    std::vector<PendingClose> &aoPendingClose);
+    static void ClosePending(std::vector<PendingClose> &aoPendingClose);
+
+    bool IsDisableRefCount() const
+    {
+        return refCountOfDisableRefCount != 0 ||
+               nPoolOpenCloseDepthInCurrentThread != 0;
+    }
+
 #ifdef DEBUG_PROXY_POOL
     // cppcheck-suppress unusedPrivateFunction
     void ShowContent();
@@ -167,7 +216,10 @@ GDALDatasetPool::GDALDatasetPool(int maxSizeIn, int64_t nMaxRAMUsageIn)
 
 GDALDatasetPool::~GDALDatasetPool()
 {
-    bInDestruction = true;
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        bInDestruction = true;
+    }
     GDALProxyPoolCacheEntry *cur = firstEntry;
     GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
     while (cur)
@@ -248,198 +300,269 @@ static std::string GetFilenameAndOpenOptions(const char *pszFileName,
 }
 
 /************************************************************************/
-/*                            _RefDataset()                             */
+/*                            MoveToFront()                             */
 /************************************************************************/
 
-GDALProxyPoolCacheEntry *
-GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
-                             CSLConstList papszOpenOptions, int bShared,
-                             bool bForceOpen, const char *pszOwner)
+/* Must be called with oMutex held */
+void GDALDatasetPool::MoveToFront(GDALProxyPoolCacheEntry *cur)
 {
-    if (bInDestruction)
-        return nullptr;
+    if (cur == firstEntry)
+        return;
 
-    const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    if (cur->next)
+        cur->next->prev = cur->prev;
+    else
+        lastEntry = cur->prev;
+    cur->prev->next = cur->next;
+    cur->prev = nullptr;
+    firstEntry->prev = cur;
+    cur->next = firstEntry;
+    firstEntry = cur;
+
+#ifdef DEBUG_PROXY_POOL
+    CheckLinks();
+#endif
+}
 
-    const auto EvictEntryWithZeroRefCount =
-        [this, responsiblePID](bool evictEntryWithOpenedDataset)
+/************************************************************************/
+/*                            DetachEntry()                             */
+/************************************************************************/
+
+/* Must be called with oMutex held. Removes the entry from the index and */
+/* moves its dataset (if any) to aoPendingClose, so that it is closed by */
+/* ClosePending() once the mutex has been released */
+void GDALDatasetPool::DetachEntry(GDALProxyPoolCacheEntry *cur,
+                                  std::vector<PendingClose> &aoPendingClose)
+{
+    nRAMUsage -= cur->nRAMUsage;
+    cur->nRAMUsage = 0;
+
+    if (cur->pszFileNameAndOpenOptions)
     {
-        GDALProxyPoolCacheEntry *cur = firstEntry;
-        GDALProxyPoolCacheEntry *candidate = nullptr;
-        while (cur)
+        auto oRange = oMapEntries.equal_range(cur->pszFileNameAndOpenOptions);
+        for (auto oIter = oRange.first; oIter != oRange.second; ++oIter)
         {
-            GDALProxyPoolCacheEntry *next = cur->next;
-
-            if (cur->refCount == 0 &&
-                (!evictEntryWithOpenedDataset || cur->nRAMUsage > 0))
+            if (oIter->second == cur)
             {
-                candidate = cur;
+                oMapEntries.erase(oIter);
+                break;
             }
-
-            cur = next;
         }
-        if (candidate == nullptr)
-            return false;
+        CPLFree(cur->pszFileNameAndOpenOptions);
+        cur->pszFileNameAndOpenOptions = nullptr;
+    }
 
-        nRAMUsage -= candidate->nRAMUsage;
-        candidate->nRAMUsage = 0;
+    if (cur->poDS)
+    {
+        aoPendingClose.push_back({cur->poDS, cur->responsiblePID});
+        cur->poDS = nullptr;
+    }
+    CPLFree(cur->pszOwner);
+    cur->pszOwner = nullptr;
+}
 
-        CPLFree(candidate->pszFileNameAndOpenOptions);
-        candidate->pszFileNameAndOpenOptions = nullptr;
+/************************************************************************/
+/*                    EvictEntryWithZeroRefCount()                      */
+/************************************************************************/
 
-        if (candidate->poDS)
+/* Must be called with oMutex held */
+bool GDALDatasetPool::EvictEntryWithZeroRefCount(
+    bool evictEntryWithOpenedDataset, std::vector<PendingClose> &aoPendingClose)
+{
+    /* Start from the least recently used entry */
+    GDALProxyPoolCacheEntry *candidate = lastEntry;
+    while (candidate)
+    {
+        if (candidate->refCount == 0 &&
+            (!evictEntryWithOpenedDataset || candidate->nRAMUsage > 0))
         {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(candidate->responsiblePID);
+            break;
+        }
+        candidate = candidate->prev;
+    }
+    if (candidate == nullptr)
+        return false;
 
-            refCountOfDisableRefCount++;
-            GDALClose(candidate->poDS);
-            refCountOfDisableRefCount--;
+    DetachEntry(candidate, aoPendingClose);
 
-            candidate->poDS = nullptr;
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-        }
-        CPLFree(candidate->pszOwner);
-        candidate->pszOwner = nullptr;
+    if (!evictEntryWithOpenedDataset)
+    {
+        /* Recycle this entry for the to-be-opened dataset and */
+        /* moves it to the top of the list */
+        MoveToFront(candidate);
+    }
 
-        if (!evictEntryWithOpenedDataset && candidate != firstEntry)
-        {
-            /* Recycle this entry for the to-be-opened dataset and */
-            /* moves it to the top of the list */
-            if (candidate->prev)
-                candidate->prev->next = candidate->next;
-
-            if (candidate->next)
-                candidate->next->prev = candidate->prev;
-            else
-            {
-                CPLAssert(candidate == lastEntry);
-                lastEntry->prev->next = nullptr;
-                lastEntry = lastEntry->prev;
-            }
-            candidate->prev = nullptr;
-            candidate->next = firstEntry;
-            firstEntry->prev = candidate;
-            firstEntry = candidate;
+    return true;
+}
 
-#ifdef DEBUG_PROXY_POOL
-            CheckLinks();
-#endif
-        }
+/************************************************************************/
+/*                           ClosePending()                             */
+/************************************************************************/
 
-        return true;
-    };
+/* Must be called without oMutex held */
+void GDALDatasetPool::ClosePending(std::vector<PendingClose> &aoPendingClose)
+{
+    if (aoPendingClose.empty())
+        return;
 
-    GDALProxyPoolCacheEntry *cur = firstEntry;
+    const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    for (const auto &oPending : aoPendingClose)
+    {
+        /* Close by pretending we are the thread that GDALOpen'ed this */
+        /* dataset */
+        GDALSetResponsiblePIDForCurrentThread(oPending.responsiblePID);
+
+        nPoolOpenCloseDepthInCurrentThread++;
+        GDALClose(oPending.poDS);
+        nPoolOpenCloseDepthInCurrentThread--;
+    }
+    GDALSetResponsiblePIDForCurrentThread(responsiblePID);
+    aoPendingClose.clear();
+}
+
+/************************************************************************/
+/*                            _RefDataset()                             */
+/************************************************************************/
+
+GDALProxyPoolCacheEntry *
+GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
+                             CSLConstList papszOpenOptions, int bShared,
+                             bool bForceOpen, const char *pszOwner)
+{
+    const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    const GIntBig nThreadId = CPLGetPID();
 
     const std::string osFilenameAndOO =
         GetFilenameAndOpenOptions(pszFileName, papszOpenOptions);
 
-    while (cur)
+    std::vector<PendingClose> aoPendingClose;
+    GDALProxyPoolCacheEntry *cur = nullptr;
+
     {
-        GDALProxyPoolCacheEntry *next = cur->next;
+        std::unique_lock<std::mutex> oLock(oMutex);
 
-        if (cur->pszFileNameAndOpenOptions &&
-            osFilenameAndOO == cur->pszFileNameAndOpenOptions &&
-            ((bShared && cur->responsiblePID == responsiblePID &&
-              ((cur->pszOwner == nullptr && pszOwner == nullptr) ||
-               (cur->pszOwner != nullptr && pszOwner != nullptr &&
-                strcmp(cur->pszOwner, pszOwner) == 0))) ||
-             (!bShared && cur->refCount == 0)))
+        if (bInDestruction)
+            return nullptr;
+
+        auto oRange = oMapEntries.equal_range(osFilenameAndOO);
+        for (auto oIter = oRange.first; oIter != oRange.second; ++oIter)
         {
-            if (cur != firstEntry)
+            GDALProxyPoolCacheEntry *candidate = oIter->second;
+            if ((bShared && candidate->responsiblePID == responsiblePID &&
+                 ((candidate->pszOwner == nullptr && pszOwner == nullptr) ||
+                  (candidate->pszOwner != nullptr && pszOwner != nullptr &&
+                   strcmp(candidate->pszOwner, pszOwner) == 0))) ||
+                (!bShared && candidate->refCount == 0))
             {
-                /* Move to begin */
-                if (cur->next)
-                    cur->next->prev = cur->prev;
-                else
-                    lastEntry = cur->prev;
-                cur->prev->next = cur->next;
-                cur->prev = nullptr;
-                firstEntry->prev = cur;
-                cur->next = firstEntry;
-                firstEntry = cur;
-
-#ifdef DEBUG_PROXY_POOL
-                CheckLinks();
-#endif
+                /* Do not wait for ourselves */
+                if (candidate->bOpening &&
+                    candidate->nOpeningThreadId == nThreadId)
+                {
+                    continue;
+                }
+                cur = candidate;
+                break;
             }
+        }
 
+        if (cur)
+        {
+            MoveToFront(cur);
             cur->refCount++;
+            /* Another thread is opening the dataset: wait for it */
+            oCondOpened.wait(oLock, [cur] { return !cur->bOpening; });
             return cur;
         }
 
-        cur = next;
-    }
-
-    if (!bForceOpen)
-        return nullptr;
+        if (!bForceOpen)
+            return nullptr;
 
-    if (currentSize == maxSize)
-    {
-        if (!EvictEntryWithZeroRefCount(false))
+        if (currentSize == maxSize)
         {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "Too many threads are running for the current value of the "
-                "dataset pool size (%d).\n"
-                "or too many proxy datasets are opened in a cascaded way.\n"
-                "Try increasing GDAL_MAX_DATASET_POOL_SIZE.",
-                maxSize);
-            return nullptr;
-        }
+            if (!EvictEntryWithZeroRefCount(false, aoPendingClose))
+            {
+                oLock.unlock();
+                CPLError(
+                    CE_Failure, CPLE_AppDefined,
+                    "Too many threads are running for the current value of "
+                    "the dataset pool size (%d).\n"
+                    "or too many proxy datasets are opened in a cascaded "
+                    "way.\n"
+                    "Try increasing GDAL_MAX_DATASET_POOL_SIZE.",
+                    maxSize);
+                return nullptr;
+            }
 
-        CPLAssert(firstEntry);
-        cur = firstEntry;
-    }
-    else
-    {
-        /* Prepend */
-        cur = static_cast<GDALProxyPoolCacheEntry *>(
-            CPLCalloc(1, sizeof(GDALProxyPoolCacheEntry)));
-        if (lastEntry == nullptr)
-            lastEntry = cur;
-        cur->prev = nullptr;
-        cur->next = firstEntry;
-        if (firstEntry)
-            firstEntry->prev = cur;
-        firstEntry = cur;
-        currentSize++;
+            CPLAssert(firstEntry);
+            cur = firstEntry;
+        }
+        else
+        {
+            /* Prepend */
+            cur = static_cast<GDALProxyPoolCacheEntry *>(
+                CPLCalloc(1, sizeof(GDALProxyPoolCacheEntry)));
+            if (lastEntry == nullptr)
+                lastEntry = cur;
+            cur->prev = nullptr;
+            cur->next = firstEntry;
+            if (firstEntry)
+                firstEntry->prev = cur;
+            firstEntry = cur;
+            currentSize++;
 #ifdef DEBUG_PROXY_POOL
-        CheckLinks();
+            CheckLinks();
 #endif
+        }
+
+        cur->pszFileNameAndOpenOptions = CPLStrdup(osFilenameAndOO.c_str());
+        cur->pszOwner = (pszOwner) ? CPLStrdup(pszOwner) : nullptr;
+        cur->responsiblePID = responsiblePID;
+        cur->refCount = 1;
+        cur->nRAMUsage = 0;
+        cur->bOpening = true;
+        cur->nOpeningThreadId = nThreadId;
+        oMapEntries.emplace(osFilenameAndOO, cur);
     }
 
-    cur->pszFileNameAndOpenOptions = CPLStrdup(osFilenameAndOO.c_str());
-    cur->pszOwner = (pszOwner) ? CPLStrdup(pszOwner) : nullptr;
-    cur->responsiblePID = responsiblePID;
-    cur->refCount = 1;
-    cur->nRAMUsage = 0;
+    /* Close the dataset of the recycled entry, and open the new one, */
+    /* without holding the mutex, so that other threads can use the pool */
+    /* meanwhile */
+    ClosePending(aoPendingClose);
 
-    refCountOfDisableRefCount++;
+    nPoolOpenCloseDepthInCurrentThread++;
     int nFlag = ((eAccess == GA_Update) ? GDAL_OF_UPDATE : GDAL_OF_READONLY) |
                 GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR;
-    CPLConfigOptionSetter oSetter("CPL_ALLOW_VSISTDIN", "NO", true);
-    cur->poDS = GDALDataset::Open(pszFileName, nFlag, nullptr, papszOpenOptions,
-                                  nullptr);
-    refCountOfDisableRefCount--;
-
-    if (cur->poDS)
+    GDALDataset *poDS = nullptr;
     {
-        cur->nRAMUsage =
-            std::max<GIntBig>(0, cur->poDS->GetEstimatedRAMUsage());
-        nRAMUsage += cur->nRAMUsage;
+        CPLConfigOptionSetter oSetter("CPL_ALLOW_VSISTDIN", "NO", true);
+        poDS = GDALDataset::Open(pszFileName, nFlag, nullptr, papszOpenOptions,
+                                 nullptr);
     }
+    nPoolOpenCloseDepthInCurrentThread--;
+
+    const GIntBig nDSRAMUsage =
+        poDS ? std::max<GIntBig>(0, poDS->GetEstimatedRAMUsage()) : 0;
 
-    if (nMaxRAMUsage > 0 && cur->nRAMUsage > 0)
     {
-        while (nRAMUsage > nMaxRAMUsage && nRAMUsage != cur->nRAMUsage &&
-               EvictEntryWithZeroRefCount(true))
+        std::lock_guard<std::mutex> oLock(oMutex);
+
+        cur->poDS = poDS;
+        cur->nRAMUsage = nDSRAMUsage;
+        nRAMUsage += nDSRAMUsage;
+        cur->bOpening = false;
+
+        if (nMaxRAMUsage > 0 && cur->nRAMUsage > 0)
         {
-            // ok
+            while (nRAMUsage > nMaxRAMUsage && nRAMUsage != cur->nRAMUsage &&
+                   EvictEntryWithZeroRefCount(true, aoPendingClose))
+            {
+                // ok
+            }
         }
     }
+    oCondOpened.notify_all();
+
+    ClosePending(aoPendingClose);
 
     return cur;
 }
@@ -453,52 +576,34 @@ void GDALDatasetPool::_CloseDatasetIfZeroRefCount(const char *pszFileName,
                                                   GDALAccess /* eAccess */,
                                                   const char *pszOwner)
 {
-    // May fix https://github.com/OSGeo/gdal/issues/4318
-    if (bInDestruction)
-        return;
-
-    GDALProxyPoolCacheEntry *cur = firstEntry;
-    GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
-
     const std::string osFilenameAndOO =
         GetFilenameAndOpenOptions(pszFileName, papszOpenOptions);
 
-    while (cur)
+    std::vector<PendingClose> aoPendingClose;
     {
-        GDALProxyPoolCacheEntry *next = cur->next;
+        std::lock_guard<std::mutex> oLock(oMutex);
 
-        if (cur->refCount == 0 && cur->pszFileNameAndOpenOptions &&
-            osFilenameAndOO == cur->pszFileNameAndOpenOptions &&
-            ((pszOwner == nullptr && cur->pszOwner == nullptr) ||
-             (pszOwner != nullptr && cur->pszOwner != nullptr &&
-              strcmp(cur->pszOwner, pszOwner) == 0)) &&
-            cur->poDS != nullptr)
-        {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
-
-            GDALDataset *poDS = cur->poDS;
-
-            nRAMUsage -= cur->nRAMUsage;
-            cur->nRAMUsage = 0;
+        // May fix https://github.com/OSGeo/gdal/issues/4318
+        if (bInDestruction)
+            return;
 
-            cur->poDS = nullptr;
-            CPLFree(cur->pszFileNameAndOpenOptions);
-            cur->pszFileNameAndOpenOptions = nullptr;
-            CPLFree(cur->pszOwner);
-            cur->pszOwner = nullptr;
-
-            refCountOfDisableRefCount++;
-            GDALClose(poDS);
-            refCountOfDisableRefCount--;
-
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-            break;
+        auto oRange = oMapEntries.equal_range(osFilenameAndOO);
+        for (auto oIter = oRange.first; oIter != oRange.second; ++oIter)
+        {
+            GDALProxyPoolCacheEntry *cur = oIter->second;
+            if (cur->refCount == 0 &&
+                ((pszOwner == nullptr && cur->pszOwner == nullptr) ||
+                 (pszOwner != nullptr && cur->pszOwner != nullptr &&
+                  strcmp(cur->pszOwner, pszOwner) == 0)) &&
+                cur->poDS != nullptr)
+            {
+                DetachEntry(cur, aoPendingClose);
+                break;
+            }
         }
-
-        cur = next;
     }
+
+    ClosePending(aoPendingClose);
 }
 
 /************************************************************************/
@@ -533,7 +638,7 @@ void GDALDatasetPool::Ref()
 
         singleton = new GDALDatasetPool(l_maxSize, l_nMaxRAMUsage);
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (!singleton->IsDisableRefCount())
         singleton->refCount++;
 }
 
@@ -566,7 +671,7 @@ void GDALDatasetPool::Unref()
         CPLAssert(false);
         return;
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (!singleton->IsDisableRefCount())
     {
         singleton->refCount--;
         if (singleton->refCount == 0)
@@ -607,7 +712,6 @@ GDALDatasetPool::RefDataset(const char *pszFileName, GDALAccess eAccess,
                             char **papszOpenOptions, int bShared,
                             bool bForceOpen, const char *pszOwner)
 {
-    CPLMutexHolderD(GDALGetphDLMutex());
     return singleton->_RefDataset(pszFileName, eAccess, papszOpenOptions,
                                   bShared, bForceOpen, pszOwner);
 }
@@ -618,7 +722,7 @@ GDALDatasetPool::RefDataset(const char *pszFileName, GDALAccess eAccess,
 
 void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry *cacheEntry)
 {
-    CPLMutexHolderD(GDALGetphDLMutex());
+    std::lock_guard<std::mutex> oLock(singleton->oMutex);
     cacheEntry->refCount--;
 }
 
@@ -631,7 +735,6 @@ void GDALDatasetPool::CloseDatasetIfZeroRefCount(const char *pszFileName,
                                                  GDALAccess eAccess,
                                                  const char *pszOwner)
 {
-    CPLMutexHolderD(GDALGetphDLMutex());
     singleton->_CloseDatasetIfZeroRefCount(pszFileName, papszOpenOptions,
                                            eAccess, pszOwner);
 }
@@ -1029,6 +1132,29 @@ CPLErr GDALProxyPoolDataset::GetGeoTransform(double *padfGeoTransform)
     }
 }
 
+/************************************************************************/
+/*                            SetMetadata()                             */
+/************************************************************************/
+
+CPLErr GDALProxyPoolDataset::SetMetadata(char **papszMetadata,
+                                         const char *pszDomain)
+{
+    m_bMetadataModified = true;
+    return GDALProxyDataset::SetMetadata(papszMetadata, pszDomain);
+}
+
+/************************************************************************/
+/*                          SetMetadataItem()                           */
+/************************************************************************/
+
+CPLErr GDALProxyPoolDataset::SetMetadataItem(const char *pszName,
+                                             const char *pszValue,
+                                             const char *pszDomain)
+{
+    m_bMetadataModified = true;
+    return GDALProxyDataset::SetMetadataItem(pszName, pszValue, pszDomain);
+}
+
 /************************************************************************/
 /*                            GetMetadata()                             */
 /************************************************************************/
@@ -1040,9 +1166,25 @@ char **GDALProxyPoolDataset::GetMetadata(const char *pszDomain)
             CPLHashSetNew(hash_func_get_metadata, equal_func_get_metadata,
                           free_func_get_metadata);
 
-    GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
+    GDALDataset *poUnderlyingDataset = RefUnderlyingDataset(false);
     if (poUnderlyingDataset == nullptr)
-        return nullptr;
+    {
+        // Avoid re-opening an evicted dataset for a value we already know
+        if (eAccess == GA_ReadOnly && !m_bMetadataModified)
+        {
+            GetMetadataElt sKey;
+            sKey.pszDomain = const_cast<char *>(pszDomain);
+            sKey.papszMetadata = nullptr;
+            const auto pElt = static_cast<const GetMetadataElt *>(
+                CPLHashSetLookup(metadataSet, &sKey));
+            if (pElt)
+                return pElt->papszMetadata;
+        }
+
+        poUnderlyingDataset = RefUnderlyingDataset();
+        if (poUnderlyingDataset == nullptr)
+            return nullptr;
+    }
 
     char **papszUnderlyingMetadata =
         poUnderlyingDataset->GetMetadata(pszDomain);
@@ -1070,9 +1212,26 @@ const char *GDALProxyPoolDataset::GetMetadataItem(const char *pszName,
                                         equal_func_get_metadata_item,
                                         free_func_get_metadata_item);
 
-    GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
+    GDALDataset *poUnderlyingDataset = RefUnderlyingDataset(false);
     if (poUnderlyingDataset == nullptr)
-        return nullptr;
+    {
+        // Avoid re-opening an evicted dataset for a value we already know
+        if (eAccess == GA_ReadOnly && !m_bMetadataModified)
+        {
+            GetMetadataItemElt sKey;
+            sKey.pszName = const_cast<char *>(pszName);
+            sKey.pszDomain = const_cast<char *>(pszDomain);
+            sKey.pszMetadataItem = nullptr;
+            const auto pElt = static_cast<const GetMetadataItemElt *>(
+                CPLHashSetLookup(metadataItemSet, &sKey));
+            if (pElt)
+                return pElt->pszMetadataItem;
+        }
+
+        poUnderlyingDataset = RefUnderlyingDataset();
+        if (poUnderlyingDataset == nullptr)
+            return nullptr;
+    }
 
     const char *pszUnderlyingMetadataItem =
         poUnderlyingDataset->GetMetadataItem(pszName, pszDomain);
@@ -1342,6 +1501,29 @@ CPLErr GDALProxyPoolRasterBand::FlushCache(bool bAtClosing)
     return CE_None;
 }
 
+/************************************************************************/
+/*                            SetMetadata()                             */
+/************************************************************************/
+
+CPLErr GDALProxyPoolRasterBand::SetMetadata(char **papszMetadata,
+                                            const char *pszDomain)
+{
+    m_bMetadataModified = true;
+    return GDALProxyRasterBand::SetMetadata(papszMetadata, pszDomain);
+}
+
+/************************************************************************/
+/*                          SetMetadataItem()                           */
+/************************************************************************/
+
+CPLErr GDALProxyPoolRasterBand::SetMetadataItem(const char *pszName,
+                                                const char *pszValue,
+                                                const char *pszDomain)
+{
+    m_bMetadataModified = true;
+    return GDALProxyRasterBand::SetMetadataItem(pszName, pszValue, pszDomain);
+}
+
 /************************************************************************/
 /*                            GetMetadata()                             */
 /************************************************************************/
@@ -1353,9 +1535,25 @@ char **GDALProxyPoolRasterBand::GetMetadata(const char *pszDomain)
             CPLHashSetNew(hash_func_get_metadata, equal_func_get_metadata,
                           free_func_get_metadata);
 
-    GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();
+    GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand(false);
     if (poUnderlyingRasterBand == nullptr)
-        return nullptr;
+    {
+        // Avoid re-opening an evicted dataset for a value we already know
+        if (poDS->GetAccess() == GA_ReadOnly && !m_bMetadataModified)
+        {
+            GetMetadataElt sKey;
+            sKey.pszDomain = const_cast<char *>(pszDomain);
+            sKey.papszMetadata = nullptr;
+            const auto pElt = static_cast<const GetMetadataElt *>(
+                CPLHashSetLookup(metadataSet, &sKey));
+            if (pElt)
+                return pElt->papszMetadata;
+        }
+
+        poUnderlyingRasterBand = RefUnderlyingRasterBand();
+        if (poUnderlyingRasterBand == nullptr)
+            return nullptr;
+    }
 
     char **papszUnderlyingMetadata =
         poUnderlyingRasterBand->GetMetadata(pszDomain);
@@ -1383,9 +1581,26 @@ const char *GDALProxyPoolRasterBand::GetMetadataItem(const char *pszName,
                                         equal_func_get_metadata_item,
                                         free_func_get_metadata_item);
 
-    GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();
+    GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand(false);
     if (poUnderlyingRasterBand == nullptr)
-        return nullptr;
+    {
+        // Avoid re-opening an evicted dataset for a value we already know
+        if (poDS->GetAccess() == GA_ReadOnly && !m_bMetadataModified)
+        {
+            GetMetadataItemElt sKey;
+            sKey.pszName = const_cast<char *>(pszName);
+            sKey.pszDomain = const_cast<char *>(pszDomain);
+            sKey.pszMetadataItem = nullptr;
+            const auto pElt = static_cast<const GetMetadataItemElt *>(
+                CPLHashSetLookup(metadataItemSet, &sKey));
+            if (pElt)
+                return pElt->pszMetadataItem;
+        }
+
+        poUnderlyingRasterBand = RefUnderlyingRasterBand();
+        if (poUnderlyingRasterBand == nullptr)
+            return nullptr;
+    }
 
     const char *pszUnderlyingMetadataItem =
         poUnderlyingRasterBand->GetMetadataItem(pszName, pszDomain);
@@ -8025,6 +8025,97 @@ CPLVirtualMem *GDALGetVirtualMemAuto(GDALRasterBandH hBand, GDALRWFlag eRWFlag,
                                      const_cast<char **>(papszOptions));
 }
 
+/************************************************************************/
+/*                         GetBlockVirtualMem()                         */
+/************************************************************************/
+
+/** \brief Return a read-only view on the content of a block, without copy.
+ *
+ * Contrary to ReadBlock() or GetLockedBlockRef(), which decode the block into
+ * a buffer owned by the caller or by the block cache, this method returns,
+ * when the driver supports it, a virtual memory object that directly maps the
+ * part of the file where the block is stored. This avoids any memory copy and
+ * any pressure on the block cache when scanning large uncompressed rasters.
+ *
+ * At the time of writing, the GeoTIFF driver (uncompressed files, tiled or
+ * stripped) and "raw" drivers (EHdr, ENVI, ...) offer an implementation,
+ * provided that the dataset is opened in read-only mode, is backed by a "real"
+ * file in the file system, that the byte ordering of multi-byte data types
+ * matches the native ordering of the CPU, and, for GeoTIFF, that the number of
+ * bits per sample matches the data type and that the block is not sparse.
+ * The default implementation returns NULL, in which case the caller should
+ * fall back to ReadBlock().
+ *
+ * The returned object holds a reference on the underlying file mapping, and
+ * thus remains valid until CPLVirtualMemFree() is called, even if the dataset
+ * is closed in the meantime. The view covers the whole block, except for a
+ * partial last strip of a stripped GeoTIFF file, where it only covers the
+ * valid lines.
+ *
+ * If p is CPLVirtualMemGetAddr() of the returned object and base_type the type
+ * matching GDALGetRasterDataType(), the element of block coordinates (x, y)
+ * can be accessed with
+ * *(base_type*) ((GByte*)p + x * *pnPixelSpace + y * *pnLineSpace)
+ *
+ * This method is the same as the C GDALRasterBandGetBlockVirtualMem()
+ * function.
+ *
+ * @param nXBlockOff the horizontal block offset, with zero indicating
+ * the left most block, 1 the next block and so forth.
+ *
+ * @param nYBlockOff the vertical block offset, with zero indicating
+ * the top most block, 1 the next block and so forth.
+ *
+ * @param pnPixelSpace Output parameter giving the byte offset from the start of
+ * one pixel value in the view to the start of the next pixel value within a
+ * line of the block.
+ *
+ * @param pnLineSpace Output parameter giving the byte offset from the start of
+ * one line of the block in the view to the start of the next.
+ *
+ * @param papszOptions NULL terminated list of options. Unused for now.
+ *
+ * @return a virtual memory object that must be unreferenced by
+ * CPLVirtualMemFree(), or NULL if the block cannot be accessed without copy.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLVirtualMem *GDALRasterBand::GetBlockVirtualMem(
+    CPL_UNUSED int nXBlockOff, CPL_UNUSED int nYBlockOff,
+    CPL_UNUSED int *pnPixelSpace, CPL_UNUSED GIntBig *pnLineSpace,
+    CPL_UNUSED CSLConstList papszOptions)
+{
+    return nullptr;
+}
+
+/************************************************************************/
+/*                  GDALRasterBandGetBlockVirtualMem()                  */
+/************************************************************************/
+
+/**
+ * \brief Return a read-only view on the content of a block, without copy.
+ *
+ * @see GDALRasterBand::GetBlockVirtualMem()
+ * @since GDAL 3.9
+ */
+
+CPLVirtualMem *GDALRasterBandGetBlockVirtualMem(GDALRasterBandH hBand,
+                                                int nXBlockOff, int nYBlockOff,
+                                                int *pnPixelSpace,
+                                                GIntBig *pnLineSpace,
+                                                CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hBand, "GDALRasterBandGetBlockVirtualMem", nullptr);
+    VALIDATE_POINTER1(pnPixelSpace, "GDALRasterBandGetBlockVirtualMem",
+                      nullptr);
+    VALIDATE_POINTER1(pnLineSpace, "GDALRasterBandGetBlockVirtualMem", nullptr);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    return poBand->GetBlockVirtualMem(nXBlockOff, nYBlockOff, pnPixelSpace,
+                                      pnLineSpace, papszOptions);
+}
+
 /************************************************************************/
 /*                        GDALGetDataCoverageStatus()                   */
 /************************************************************************/
@@ -338,6 +338,10 @@ RawRasterBand::~RawRasterBand()
 
     RawRasterBand::FlushCache(true);
 
+    // Views returned by GetBlockVirtualMem() hold their own reference.
+    if (psBlockViewMapping)
+        CPLVirtualMemFree(psBlockViewMapping);
+
     if (bOwnsFP)
     {
         if (VSIFCloseL(fpRawL) != 0)
@@ -1557,6 +1561,57 @@ CPLVirtualMem *RawRasterBand::GetVirtualMemAuto(GDALRWFlag eRWFlag,
     return pVMem;
 }
 
+/************************************************************************/
+/*                         GetBlockVirtualMem()                         */
+/************************************************************************/
+
+CPLVirtualMem *RawRasterBand::GetBlockVirtualMem(int nXBlockOff,
+                                                 int nYBlockOff,
+                                                 int *pnPixelSpace,
+                                                 GIntBig *pnLineSpace,
+                                                 CSLConstList /*papszOptions*/)
+{
+    if (nXBlockOff != 0 || nYBlockOff < 0 || nYBlockOff >= nRasterYSize ||
+        eAccess != GA_ReadOnly || nPixelOffset <= 0 || nLineOffset < 0 ||
+        NeedsByteOrderChange())
+    {
+        return nullptr;
+    }
+
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const vsi_l_offset nLineLength =
+        static_cast<vsi_l_offset>(nRasterXSize - 1) * nPixelOffset + nDTSize;
+
+    // Map the whole band once, and derive the views of each line from it.
+    if (psBlockViewMapping == nullptr && !bBlockViewMappingTried)
+    {
+        bBlockViewMappingTried = true;
+        const vsi_l_offset nSize =
+            static_cast<vsi_l_offset>(nRasterYSize - 1) * nLineOffset +
+            nLineLength;
+        if (VSIFGetNativeFileDescriptorL(fpRawL) == nullptr ||
+            !CPLIsVirtualMemFileMapAvailable() ||
+            static_cast<size_t>(nSize) != nSize)
+        {
+            return nullptr;
+        }
+        psBlockViewMapping = CPLVirtualMemFileMapNew(
+            fpRawL, nImgOffset, nSize, VIRTUALMEM_READONLY, nullptr, nullptr);
+    }
+    if (psBlockViewMapping == nullptr)
+        return nullptr;
+
+    CPLVirtualMem *psView = CPLVirtualMemDerivedNew(
+        psBlockViewMapping, static_cast<vsi_l_offset>(nYBlockOff) * nLineOffset,
+        nLineLength, nullptr, nullptr);
+    if (psView == nullptr)
+        return nullptr;
+
+    *pnPixelSpace = nPixelOffset;
+    *pnLineSpace = nLineOffset;
+    return psView;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*      RawDataset                                                      */
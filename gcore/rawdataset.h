@@ -117,6 +117,8 @@ class CPL_DLL RawRasterBand : public GDALPamRasterBand
     int nLoadedScanline = NO_SCANLINE_LOADED;
     void *pLineBuffer{};
     void *pLineStart{};
+    CPLVirtualMem *psBlockViewMapping = nullptr;
+    bool bBlockViewMappingTried = false;
     bool bNeedFileFlush = false;
     bool bLoadedScanlineDirty = false;  // true when the buffer has
                                         // modified content that needs to
@@ -208,6 +210,10 @@ class CPL_DLL RawRasterBand : public GDALPamRasterBand
                                      GIntBig *pnLineSpace,
                                      char **papszOptions) override;
 
+    CPLVirtualMem *GetBlockVirtualMem(int nXBlockOff, int nYBlockOff,
+                                      int *pnPixelSpace, GIntBig *pnLineSpace,
+                                      CSLConstList papszOptions) override;
+
     CPLErr AccessLine(int iLine);
 
     void SetAccess(GDALAccess eAccess);
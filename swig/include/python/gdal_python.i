@@ -1616,7 +1616,7 @@ def InfoOptions(options=None, format='text', deserialize=True,
          stats=False, approxStats=False, computeChecksum=False,
          showGCPs=True, showMetadata=True, showRAT=True, showColorTable=True,
          listMDD=False, showFileList=True, allMetadata=False,
-         extraMDDomains=None, wktFormat=None):
+         extraMDDomains=None, wktFormat=None, computeHash=False):
     """ Create a InfoOptions() object that can be passed to gdal.Info()
         options can be be an array of strings, a string or let empty and filled from other keywords."""
 
@@ -1647,6 +1647,8 @@ def InfoOptions(options=None, format='text', deserialize=True,
             new_options += ['-approx_stats']
         if computeChecksum:
             new_options += ['-checksum']
+        if computeHash:
+            new_options += ['-hash']
         if not showGCPs:
             new_options += ['-nogcp']
         if not showMetadata: